@@ -0,0 +1,376 @@
+/*
+    OTPView
+    A QT Frontend for E1.59  (Entertainment  Technology  Object  Transform  Protocol  (OTP))
+    Copyright (C) 2026  Marcus Birkin
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+/*
+ * Loopback end to end latency benchmark
+ *
+ * A ProducerThread and a ConsumerThread, as the application runs them, talk over the loopback interface.
+ * For every step of point count and transform rate, each transform interval every point's X position
+ * is set to the next sequence number; the consumer thread reads it back as each point arrives,
+ * giving set to signal latency, and the GUI thread does the same for the first point of every snapshot.
+ * Sequence numbers never seen are counted as dropped, whether lost or superseded before being sent.
+ *
+ * Results are printed, and written as JSON with --output for tracking between releases
+ */
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QNetworkInterface>
+#include <QTimer>
+#include <atomic>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <vector>
+#include "consumerthread.h"
+#include "metrics.h"
+#include "producerthread.h"
+
+using namespace OTP;
+
+namespace
+{
+    constexpr int PointsPerGroup = 100;
+    constexpr std::size_t SequenceHistory = 4096; // Send times kept, in transform intervals
+    constexpr double CeilingDropRate = 0.01;
+
+    const system_t System(1);
+
+    address_t pointAddress(int index)
+    {
+        return address_t(System, group_t(index / PointsPerGroup + 1), point_t(index % PointsPerGroup + 1));
+    }
+
+    int pointIndex(group_t group, point_t point)
+    {
+        return (static_cast<int>(group) - 1) * PointsPerGroup + static_cast<int>(point) - 1;
+    }
+
+    // Runs the event loop until done, or the timeout passes
+    bool waitFor(const std::function<bool()> &done, std::chrono::milliseconds timeout)
+    {
+        QElapsedTimer clock;
+        clock.start();
+        while (!done())
+        {
+            if (clock.hasExpired(timeout.count()))
+                return false;
+            QEventLoop loop;
+            QTimer::singleShot(10, &loop, &QEventLoop::quit);
+            loop.exec();
+        }
+        return true;
+    }
+
+    void wait(std::chrono::milliseconds duration)
+    {
+        waitFor([]() { return false; }, duration);
+    }
+
+    QJsonObject toJson(const Histogram::summary_t &summary)
+    {
+        return QJsonObject{
+            {"count", static_cast<qint64>(summary.count)}, {"min", summary.min}, {"mean", summary.mean},
+            {"p50", summary.p50}, {"p90", summary.p90}, {"p99", summary.p99}, {"p99.9", summary.p999},
+            {"max", summary.max}};
+    }
+
+    typedef struct step_s
+    {
+        int points = 0;
+        std::chrono::milliseconds transformRate{0};
+        bool discovered = false;
+        double durationS = 0;
+        quint64 sent = 0; // Sequence numbers
+        quint64 expected = 0; // Point updates
+        quint64 received = 0;
+        double dropRate = 0;
+        double throughput = 0; // Point updates received per second
+        Histogram::summary_t latency;
+        Histogram::summary_t snapshotLatency;
+    } step_t;
+
+    step_t runStep(const QNetworkInterface &iface, QAbstractSocket::NetworkLayerProtocol transport,
+                   int points, std::chrono::milliseconds transformRate, std::chrono::milliseconds duration)
+    {
+        step_t ret;
+        ret.points = points;
+        ret.transformRate = transformRate;
+
+        // Written by the driver, read by the consumer thread
+        std::vector<std::atomic<qint64>> sentAt(SequenceHistory);
+        std::atomic<quint64> firstMeasured{0};
+
+        // Consumer thread only, until it stops
+        std::vector<quint64> lastSequence(points, 0);
+        int discoveredPoints = 0;
+        quint64 received = 0;
+        auto latency = std::make_unique<Histogram>();
+        auto snapshotLatency = std::make_unique<Histogram>();
+        std::atomic<int> discovered{0};
+
+        auto otpProducer = std::make_shared<ProducerThread>(
+                    iface, transport, cid_t::createUuid(), QStringLiteral("Loopback Bench Producer"), transformRate);
+        otpProducer->call([points](Producer &producer) {
+            producer.addLocalSystem(System);
+            for (int index = 0; index < points; ++index)
+            {
+                const auto address = pointAddress(index);
+                if (!index || address.point == point_t(1))
+                    producer.addLocalGroup(address.system, address.group);
+                producer.addLocalPoint(address.system, address.group, address.point, priority_t());
+            }
+        });
+
+        auto otpConsumer = std::make_shared<ConsumerThread>(
+                    iface, transport, cid_t::createUuid(), QStringLiteral("Loopback Bench Consumer"));
+        auto consumer = otpConsumer->consumer();
+        QObject::connect(consumer.get(), &Consumer::updatedPoint, consumer.get(),
+                         [&, consumer = consumer.get()](cid_t, system_t system, group_t group, point_t point) {
+            const auto now = Metrics::now();
+            const auto index = pointIndex(group, point);
+            if (system != System || index < 0 || index >= points) return;
+
+            const auto sequence = static_cast<quint64>(
+                        consumer->getPosition(address_t(system, group, point), axis_t::X).value);
+            auto &last = lastSequence[index];
+            if (sequence == last) return; // Resent, unchanged
+            if (!last) discovered = ++discoveredPoints;
+            last = sequence;
+
+            const auto first = firstMeasured.load(std::memory_order_relaxed);
+            if (!first || sequence < first) return;
+            ++received;
+            latency->record((now - sentAt[sequence % SequenceHistory].load(std::memory_order_relaxed)) / 1000);
+        }, Qt::DirectConnection);
+        otpConsumer->addLocalSystem(System);
+
+        quint64 lastSnapshotSequence = 0; // GUI thread
+        QObject::connect(otpConsumer.get(), &ConsumerThread::snapshotPublished, otpConsumer.get(), [&]() {
+            const auto values = otpConsumer->snapshot()->point(pointAddress(0));
+            const auto first = firstMeasured.load(std::memory_order_relaxed);
+            if (!values || !first) return;
+            const auto sequence = static_cast<quint64>(values->axes[axis_t::X].position.value);
+            if (sequence < first || sequence == lastSnapshotSequence) return;
+            lastSnapshotSequence = sequence;
+            snapshotLatency->record((Metrics::now() - sentAt[sequence % SequenceHistory].load(std::memory_order_relaxed)) / 1000);
+        });
+
+        quint64 sequence = 0;
+        const auto send = [&]() {
+            ++sequence;
+            sentAt[sequence % SequenceHistory].store(Metrics::now(), std::memory_order_relaxed);
+            const auto timestamp = static_cast<timestamp_t>(QDateTime::currentDateTime().toMSecsSinceEpoch());
+            otpProducer->enqueue([points, sequence, timestamp](Producer &producer) {
+                const QSignalBlocker blocker(&producer);
+                for (int index = 0; index < points; ++index)
+                {
+                    const auto address = pointAddress(index);
+                    auto position = producer.getLocalPosition(address, axis_t::X);
+                    position.value = static_cast<decltype(position.value)>(sequence);
+                    position.timestamp = timestamp;
+                    producer.setLocalPosition(address, axis_t::X, position);
+                }
+            });
+        };
+
+        QTimer driver;
+        driver.setTimerType(Qt::PreciseTimer);
+        driver.setInterval(transformRate);
+        QObject::connect(&driver, &QTimer::timeout, send);
+        driver.start();
+
+        // Everything has to have arrived once, before anything counts
+        ret.discovered = waitFor([&]() { return discovered.load() == points; }, std::chrono::seconds(10));
+        if (ret.discovered)
+        {
+            firstMeasured = sequence + 1;
+            QElapsedTimer clock;
+            clock.start();
+            wait(duration);
+            driver.stop();
+            ret.durationS = clock.nsecsElapsed() / 1e9;
+            ret.sent = sequence + 1 - firstMeasured;
+            wait(std::max(transformRate * 4, std::chrono::milliseconds(250))); // Stragglers
+        }
+        driver.stop();
+
+        // Stopped before anything it wrote is read
+        otpConsumer->stop();
+        otpProducer.reset();
+
+        ret.expected = ret.sent * points;
+        ret.received = received;
+        ret.dropRate = ret.expected ? 1.0 - static_cast<double>(received) / ret.expected : 0;
+        ret.throughput = ret.durationS > 0 ? received / ret.durationS : 0;
+        ret.latency = latency->summary();
+        ret.snapshotLatency = snapshotLatency->summary();
+        return ret;
+    }
+
+    QList<int> toIntList(const QString &value)
+    {
+        QList<int> ret;
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 14, 0))
+        for (const auto &item : value.split(',', Qt::SkipEmptyParts))
+#else
+        for (const auto &item : value.split(',', QString::SkipEmptyParts))
+#endif
+        {
+            bool ok = false;
+            const auto number = item.trimmed().toInt(&ok);
+            if (!ok || number <= 0) return {};
+            ret.append(number);
+        }
+        return ret;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName(QStringLiteral("OTPView Loopback Bench"));
+    QCoreApplication::setApplicationVersion(VER_PRODUCTVERSION_STR);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Producer to consumer latency over the loopback interface");
+    parser.addHelpOption();
+    parser.addVersionOption();
+    const QCommandLineOption pointsOption("points", "Point counts to step through.", "list", "1,10,100,1000");
+    const QCommandLineOption ratesOption("rates", "Transform rates to step through, in milliseconds.", "list", "50,20,10,5,1");
+    const QCommandLineOption durationOption("duration", "Seconds measured per step.", "seconds", "5");
+    const QCommandLineOption interfaceOption("interface", "Network interface, the loopback interface by default.", "name");
+    const QCommandLineOption ipv6Option("ipv6", "Use IPv6, rather than IPv4.");
+    const QCommandLineOption outputOption("output", "Also write the results as JSON.", "file");
+    parser.addOptions({pointsOption, ratesOption, durationOption, interfaceOption, ipv6Option, outputOption});
+    parser.process(app);
+
+    const auto pointCounts = toIntList(parser.value(pointsOption));
+    const auto rates = toIntList(parser.value(ratesOption));
+    const auto duration = std::chrono::milliseconds(qRound(parser.value(durationOption).toDouble() * 1000));
+    const auto transport = parser.isSet(ipv6Option) ? QAbstractSocket::IPv6Protocol : QAbstractSocket::IPv4Protocol;
+    if (pointCounts.isEmpty() || rates.isEmpty() || duration.count() <= 0)
+    {
+        std::fprintf(stderr, "Invalid options\n");
+        return 1;
+    }
+
+    QNetworkInterface iface;
+    for (const auto &candidate : QNetworkInterface::allInterfaces())
+    {
+        const auto flags = candidate.flags();
+        if (parser.isSet(interfaceOption) ? candidate.name() == parser.value(interfaceOption)
+                : (flags.testFlag(QNetworkInterface::IsLoopBack) && flags.testFlag(QNetworkInterface::IsUp)))
+        {
+            iface = candidate;
+            break;
+        }
+    }
+    if (!iface.isValid())
+    {
+        std::fprintf(stderr, "No usable network interface\n");
+        return 1;
+    }
+
+    std::printf("Interface %s, %s\n\n", qPrintable(iface.humanReadableName()),
+                transport == QAbstractSocket::IPv6Protocol ? "IPv6" : "IPv4");
+    std::printf("%8s %8s %10s %12s %8s %10s %10s %10s %10s\n",
+                "Points", "Rate ms", "Sent", "Received", "Drop %", "Updates/s", "P50 ms", "P99 ms", "Max ms");
+
+    QJsonArray stepsJson;
+    const step_t *ceiling = nullptr;
+    std::vector<step_t> steps;
+    steps.reserve(pointCounts.count() * rates.count());
+    bool allDiscovered = true;
+    for (const auto points : pointCounts)
+        for (const auto rate : rates)
+        {
+            steps.push_back(runStep(iface, transport, points, std::chrono::milliseconds(rate), duration));
+            const auto &step = steps.back();
+            allDiscovered &= step.discovered;
+            if (!step.discovered)
+            {
+                std::printf("%8d %8d   nothing received\n", points, rate);
+            } else {
+                std::printf("%8d %8d %10llu %12llu %8.2f %10.0f %10.3f %10.3f %10.3f\n", points, rate,
+                            static_cast<unsigned long long>(step.sent), static_cast<unsigned long long>(step.received),
+                            step.dropRate * 100, step.throughput,
+                            step.latency.p50 / 1000.0, step.latency.p99 / 1000.0, step.latency.max / 1000.0);
+            }
+            std::fflush(stdout);
+
+            if (step.discovered && step.dropRate <= CeilingDropRate
+                    && (!ceiling || step.throughput > ceiling->throughput))
+                ceiling = &step;
+
+            stepsJson.append(QJsonObject{
+                {"points", step.points},
+                {"transformRateMs", static_cast<qint64>(step.transformRate.count())},
+                {"discovered", step.discovered},
+                {"duration", step.durationS},
+                {"sent", static_cast<qint64>(step.sent)},
+                {"expected", static_cast<qint64>(step.expected)},
+                {"received", static_cast<qint64>(step.received)},
+                {"dropRate", step.dropRate},
+                {"throughput", step.throughput},
+                {"latency", toJson(step.latency)},
+                {"snapshotLatency", toJson(step.snapshotLatency)}});
+        }
+
+    if (ceiling)
+        std::printf("\nThroughput ceiling %.0f updates/s, %d points every %lld ms, under %.0f%% dropped\n",
+                    ceiling->throughput, ceiling->points, static_cast<long long>(ceiling->transformRate.count()),
+                    CeilingDropRate * 100);
+
+    if (parser.isSet(outputOption))
+    {
+        QJsonObject root;
+        root.insert("application", QCoreApplication::applicationName());
+        root.insert("version", QCoreApplication::applicationVersion());
+        root.insert("generated", QDateTime::currentDateTimeUtc().toString(Qt::ISODateWithMs));
+        root.insert("interface", iface.name());
+        root.insert("transport", transport == QAbstractSocket::IPv6Protocol ? "IPv6" : "IPv4");
+        root.insert("unit", QStringLiteral("us"));
+        root.insert("steps", stepsJson);
+        if (ceiling)
+            root.insert("ceiling", QJsonObject{
+                {"points", ceiling->points},
+                {"transformRateMs", static_cast<qint64>(ceiling->transformRate.count())},
+                {"throughput", ceiling->throughput},
+                {"maxDropRate", CeilingDropRate}});
+
+        QFile file(parser.value(outputOption));
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)
+                || file.write(QJsonDocument(root).toJson()) < 0)
+        {
+            std::fprintf(stderr, "Unable to write %s: %s\n",
+                         qPrintable(file.fileName()), qPrintable(file.errorString()));
+            return 1;
+        }
+    }
+
+    return allDiscovered ? 0 : 2;
+}
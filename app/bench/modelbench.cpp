@@ -0,0 +1,351 @@
+/*
+    OTPView
+    A QT Frontend for E1.59  (Entertainment  Technology  Object  Transform  Protocol  (OTP))
+    Copyright (C) 2026  Marcus Birkin
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+/*
+ * Consumer side model benchmark
+ *
+ * Drives SystemModel, ComponentsModel and LineChart, and optionally their views,
+ * from a SyntheticConsumer, and reports what each snapshot costs the GUI thread:
+ * wall and CPU time, heap allocations, and latency from publish to every model having caught up.
+ *
+ * Runs headless, the offscreen platform is used unless QT_QPA_PLATFORM says otherwise
+ */
+
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTimer>
+#include <QTreeView>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include "metrics.h"
+#include "profiler.h"
+#include "syntheticconsumer.h"
+#include "models/componentsmodel.h"
+#include "models/systemmodel.h"
+#include "widgets/linechart.h"
+
+#if defined(Q_OS_UNIX)
+#include <time.h>
+#elif defined(Q_OS_WIN)
+#define NOMINMAX
+#include <windows.h>
+#endif
+
+using namespace OTP;
+
+namespace
+{
+    // Heap allocations made by the current thread
+    thread_local quint64 allocations = 0;
+    thread_local quint64 allocatedBytes = 0;
+
+    inline void countAllocation(std::size_t size)
+    {
+        ++allocations;
+        allocatedBytes += size;
+    }
+
+    // CPU time used by the current thread, in nanoseconds, -1 where unsupported
+    qint64 threadCpuTime()
+    {
+#if defined(Q_OS_UNIX)
+        timespec ts;
+        if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0)
+            return qint64(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+#elif defined(Q_OS_WIN)
+        FILETIME creation, exited, kernel, user;
+        if (GetThreadTimes(GetCurrentThread(), &creation, &exited, &kernel, &user))
+        {
+            const auto toNs = [](const FILETIME &time) {
+                return ((qint64(time.dwHighDateTime) << 32) | time.dwLowDateTime) * 100;
+            };
+            return toNs(kernel) + toNs(user);
+        }
+#endif
+        return -1;
+    }
+
+    typedef struct sample_s
+    {
+        qint64 wall = 0;
+        qint64 cpu = 0;
+        quint64 allocations = 0;
+        quint64 allocatedBytes = 0;
+    } sample_t;
+
+    sample_t sample()
+    {
+        return {Metrics::now(), threadCpuTime(), allocations, allocatedBytes};
+    }
+}
+
+#if defined(__GLIBC__)
+// Everything, Qt's containers included, allocates through malloc
+extern "C" {
+    void *__libc_malloc(std::size_t size);
+    void *__libc_calloc(std::size_t count, std::size_t size);
+    void *__libc_realloc(void *ptr, std::size_t size);
+
+    void *malloc(std::size_t size)
+    {
+        countAllocation(size);
+        return __libc_malloc(size);
+    }
+
+    void *calloc(std::size_t count, std::size_t size)
+    {
+        countAllocation(count * size);
+        return __libc_calloc(count, size);
+    }
+
+    void *realloc(void *ptr, std::size_t size)
+    {
+        countAllocation(size);
+        return __libc_realloc(ptr, size);
+    }
+}
+#else
+// Elsewhere only C++ allocations are seen, Qt's container storage is missed
+void *operator new(std::size_t size)
+{
+    countAllocation(size);
+    if (auto ret = std::malloc(size ? size : 1))
+        return ret;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::size_t) noexcept { std::free(ptr); }
+#endif
+
+int main(int argc, char *argv[])
+{
+    if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+
+    QApplication app(argc, argv);
+    QApplication::setApplicationName(QStringLiteral("OTPView Model Bench"));
+    QApplication::setOrganizationName(QStringLiteral("Marcus Birkin"));
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Consumer side model benchmark, under synthetic load");
+    parser.addHelpOption();
+    const QCommandLineOption systemsOption("systems", "Number of systems.", "count", "1");
+    const QCommandLineOption groupsOption("groups", "Groups per system.", "count", "10");
+    const QCommandLineOption pointsOption("points", "Points per group.", "count", "10");
+    const QCommandLineOption sourcesOption("sources", "Number of producers.", "count", "1");
+    const QCommandLineOption rateOption("rate", "Updates of every point per second.", "hz", "50");
+    const QCommandLineOption chartsOption("charts", "Line charts, of the first points.", "count", "4");
+    const QCommandLineOption noViewsOption("no-views", "Models and charts only, without tree views.");
+    const QCommandLineOption warmupOption("warmup", "Seconds before measuring.", "seconds", "2");
+    const QCommandLineOption durationOption("duration", "Seconds measured.", "seconds", "10");
+    const QCommandLineOption outputOption("output", "Also write the results as JSON.", "file");
+    parser.addOptions({systemsOption, groupsOption, pointsOption, sourcesOption, rateOption,
+                       chartsOption, noViewsOption, warmupOption, durationOption, outputOption});
+    parser.process(app);
+
+    SyntheticConsumer::config_t config;
+    config.systems = parser.value(systemsOption).toInt();
+    config.groups = parser.value(groupsOption).toInt();
+    config.points = parser.value(pointsOption).toInt();
+    config.sources = parser.value(sourcesOption).toInt();
+    config.rate = parser.value(rateOption).toDouble();
+    const auto charts = parser.value(chartsOption).toInt();
+    const auto views = !parser.isSet(noViewsOption);
+    const auto warmup = parser.value(warmupOption).toDouble();
+    const auto duration = parser.value(durationOption).toDouble();
+    if (config.systems < 1 || config.systems > 200 || config.groups < 1 || config.points < 1
+            || config.sources < 1 || config.rate <= 0 || charts < 0 || warmup < 0 || duration <= 0)
+    {
+        std::fprintf(stderr, "Invalid options\n");
+        return 1;
+    }
+
+    auto otpConsumer = std::make_shared<SyntheticConsumer>(config);
+
+    // Connected first and last, so every model's handling of a snapshot lies between them
+    sample_t begin;
+    auto &updateWall = Metrics::getInstance().histogram("Bench update GUI thread wall time");
+    auto &updateCpu = Metrics::getInstance().histogram("Bench update GUI thread CPU time");
+    auto &updateLatency = Metrics::getInstance().histogram("Bench publish to models updated latency");
+    quint64 updates = 0;
+    quint64 updateAllocations = 0;
+    quint64 updateAllocatedBytes = 0;
+    quint64 maxUpdateAllocations = 0;
+    QObject::connect(otpConsumer.get(), &ConsumerThread::snapshotPublished, &app, [&begin]() {
+        begin = sample();
+    });
+
+    std::vector<std::unique_ptr<QObject>> models;
+    std::vector<std::unique_ptr<QWidget>> widgets;
+    const auto addModel = [&](QAbstractItemModel *model) {
+        models.emplace_back(model);
+        if (!views) return;
+        auto view = new QTreeView;
+        view->setModel(model);
+        view->resize(800, 600);
+        view->show();
+        widgets.emplace_back(view);
+    };
+    addModel(new ComponentsModel(otpConsumer));
+    for (int system = 1; system <= config.systems; ++system)
+        addModel(new SystemModel(otpConsumer, system_t(system)));
+    for (int chart = 0; chart < charts; ++chart)
+    {
+        const auto group = chart / config.points;
+        if (group >= config.groups) break;
+        auto lineChart = new LineChart(otpConsumer, address_t(system_t(1), group_t(group + 1), point_t(chart % config.points + 1)));
+        lineChart->resize(800, 600);
+        lineChart->show();
+        widgets.emplace_back(lineChart);
+    }
+
+    QObject::connect(otpConsumer.get(), &ConsumerThread::snapshotPublished, &app, [&]() {
+        const auto end = sample();
+        updateWall.record((end.wall - begin.wall) / 1000);
+        if (end.cpu >= 0) updateCpu.record((end.cpu - begin.cpu) / 1000);
+        updateLatency.record(Metrics::microsecondsSince(otpConsumer->snapshot()->publishedAt));
+        const auto updateAllocationCount = end.allocations - begin.allocations;
+        updateAllocations += updateAllocationCount;
+        updateAllocatedBytes += end.allocatedBytes - begin.allocatedBytes;
+        maxUpdateAllocations = std::max(maxUpdateAllocations, updateAllocationCount);
+        ++updates;
+    });
+
+    // Sections and event loop latency, summed over every second measured
+    QMap<QString, Profiler::section_t> sections;
+    int probes = 0;
+    double eventLoopLatencySumMs = 0;
+    double eventLoopLatencyMaxMs = 0;
+    QObject::connect(&Profiler::getInstance(), &Profiler::summarised, &app, [&]() {
+        const auto summary = Profiler::getInstance().getSummaries().last();
+        probes += summary.probes;
+        eventLoopLatencySumMs += summary.eventLoopLatencyMeanMs * summary.probes;
+        eventLoopLatencyMaxMs = std::max(eventLoopLatencyMaxMs, summary.eventLoopLatencyMaxMs);
+        for (auto it = summary.sections.cbegin(); it != summary.sections.cend(); ++it)
+        {
+            auto &section = sections[it.key()];
+            section.count += it->count;
+            section.totalMs += it->totalMs;
+            section.maxMs = std::max(section.maxMs, it->maxMs);
+        }
+    });
+
+    // Warm up, then measure from a clean slate
+    sample_t start;
+    quint64 startTicks = 0;
+    QTimer::singleShot(qRound(warmup * 1000), &app, [&]() {
+        Metrics::getInstance().reset();
+        Profiler::getInstance().setEnabled(true);
+        updates = updateAllocations = updateAllocatedBytes = maxUpdateAllocations = 0;
+        startTicks = otpConsumer->getTicks();
+        start = sample();
+        QTimer::singleShot(qRound(duration * 1000), &app, &QApplication::quit);
+    });
+
+    otpConsumer->start();
+    app.exec();
+    const auto end = sample();
+    Profiler::getInstance().setEnabled(false);
+
+    const auto ticks = otpConsumer->getTicks() - startTicks;
+    const auto elapsedS = (end.wall - start.wall) / 1e9;
+    const auto cpuPercent = (end.cpu >= 0) ? 100.0 * (end.cpu - start.cpu) / (end.wall - start.wall) : -1;
+    const auto totalPoints = config.systems * config.groups * config.points;
+
+    std::printf("%d systems, %d groups, %d points per group (%d points), %d sources, %.1f Hz, %d charts%s\n",
+                config.systems, config.groups, config.points, totalPoints, config.sources, config.rate,
+                charts, views ? "" : ", no views");
+    std::printf("Snapshots published %llu, handled %llu, over %.2f s\n",
+                static_cast<unsigned long long>(ticks), static_cast<unsigned long long>(updates), elapsedS);
+    std::printf("GUI thread CPU %.1f%%, allocations %.1f/s\n", cpuPercent,
+                (end.allocations - start.allocations) / elapsedS);
+    if (updates)
+        std::printf("Per update allocations %.1f avg, %llu max, %.0f bytes avg\n",
+                    double(updateAllocations) / updates,
+                    static_cast<unsigned long long>(maxUpdateAllocations),
+                    double(updateAllocatedBytes) / updates);
+    if (probes)
+        std::printf("Event loop latency %.3f ms avg, %.3f ms max\n",
+                    eventLoopLatencySumMs / probes, eventLoopLatencyMaxMs);
+
+    std::printf("\n%-56s %8s %10s %10s %10s %10s\n", "Metric (ms)", "Count", "Mean", "P50", "P99", "Max");
+    QJsonArray histogramsJson;
+    for (const auto &[name, histogram] : Metrics::getInstance().histograms())
+    {
+        const auto summary = histogram->summary();
+        if (!summary.count) continue;
+        std::printf("%-56s %8llu %10.3f %10.3f %10.3f %10.3f\n", qPrintable(name),
+                    static_cast<unsigned long long>(summary.count),
+                    summary.mean / 1000, summary.p50 / 1000.0, summary.p99 / 1000.0, summary.max / 1000.0);
+        histogramsJson.append(QJsonObject{
+            {"name", name}, {"count", static_cast<qint64>(summary.count)}, {"mean", summary.mean},
+            {"p50", summary.p50}, {"p90", summary.p90}, {"p99", summary.p99}, {"p99.9", summary.p999},
+            {"max", summary.max}});
+    }
+
+    std::printf("\n%-56s %8s %10s %10s\n", "Section (ms)", "Calls", "Total", "Max");
+    QJsonArray sectionsJson;
+    for (auto it = sections.cbegin(); it != sections.cend(); ++it)
+    {
+        std::printf("%-56s %8d %10.3f %10.3f\n", qPrintable(it.key()), it->count, it->totalMs, it->maxMs);
+        sectionsJson.append(QJsonObject{
+            {"name", it.key()}, {"count", it->count}, {"totalMs", it->totalMs}, {"maxMs", it->maxMs}});
+    }
+
+    if (parser.isSet(outputOption))
+    {
+        QJsonObject root;
+        root.insert("config", QJsonObject{
+            {"systems", config.systems}, {"groups", config.groups}, {"points", config.points},
+            {"sources", config.sources}, {"rate", config.rate}, {"charts", charts}, {"views", views},
+            {"duration", elapsedS}});
+        root.insert("published", static_cast<qint64>(ticks));
+        root.insert("handled", static_cast<qint64>(updates));
+        root.insert("guiCpuPercent", cpuPercent);
+        root.insert("allocationsPerSecond", (end.allocations - start.allocations) / elapsedS);
+        root.insert("allocationsPerUpdate", updates ? double(updateAllocations) / updates : 0);
+        root.insert("allocatedBytesPerUpdate", updates ? double(updateAllocatedBytes) / updates : 0);
+        root.insert("eventLoopLatencyMeanMs", probes ? eventLoopLatencySumMs / probes : 0);
+        root.insert("eventLoopLatencyMaxMs", eventLoopLatencyMaxMs);
+        root.insert("unit", QStringLiteral("us"));
+        root.insert("histograms", histogramsJson);
+        root.insert("sections", sectionsJson);
+
+        QFile file(parser.value(outputOption));
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)
+                || file.write(QJsonDocument(root).toJson()) < 0)
+        {
+            std::fprintf(stderr, "Unable to write %s: %s\n",
+                         qPrintable(file.fileName()), qPrintable(file.errorString()));
+            return 1;
+        }
+    }
+
+    // Views first, they hold the models
+    widgets.clear();
+    models.clear();
+    return 0;
+}
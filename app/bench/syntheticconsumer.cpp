@@ -0,0 +1,147 @@
+/*
+    OTPView
+    A QT Frontend for E1.59  (Entertainment  Technology  Object  Transform  Protocol  (OTP))
+    Copyright (C) 2026  Marcus Birkin
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "syntheticconsumer.h"
+#include <QDateTime>
+#include <algorithm>
+#include <cmath>
+
+using namespace OTP;
+using namespace OTP::MODULES::STANDARD;
+
+namespace
+{
+    constexpr double Pi = 3.14159265358979323846;
+}
+
+SyntheticConsumer::SyntheticConsumer(const config_t &config, QObject *parent) : ConsumerThread(parent),
+    config(config),
+    workerContext(new QObject)
+{
+    for (int source = 0; source < config.sources; ++source)
+        sources.append(cid_t::createUuid());
+
+    worker.setObjectName(QStringLiteral("Synthetic Consumer"));
+    workerContext->moveToThread(&worker);
+}
+
+SyntheticConsumer::~SyntheticConsumer()
+{
+    if (worker.isRunning())
+    {
+        QMetaObject::invokeMethod(workerContext, [this]() {
+            delete tickTimer;
+            tickTimer = nullptr;
+        }, Qt::BlockingQueuedConnection);
+        worker.quit();
+        worker.wait();
+    }
+    delete workerContext;
+}
+
+void SyntheticConsumer::start()
+{
+    if (worker.isRunning()) return;
+    worker.start(QThread::HighPriority);
+
+    QMetaObject::invokeMethod(workerContext, [this]() {
+        auto snapshot = std::make_shared<ConsumerSnapshot>();
+        snapshot->localName = QStringLiteral("Synthetic Consumer");
+        snapshot->localCID = cid_t::createUuid();
+        snapshot->unitStrings = {
+            {VALUES::POSITION, QStringLiteral("mm")},
+            {VALUES::POSITION_VELOCITY, QStringLiteral("mm/s")},
+            {VALUES::POSITION_ACCELERATION, QStringLiteral("mm/s²")},
+            {VALUES::ROTATION, QStringLiteral("°")},
+            {VALUES::ROTATION_VELOCITY, QStringLiteral("°/s")},
+            {VALUES::ROTATION_ACCELERATION, QStringLiteral("°/s²")}};
+        for (int system = 1; system <= config.systems; ++system)
+            snapshot->localSystems.append(system_t(system));
+
+        for (int source = 0; source < sources.count(); ++source)
+        {
+            auto details = std::make_shared<ConsumerSnapshot::componentDetails_t>();
+            details->expired = false;
+            details->name = QString("Synthetic Producer %1").arg(source + 1);
+            details->ipAddr = QHostAddress(QHostAddress::LocalHost);
+            details->type = component_t::producer;
+            details->systems = snapshot->localSystems;
+            snapshot->components.insert(sources.at(source), details);
+        }
+
+        // Every group and point exists from the first snapshot on, with its first values
+        for (const auto &system : qAsConst(snapshot->localSystems))
+            for (int group = 1; group <= config.groups; ++group)
+                snapshot->systems[system][group_t(group)];
+        previous = snapshot;
+        tick();
+
+        tickTimer = new QTimer(workerContext);
+        tickTimer->setTimerType(Qt::PreciseTimer);
+        tickTimer->setInterval(std::max(1, qRound(1000 / config.rate)));
+        connect(tickTimer, &QTimer::timeout, workerContext, [this]() { tick(); });
+        tickTimer->start();
+    }, Qt::BlockingQueuedConnection);
+}
+
+void SyntheticConsumer::tick()
+{
+    auto snapshot = std::make_shared<ConsumerSnapshot>(*previous);
+    ++snapshot->frame;
+    phase += 2 * Pi / config.rate / 4; // A four second cycle
+
+    const auto timestamp = QDateTime::currentDateTime().toMSecsSinceEpoch();
+    int index = 0;
+    for (auto &systemValues : snapshot->systems)
+        for (auto &groupValues : systemValues)
+            for (int point = 1; point <= config.points; ++point)
+                groupValues.points.insert(point_t(point), makePoint(index++, timestamp));
+
+    snapshot->publishedAt = Metrics::now();
+    previous = snapshot;
+    deliver(snapshot);
+    ticks.fetch_add(1, std::memory_order_relaxed);
+}
+
+std::shared_ptr<const ConsumerSnapshot::pointValues_t> SyntheticConsumer::makePoint(int index, qint64 timestamp) const
+{
+    auto ret = std::make_shared<ConsumerSnapshot::pointValues_t>();
+    ret->name = QString("Synthetic Point %1").arg(index + 1);
+    ret->lastSeen = QDateTime::fromMSecsSinceEpoch(timestamp);
+
+    const auto &sourceCID = sources.at(index % sources.count());
+    auto angle = phase + index * 0.1;
+    for (auto axis = axis_t::first; axis < axis_t::count; ++axis, angle += 2 * Pi / 3)
+    {
+        auto &values = ret->axes[axis];
+        const auto set = [&](auto &item, double value) {
+            item.value = static_cast<std::decay_t<decltype(item.value)>>(value);
+            item.timestamp = static_cast<timestamp_t>(timestamp);
+            item.sourceCID = sourceCID;
+            item.priority = 100;
+        };
+        set(values.position, 1000000 * std::sin(angle));
+        set(values.positionVelocity, 1000 * std::cos(angle));
+        set(values.positionAcceleration, -1000 * std::sin(angle));
+        set(values.rotation, 180000000 * (1 + std::sin(angle)));
+        set(values.rotationVelocity, 1000 * std::cos(angle));
+        set(values.rotationAcceleration, -1000 * std::sin(angle));
+        set(values.scale, 1000000);
+    }
+    return ret;
+}
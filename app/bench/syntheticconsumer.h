@@ -0,0 +1,76 @@
+/*
+    OTPView
+    A QT Frontend for E1.59  (Entertainment  Technology  Object  Transform  Protocol  (OTP))
+    Copyright (C) 2026  Marcus Birkin
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#ifndef SYNTHETICCONSUMER_H
+#define SYNTHETICCONSUMER_H
+
+#include <QList>
+#include <QThread>
+#include <QTimer>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include "consumerthread.h"
+
+/*
+ * Stand in for ConsumerThread, without a network
+ *
+ * Builds snapshots of a fixed tree of systems, groups and points on its own thread,
+ * every point changing on every tick, and hands them over exactly as ConsumerThread does.
+ * The first snapshot carries the whole tree, the following ones only new values
+ */
+class SyntheticConsumer : public ConsumerThread
+{
+    Q_OBJECT
+public:
+    typedef struct config_s
+    {
+        int systems = 1;
+        int groups = 10;
+        int points = 10; // Per group
+        int sources = 1; // Producers, points are spread evenly over them
+        double rate = 50; // Ticks per second
+    } config_t;
+
+    explicit SyntheticConsumer(const config_t &config, QObject *parent = nullptr);
+    ~SyntheticConsumer();
+
+    void start();
+
+    quint64 getTicks() const { return ticks.load(std::memory_order_relaxed); }
+
+private:
+    // Worker thread
+    void tick();
+    std::shared_ptr<const ConsumerSnapshot::pointValues_t> makePoint(int index, qint64 timestamp) const;
+
+    const config_t config;
+    QList<OTP::cid_t> sources;
+
+    QThread worker;
+    QObject *workerContext;
+
+    // Worker thread only
+    QTimer *tickTimer = nullptr;
+    std::shared_ptr<const ConsumerSnapshot> previous;
+    double phase = 0;
+
+    std::atomic<quint64> ticks{0};
+};
+
+#endif // SYNTHETICCONSUMER_H
@@ -0,0 +1,197 @@
+/*
+    OTPView
+    A QT Frontend for E1.59  (Entertainment  Technology  Object  Transform  Protocol  (OTP))
+    Copyright (C) 2026  Marcus Birkin
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "capturereplay.h"
+#include <algorithm>
+#include <limits>
+
+CaptureReplay::CaptureReplay(QObject *parent) : QObject(parent),
+    context(new QObject)
+{
+    thread.setObjectName(QStringLiteral("Capture Replay"));
+    context->moveToThread(&thread);
+    thread.start();
+
+    QMetaObject::invokeMethod(context, [this]() {
+        batchTimer = new QTimer(context);
+        batchTimer->setSingleShot(true);
+        batchTimer->setTimerType(Qt::PreciseTimer);
+        connect(batchTimer, &QTimer::timeout, context, [this]() { replay(); });
+    }, Qt::BlockingQueuedConnection);
+}
+
+CaptureReplay::~CaptureReplay()
+{
+    QMetaObject::invokeMethod(context, [this]() {
+        reader.close();
+        delete batchTimer;
+        delete socketIPv4;
+        delete socketIPv6;
+    }, Qt::BlockingQueuedConnection);
+
+    thread.quit();
+    thread.wait();
+    delete context;
+}
+
+void CaptureReplay::start(
+        const QString &fileName,
+        pace_t pace,
+        double speed,
+        QNetworkInterface iface,
+        QAbstractSocket::NetworkLayerProtocol transport)
+{
+    QMetaObject::invokeMethod(context, [=]() {
+        batchTimer->stop();
+        this->pace = pace;
+        this->speed = std::max(speed, 0.001);
+        firstTimestamp = -1;
+        hasPending = false;
+        sent = 0;
+        lastProgress = 0;
+
+        delete socketIPv4;
+        delete socketIPv6;
+        socketIPv4 = socketIPv6 = nullptr;
+        localIPv4.clear();
+        localIPv6.clear();
+        for (const auto &entry : iface.addressEntries())
+        {
+            const auto protocol = entry.ip().protocol();
+            if (protocol == QAbstractSocket::IPv4Protocol && localIPv4.isNull()) localIPv4 = entry.ip();
+            if (protocol == QAbstractSocket::IPv6Protocol && localIPv6.isNull()) localIPv6 = entry.ip();
+        }
+        if (transport != QAbstractSocket::IPv6Protocol)
+            socketIPv4 = createSocket(QAbstractSocket::IPv4Protocol);
+        if (transport != QAbstractSocket::IPv4Protocol)
+            socketIPv6 = createSocket(QAbstractSocket::IPv6Protocol);
+        for (auto socket : {socketIPv4, socketIPv6})
+            if (socket) socket->setMulticastInterface(iface);
+
+        if (!reader.open(fileName))
+        {
+            finish(false, reader.errorString());
+            return;
+        }
+        reportProgress(true);
+        batchTimer->start(0);
+    }, Qt::QueuedConnection);
+}
+
+void CaptureReplay::stop()
+{
+    QMetaObject::invokeMethod(context, [this]() {
+        if (!batchTimer->isActive()) return;
+        batchTimer->stop();
+        finish(true, tr("Stopped"));
+    }, Qt::QueuedConnection);
+}
+
+QUdpSocket *CaptureReplay::createSocket(QAbstractSocket::NetworkLayerProtocol protocol)
+{
+    auto socket = new QUdpSocket(context);
+    const auto any = (protocol == QAbstractSocket::IPv4Protocol) ? QHostAddress::AnyIPv4 : QHostAddress::AnyIPv6;
+    if (!socket->bind(QHostAddress(any), 0))
+    {
+        delete socket;
+        return nullptr;
+    }
+
+    // Delivered to this host only
+    socket->setSocketOption(QAbstractSocket::MulticastLoopbackOption, 1);
+    socket->setSocketOption(QAbstractSocket::MulticastTtlOption, 0);
+    return socket;
+}
+
+void CaptureReplay::replay()
+{
+    for (int count = 0; count < BatchSize; ++count)
+    {
+        if (!hasPending)
+        {
+            if (!reader.next(pending))
+            {
+                const auto error = reader.errorString();
+                const auto &statistics = reader.getStatistics();
+                finish(error.isEmpty(), error.isEmpty()
+                       ? tr("Replayed %1 OTP messages of %2 packets").arg(sent).arg(statistics.packets)
+                       : error);
+                return;
+            }
+            hasPending = true;
+            if (firstTimestamp < 0)
+            {
+                firstTimestamp = pending.timestamp;
+                clock.start();
+            }
+        }
+
+        if (pace == PaceRealTime)
+        {
+            const auto due = static_cast<qint64>((pending.timestamp - firstTimestamp) / speed);
+            const auto wait = due - clock.nsecsElapsed() / 1000;
+            if (wait > 0)
+            {
+                reportProgress();
+                batchTimer->start(static_cast<int>(std::min<qint64>(wait / 1000, std::numeric_limits<int>::max())));
+                return;
+            }
+        }
+
+        send(pending);
+        hasPending = false;
+    }
+
+    reportProgress();
+    batchTimer->start(0);
+}
+
+void CaptureReplay::send(const PcapReader::packet_t &packet)
+{
+    const auto protocol = packet.destination.protocol();
+    const auto socket = (protocol == QAbstractSocket::IPv4Protocol) ? socketIPv4 : socketIPv6;
+    if (!socket) return;
+
+    auto destination = packet.destination;
+    if (!destination.isMulticast())
+        destination = (protocol == QAbstractSocket::IPv4Protocol) ? localIPv4 : localIPv6;
+    if (destination.isNull()) return;
+
+    if (socket->writeDatagram(packet.payload, destination, packet.destinationPort) == packet.payload.size())
+        ++sent;
+}
+
+void CaptureReplay::finish(bool ok, const QString &message)
+{
+    reportProgress(true);
+    reader.close();
+    QMetaObject::invokeMethod(this, [this, ok, message]() { emit finished(ok, message); }, Qt::QueuedConnection);
+}
+
+void CaptureReplay::reportProgress(bool force)
+{
+    const auto now = clock.isValid() ? clock.elapsed() : 0;
+    if (!force && now - lastProgress < ProgressInterval.count())
+        return;
+    lastProgress = now;
+
+    const auto position = reader.position();
+    const auto size = reader.size();
+    const auto messages = sent;
+    QMetaObject::invokeMethod(this, [=]() { emit progress(position, size, messages); }, Qt::QueuedConnection);
+}
@@ -0,0 +1,98 @@
+/*
+    OTPView
+    A QT Frontend for E1.59  (Entertainment  Technology  Object  Transform  Protocol  (OTP))
+    Copyright (C) 2026  Marcus Birkin
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#ifndef CAPTUREREPLAY_H
+#define CAPTUREREPLAY_H
+
+#include <QElapsedTimer>
+#include <QNetworkInterface>
+#include <QObject>
+#include <QThread>
+#include <QTimer>
+#include <QUdpSocket>
+#include <chrono>
+#include "pcapreader.h"
+
+/*
+ * Replays the OTP messages of a packet capture to this host's consumers
+ *
+ * Each message is sent again, from its own thread, to the multicast group it was captured going to
+ * (or the interface's own address, if it was unicast), on the given interface with a hop limit of zero.
+ * It therefore never leaves this host, but every consumer listening on that interface
+ * parses and shows it exactly as if it were live, under the captured producers' CIDs.
+ * Replay to the loopback interface keeps it away from the consumers of a live show.
+ *
+ * Replay is either as fast as messages can be sent, or paced by the capture's timestamps
+ */
+class CaptureReplay : public QObject
+{
+    Q_OBJECT
+public:
+    static constexpr int BatchSize = 256; // Messages sent between looking for commands
+    static constexpr std::chrono::milliseconds ProgressInterval{100};
+
+    typedef enum pace_e
+    {
+        PaceMaximum,
+        PaceRealTime
+    } pace_t;
+
+    explicit CaptureReplay(QObject *parent = nullptr);
+    ~CaptureReplay();
+
+    // Stops any replay already running first
+    void start(const QString &fileName,
+               pace_t pace,
+               double speed, // Of real time
+               QNetworkInterface iface,
+               QAbstractSocket::NetworkLayerProtocol transport);
+    void stop();
+
+signals:
+    void progress(qint64 position, qint64 size, quint64 messages);
+    void finished(bool ok, QString message);
+
+private:
+    // Worker thread
+    void replay();
+    void send(const PcapReader::packet_t &packet);
+    void finish(bool ok, const QString &message);
+    void reportProgress(bool force = false);
+    QUdpSocket *createSocket(QAbstractSocket::NetworkLayerProtocol protocol);
+
+    QThread thread;
+    QObject *context; // Lives on the worker thread
+
+    // Worker thread only
+    PcapReader reader;
+    QTimer *batchTimer = nullptr;
+    QUdpSocket *socketIPv4 = nullptr;
+    QUdpSocket *socketIPv6 = nullptr;
+    QHostAddress localIPv4;
+    QHostAddress localIPv6;
+    pace_t pace = PaceMaximum;
+    double speed = 1;
+    QElapsedTimer clock;
+    qint64 firstTimestamp = -1;
+    PcapReader::packet_t pending;
+    bool hasPending = false;
+    quint64 sent = 0;
+    qint64 lastProgress = 0;
+};
+
+#endif // CAPTUREREPLAY_H
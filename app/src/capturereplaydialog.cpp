@@ -0,0 +1,176 @@
+/*
+    OTPView
+    A QT Frontend for E1.59  (Entertainment  Technology  Object  Transform  Protocol  (OTP))
+    Copyright (C) 2026  Marcus Birkin
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "capturereplaydialog.h"
+#include "ui_capturereplaydialog.h"
+#include "systemwindow.h"
+#include <QCoreApplication>
+#include <QFileDialog>
+#include <QListWidgetItem>
+#include <algorithm>
+
+using namespace OTP;
+
+CaptureReplayDialog::CaptureReplayDialog(std::shared_ptr<ConsumerThread> otpConsumer, QWidget *parent) :
+    QDialog(parent),
+    ui(new Ui::CaptureReplayDialog),
+    otpConsumer(otpConsumer)
+{
+    ui->setupUi(this);
+    setWindowFlag(Qt::WindowContextHelpButtonHint, false);
+
+    ui->cbPace->addItem(tr("Maximum speed"), CaptureReplay::PaceMaximum);
+    ui->cbPace->addItem(tr("Real time"), CaptureReplay::PaceRealTime);
+    ui->cbPace->setCurrentIndex(ui->cbPace->findData(CaptureReplay::PaceRealTime));
+    connect<void(QComboBox::*)(int)>(ui->cbPace, &QComboBox::currentIndexChanged, this, [this]() {
+        ui->sbSpeed->setEnabled(ui->cbPace->currentData() == CaptureReplay::PaceRealTime);
+    });
+
+    // Loopback by default, the live interface only when asked for
+    loopback = loopbackInterface();
+    if (loopback.isValid())
+        ui->cbDestination->addItem(tr("Replay consumer on %1 only").arg(loopback.humanReadableName()), DestinationLoopback);
+    ui->cbDestination->addItem(
+                tr("Every consumer on %1").arg(otpConsumer->snapshot()->networkInterface.humanReadableName()),
+                DestinationLive);
+    ui->cbDestination->setCurrentIndex(0);
+    connect<void(QComboBox::*)(int)>(ui->cbDestination, &QComboBox::currentIndexChanged,
+                                     this, &CaptureReplayDialog::updateDestination);
+    updateDestination();
+
+    connect(&replay, &CaptureReplay::progress, this, &CaptureReplayDialog::progress);
+    connect(&replay, &CaptureReplay::finished, this, &CaptureReplayDialog::finished);
+    setRunning(false);
+}
+
+CaptureReplayDialog::~CaptureReplayDialog()
+{
+    delete ui;
+}
+
+void CaptureReplayDialog::on_pbBrowse_clicked()
+{
+    const auto fileName = QFileDialog::getOpenFileName(
+                this, tr("Replay Capture"), ui->leFile->text(),
+                tr("Packet Captures (*.pcap *.pcapng *.cap);;All Files (*)"));
+    if (!fileName.isEmpty())
+        ui->leFile->setText(fileName);
+    setRunning(false);
+}
+
+void CaptureReplayDialog::on_pbStart_clicked()
+{
+    // As this window's consumer is listening
+    const auto snapshot = otpConsumer->snapshot();
+    auto iface = snapshot->networkInterface;
+    if (ui->cbDestination->currentData() == DestinationLoopback)
+    {
+        iface = loopback;
+        if (!replayConsumer)
+        {
+            replayConsumer = std::make_shared<ConsumerThread>(
+                        loopback, snapshot->networkTransport, cid_t::createUuid(),
+                        tr("%1 Replay").arg(QCoreApplication::applicationName()));
+            connect(replayConsumer.get(), &ConsumerThread::snapshotPublished,
+                    this, &CaptureReplayDialog::updateSystems);
+        }
+    }
+
+    replay.start(ui->leFile->text(),
+                 static_cast<CaptureReplay::pace_t>(ui->cbPace->currentData().toInt()),
+                 ui->sbSpeed->value(),
+                 iface,
+                 snapshot->networkTransport);
+    ui->lblStatus->setText(tr("Replaying to %1").arg(iface.humanReadableName()));
+    setRunning(true);
+}
+
+void CaptureReplayDialog::on_lwSystems_itemActivated(QListWidgetItem *item)
+{
+    if (!replayConsumer) return;
+
+    // Their own windows, apart from the live systems
+    auto systemWindow = new SystemWindow(replayConsumer, system_t(item->data(Qt::UserRole).toUInt()), this);
+    systemWindow->setWindowFlag(Qt::Window);
+    systemWindow->setAttribute(Qt::WA_DeleteOnClose);
+    systemWindow->show();
+}
+
+void CaptureReplayDialog::updateDestination()
+{
+    const auto live = ui->cbDestination->currentData() == DestinationLive;
+    ui->lblWarning->setVisible(live);
+    ui->gbSystems->setVisible(!live);
+}
+
+void CaptureReplayDialog::updateSystems()
+{
+    // Every system any replayed producer sends
+    QList<system_t> systems;
+    for (const auto &component : replayConsumer->snapshot()->components)
+        for (const auto &system : component->systems)
+            if (!systems.contains(system))
+                systems << system;
+    std::sort(systems.begin(), systems.end());
+    if (systems == replayedSystems) return;
+    replayedSystems = systems;
+
+    ui->lwSystems->clear();
+    for (const auto &system : qAsConst(replayedSystems))
+    {
+        auto item = new QListWidgetItem(tr("System %1").arg(system), ui->lwSystems);
+        item->setData(Qt::UserRole, static_cast<uint>(system));
+    }
+}
+
+QNetworkInterface CaptureReplayDialog::loopbackInterface()
+{
+    for (const auto &iface : QNetworkInterface::allInterfaces())
+        if (iface.flags().testFlag(QNetworkInterface::IsLoopBack) && iface.flags().testFlag(QNetworkInterface::IsUp))
+            return iface;
+    return QNetworkInterface();
+}
+
+void CaptureReplayDialog::on_pbStop_clicked()
+{
+    replay.stop();
+}
+
+void CaptureReplayDialog::setRunning(bool value)
+{
+    ui->pbStart->setEnabled(!value && !ui->leFile->text().isEmpty());
+    ui->pbStop->setEnabled(value);
+    ui->pbBrowse->setEnabled(!value);
+    ui->cbPace->setEnabled(!value);
+    ui->cbDestination->setEnabled(!value);
+    ui->sbSpeed->setEnabled(!value && ui->cbPace->currentData() == CaptureReplay::PaceRealTime);
+}
+
+void CaptureReplayDialog::progress(qint64 position, qint64 size, quint64 messages)
+{
+    // Per mille, progress bars only take an int
+    ui->progressBar->setRange(0, 1000);
+    ui->progressBar->setValue(size ? static_cast<int>(position * 1000 / size) : 0);
+    ui->lblStatus->setText(tr("%1 OTP messages replayed").arg(messages));
+}
+
+void CaptureReplayDialog::finished(bool ok, QString message)
+{
+    ui->lblStatus->setText(ok ? message : tr("Replay failed: %1").arg(message));
+    setRunning(false);
+}
@@ -0,0 +1,76 @@
+/*
+    OTPView
+    A QT Frontend for E1.59  (Entertainment  Technology  Object  Transform  Protocol  (OTP))
+    Copyright (C) 2026  Marcus Birkin
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#ifndef CAPTUREREPLAYDIALOG_H
+#define CAPTUREREPLAYDIALOG_H
+
+#include <QDialog>
+#include <QList>
+#include <QNetworkInterface>
+#include <memory>
+#include "capturereplay.h"
+#include "consumerthread.h"
+
+namespace Ui {
+class CaptureReplayDialog;
+}
+
+/*
+ * Replays a packet capture, see CaptureReplay
+ *
+ * By default to a consumer of its own on the loopback interface, whose systems open in their own windows,
+ * so no other consumer on the host sees it. Replaying to the live interface instead is warned against,
+ * as every consumer there, media servers included, would take the captured data for the live show
+ */
+class CaptureReplayDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    explicit CaptureReplayDialog(std::shared_ptr<ConsumerThread> otpConsumer, QWidget *parent = nullptr);
+    ~CaptureReplayDialog();
+
+private slots:
+    void on_pbBrowse_clicked();
+    void on_pbStart_clicked();
+    void on_pbStop_clicked();
+    void on_lwSystems_itemActivated(class QListWidgetItem *item);
+
+private:
+    Ui::CaptureReplayDialog *ui;
+    void setRunning(bool value);
+    void progress(qint64 position, qint64 size, quint64 messages);
+    void finished(bool ok, QString message);
+    void updateDestination();
+    void updateSystems();
+
+    typedef enum destination_e
+    {
+        DestinationLoopback,
+        DestinationLive
+    } destination_t;
+    static QNetworkInterface loopbackInterface();
+
+    std::shared_ptr<ConsumerThread> otpConsumer;
+    std::shared_ptr<ConsumerThread> replayConsumer; // On the loopback interface, created on first use
+    QNetworkInterface loopback;
+    QList<OTP::system_t> replayedSystems;
+    CaptureReplay replay;
+};
+
+#endif // CAPTUREREPLAYDIALOG_H
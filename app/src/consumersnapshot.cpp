@@ -0,0 +1,85 @@
+/*
+    OTPView
+    A QT Frontend for E1.59  (Entertainment  Technology  Object  Transform  Protocol  (OTP))
+    Copyright (C) 2026  Marcus Birkin
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "consumersnapshot.h"
+
+using namespace OTP;
+
+std::shared_ptr<ConsumerSnapshot::pointValues_t> ConsumerSnapshot::capturePoint(
+        Consumer &consumer, address_t address)
+{
+    auto ret = std::make_shared<pointValues_t>();
+    ret->name = consumer.getPointName(address);
+    ret->lastSeen = consumer.getPointLastSeen(address);
+    ret->expired = consumer.isPointExpired(address.system, address.group, address.point);
+    ret->referenceFrame = consumer.getReferenceFrame(address).value.toString();
+
+    for (auto axis = axis_t::first; axis < axis_t::count; ++axis)
+    {
+        auto &values = ret->axes[axis];
+        values.position = consumer.getPosition(address, axis);
+        values.positionVelocity = consumer.getPositionVelocity(address, axis);
+        values.positionAcceleration = consumer.getPositionAcceleration(address, axis);
+        values.rotation = consumer.getRotation(address, axis);
+        values.rotationVelocity = consumer.getRotationVelocity(address, axis);
+        values.rotationAcceleration = consumer.getRotationAcceleration(address, axis);
+        values.scale = consumer.getScale(address, axis);
+
+        values.positions = consumer.getPositions(address, axis, true, true);
+        values.positionVelocitys = consumer.getPositionVelocitys(address, axis, true, true);
+        values.positionAccelerations = consumer.getPositionAccelerations(address, axis, true, true);
+        values.rotations = consumer.getRotations(address, axis, true, true);
+        values.rotationVelocitys = consumer.getRotationVelocitys(address, axis, true, true);
+        values.rotationAccelerations = consumer.getRotationAccelerations(address, axis, true, true);
+        values.scales = consumer.getScales(address, axis, true);
+    }
+
+    return ret;
+}
+
+std::shared_ptr<const ConsumerSnapshot::componentDetails_t> ConsumerSnapshot::captureComponent(
+        Consumer &consumer, cid_t cid)
+{
+    auto ret = std::make_shared<componentDetails_t>();
+    ret->expired = consumer.isComponentExpired(cid);
+    const auto component = consumer.getComponent(cid);
+    ret->name = component.getName().toString();
+    ret->ipAddr = component.getIPAddr();
+    ret->type = component.getType();
+    ret->moduleList = component.getModuleList();
+    ret->systems = consumer.getSystems(cid);
+    return ret;
+}
+
+std::shared_ptr<const ConsumerSnapshot::pointValues_t> ConsumerSnapshot::point(address_t address) const
+{
+    const auto system = systems.constFind(address.system);
+    if (system == systems.constEnd()) return nullptr;
+    const auto group = system->constFind(address.group);
+    if (group == system->constEnd()) return nullptr;
+    return group->points.value(address.point);
+}
+
+bool ConsumerSnapshot::isGroupExpired(system_t system, group_t group) const
+{
+    const auto systemValues = systems.constFind(system);
+    if (systemValues == systems.constEnd()) return true;
+    const auto groupValues = systemValues->constFind(group);
+    if (groupValues == systemValues->constEnd()) return true;
+    return groupValues->expired;
+}
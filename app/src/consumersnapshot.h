@@ -0,0 +1,162 @@
+/*
+    OTPView
+    A QT Frontend for E1.59  (Entertainment  Technology  Object  Transform  Protocol  (OTP))
+    Copyright (C) 2026  Marcus Birkin
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#ifndef CONSUMERSNAPSHOT_H
+#define CONSUMERSNAPSHOT_H
+
+#include <QDateTime>
+#include <QHash>
+#include <QHostAddress>
+#include <QMap>
+#include <QNetworkInterface>
+#include <array>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include "OTPLib.hpp"
+#include "deadreckoning.h"
+
+/*
+ * Immutable copy of a consumer's state, as published by ConsumerThread
+ *
+ * Snapshots are copy on write, anything that didn't change is shared with
+ * the previous snapshot. Comparing the pointers of two snapshots' points or components
+ * is therefore enough to tell if they changed
+ */
+struct ConsumerSnapshot
+{
+    // Axis values, typed as the consumer returns them
+    typedef std::decay_t<decltype(std::declval<OTP::Consumer&>().getPosition(
+                std::declval<OTP::address_t>(), std::declval<OTP::axis_t>()))> position_t;
+    typedef std::decay_t<decltype(std::declval<OTP::Consumer&>().getPositionVelocity(
+                std::declval<OTP::address_t>(), std::declval<OTP::axis_t>()))> positionVelocity_t;
+    typedef std::decay_t<decltype(std::declval<OTP::Consumer&>().getPositionAcceleration(
+                std::declval<OTP::address_t>(), std::declval<OTP::axis_t>()))> positionAcceleration_t;
+    typedef std::decay_t<decltype(std::declval<OTP::Consumer&>().getRotation(
+                std::declval<OTP::address_t>(), std::declval<OTP::axis_t>()))> rotation_t;
+    typedef std::decay_t<decltype(std::declval<OTP::Consumer&>().getRotationVelocity(
+                std::declval<OTP::address_t>(), std::declval<OTP::axis_t>()))> rotationVelocity_t;
+    typedef std::decay_t<decltype(std::declval<OTP::Consumer&>().getRotationAcceleration(
+                std::declval<OTP::address_t>(), std::declval<OTP::axis_t>()))> rotationAcceleration_t;
+    typedef std::decay_t<decltype(std::declval<OTP::Consumer&>().getScale(
+                std::declval<OTP::address_t>(), std::declval<OTP::axis_t>()))> scale_t;
+
+    // Values from every other source
+    typedef std::decay_t<decltype(std::declval<OTP::Consumer&>().getPositions(
+                std::declval<OTP::address_t>(), std::declval<OTP::axis_t>(), true, true))> positions_t;
+    typedef std::decay_t<decltype(std::declval<OTP::Consumer&>().getPositionVelocitys(
+                std::declval<OTP::address_t>(), std::declval<OTP::axis_t>(), true, true))> positionVelocitys_t;
+    typedef std::decay_t<decltype(std::declval<OTP::Consumer&>().getPositionAccelerations(
+                std::declval<OTP::address_t>(), std::declval<OTP::axis_t>(), true, true))> positionAccelerations_t;
+    typedef std::decay_t<decltype(std::declval<OTP::Consumer&>().getRotations(
+                std::declval<OTP::address_t>(), std::declval<OTP::axis_t>(), true, true))> rotations_t;
+    typedef std::decay_t<decltype(std::declval<OTP::Consumer&>().getRotationVelocitys(
+                std::declval<OTP::address_t>(), std::declval<OTP::axis_t>(), true, true))> rotationVelocitys_t;
+    typedef std::decay_t<decltype(std::declval<OTP::Consumer&>().getRotationAccelerations(
+                std::declval<OTP::address_t>(), std::declval<OTP::axis_t>(), true, true))> rotationAccelerations_t;
+    typedef std::decay_t<decltype(std::declval<OTP::Consumer&>().getScales(
+                std::declval<OTP::address_t>(), std::declval<OTP::axis_t>(), true))> scales_t;
+
+    typedef struct axisValues_s
+    {
+        // Winning source
+        position_t position;
+        positionVelocity_t positionVelocity;
+        positionAcceleration_t positionAcceleration;
+        rotation_t rotation;
+        rotationVelocity_t rotationVelocity;
+        rotationAcceleration_t rotationAcceleration;
+        scale_t scale;
+
+        // Velocities and accelerations no source sent, derived by ConsumerThread instead
+        bool positionVelocityDerived = false;
+        bool positionAccelerationDerived = false;
+        bool rotationVelocityDerived = false;
+        bool rotationAccelerationDerived = false;
+
+        // Other sources
+        positions_t positions;
+        positionVelocitys_t positionVelocitys;
+        positionAccelerations_t positionAccelerations;
+        rotations_t rotations;
+        rotationVelocitys_t rotationVelocitys;
+        rotationAccelerations_t rotationAccelerations;
+        scales_t scales;
+    } axisValues_t;
+
+    typedef struct pointValues_s
+    {
+        QString name;
+        QDateTime lastSeen;
+        bool expired = false;
+        QString referenceFrame;
+        std::array<axisValues_t, OTP::axis_t::count> axes;
+    } pointValues_t;
+
+    typedef struct groupValues_s
+    {
+        bool expired = false;
+        QMap<OTP::point_t, std::shared_ptr<const pointValues_t>> points;
+    } groupValues_t;
+
+    typedef QMap<OTP::group_t, groupValues_t> systemValues_t;
+
+    typedef struct componentDetails_s
+    {
+        bool expired = true;
+        QString name;
+        QHostAddress ipAddr;
+        OTP::component_t::type_t type = OTP::component_t::consumer;
+        OTP::moduleList_t moduleList;
+        QList<OTP::system_t> systems;
+    } componentDetails_t;
+
+    // Still writable, until published
+    static std::shared_ptr<pointValues_t> capturePoint(OTP::Consumer &consumer, OTP::address_t address);
+    static std::shared_ptr<const componentDetails_t> captureComponent(OTP::Consumer &consumer, OTP::cid_t cid);
+
+    std::shared_ptr<const pointValues_t> point(OTP::address_t address) const;
+    bool isGroupExpired(OTP::system_t system, OTP::group_t group) const;
+    QString getUnitString(OTP::MODULES::STANDARD::VALUES::moduleValue_t moduleValue) const
+        { return unitStrings.value(moduleValue); }
+
+    quint64 frame = 0;
+    qint64 publishedAt = 0; // Metrics::now()
+
+    // Positions moved on from their last sample, and how far off that was from the next
+    bool deadReckoning = false;
+    DeadReckoning::error_t deadReckoningError;
+
+    // Local component
+    QString localName;
+    OTP::cid_t localCID;
+    QNetworkInterface networkInterface;
+    QAbstractSocket::NetworkLayerProtocol networkTransport = QAbstractSocket::UnknownNetworkLayerProtocol;
+    QAbstractSocket::SocketState ipv4State = QAbstractSocket::UnconnectedState;
+    QAbstractSocket::SocketState ipv6State = QAbstractSocket::UnconnectedState;
+    QList<OTP::system_t> localSystems;
+    QHash<int, QString> unitStrings; // Short form, by moduleValue_t
+
+    // Remote components
+    QHash<OTP::cid_t, std::shared_ptr<const componentDetails_t>> components;
+
+    // Local systems only
+    QMap<OTP::system_t, systemValues_t> systems;
+};
+
+#endif // CONSUMERSNAPSHOT_H
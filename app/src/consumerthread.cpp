@@ -0,0 +1,792 @@
+/*
+    OTPView
+    A QT Frontend for E1.59  (Entertainment  Technology  Object  Transform  Protocol  (OTP))
+    Copyright (C) 2026  Marcus Birkin
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "consumerthread.h"
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+
+using namespace OTP;
+using namespace OTP::MODULES::STANDARD;
+
+ConsumerThread::ConsumerThread(
+        QNetworkInterface iface,
+        QAbstractSocket::NetworkLayerProtocol transport,
+        cid_t CID,
+        QString name,
+        QObject *parent) : QObject(parent),
+    context(new QObject),
+    published(std::make_shared<ConsumerSnapshot>()),
+    sourceLatency(Metrics::getInstance().histogram(QStringLiteral("Consumer source timestamp to receive latency"))),
+    filterDuration(Metrics::getInstance().histogram(QStringLiteral("Consumer motion filter per snapshot")))
+{
+    thread.setObjectName(QStringLiteral("OTP Consumer"));
+    context->moveToThread(&thread);
+    thread.start(QThread::HighPriority);
+
+    // Created on the worker thread, so its sockets are serviced there
+    QMetaObject::invokeMethod(context, [=]() {
+        otpConsumer.reset(new class Consumer(iface, transport, QList<system_t>(), CID, name));
+        connectConsumer();
+
+        publishTimer = new QTimer(context);
+        publishTimer->setSingleShot(true);
+        publishTimer->setTimerType(Qt::PreciseTimer);
+        publishTimer->setInterval(PublishInterval);
+        connect(publishTimer, &QTimer::timeout, context, [this]() { publish(); });
+
+        markGeneral();
+        markStructure();
+        publish();
+    }, Qt::BlockingQueuedConnection);
+
+    current = buffer.read();
+}
+
+ConsumerThread::ConsumerThread(QObject *parent) : QObject(parent),
+    context(new QObject),
+    published(std::make_shared<ConsumerSnapshot>()),
+    sourceLatency(Metrics::getInstance().histogram(QStringLiteral("Consumer source timestamp to receive latency"))),
+    filterDuration(Metrics::getInstance().histogram(QStringLiteral("Consumer motion filter per snapshot")))
+{
+    buffer.write(published);
+    current = buffer.read();
+}
+
+ConsumerThread::~ConsumerThread()
+{
+    stop();
+    delete context;
+}
+
+void ConsumerThread::stop()
+{
+    if (!thread.isRunning()) return;
+
+    QMetaObject::invokeMethod(context, [this]() {
+        delete publishTimer;
+        publishTimer = nullptr;
+        sharedPoints.reset();
+        otpConsumer->disconnect();
+        otpConsumer.reset();
+    }, Qt::BlockingQueuedConnection);
+
+    thread.quit();
+    thread.wait();
+}
+
+void ConsumerThread::setNetworkInterface(QNetworkInterface value)
+{
+    post([this, value]() {
+        otpConsumer->setNetworkInterface(value);
+        markGeneral();
+    });
+}
+
+void ConsumerThread::setNetworkTransport(QAbstractSocket::NetworkLayerProtocol value)
+{
+    post([this, value]() {
+        otpConsumer->setNetworkTransport(value);
+        markGeneral();
+    });
+}
+
+void ConsumerThread::setLocalName(QString value)
+{
+    post([this, value]() {
+        otpConsumer->setLocalName(value);
+        markGeneral();
+    });
+}
+
+void ConsumerThread::setLocalCID(cid_t value)
+{
+    post([this, value]() {
+        otpConsumer->setLocalCID(value);
+        markGeneral();
+    });
+}
+
+void ConsumerThread::addLocalSystem(system_t system)
+{
+    post([this, system]() {
+        otpConsumer->addLocalSystem(system);
+        markGeneral();
+        markStructure();
+    });
+}
+
+void ConsumerThread::removeLocalSystem(system_t system)
+{
+    post([this, system]() {
+        otpConsumer->removeLocalSystem(system);
+        markGeneral();
+        markStructure();
+    });
+}
+
+void ConsumerThread::updateOTPMap()
+{
+    post([this]() { otpConsumer->UpdateOTPMap(); });
+}
+
+void ConsumerThread::setSharedMemory(QString name)
+{
+    post([this, name]() {
+        sharedPoints.reset();
+        if (name.isEmpty()) return;
+
+        sharedPoints = std::make_unique<SharedPointTable>(name);
+        if (!sharedPoints->isOpen())
+        {
+            const auto message = sharedPoints->errorString();
+            sharedPoints.reset();
+            QMetaObject::invokeMethod(this, [this, message]() {
+                emit sharedMemoryFailed(message);
+            }, Qt::QueuedConnection);
+            return;
+        }
+        shareAllPoints();
+    });
+}
+
+void ConsumerThread::setGroupFilter(system_t system, group_t group,
+                                    MotionFilter::mode_t mode, MotionFilter::parameters_t parameters)
+{
+    post([this, system, group, mode, parameters]() {
+        groupFilters[{static_cast<quint32>(system), static_cast<quint32>(group)}] = {mode, parameters};
+        markGroup(system, group);
+    });
+}
+
+bool ConsumerThread::getGroupFilter(system_t system, group_t group,
+                                    MotionFilter::mode_t &mode, MotionFilter::parameters_t &parameters) const
+{
+    const auto groupFilter = groupFilters.find({static_cast<quint32>(system), static_cast<quint32>(group)});
+    if (groupFilter == groupFilters.end()) return false;
+    mode = groupFilter->second.mode;
+    parameters = groupFilter->second.parameters;
+    return true;
+}
+
+std::unique_ptr<MotionFilter> ConsumerThread::createMotionFilter(MotionFilter::mode_t mode)
+{
+    const auto rotationRange = VALUES::RANGES::getRange(VALUES::ROTATION);
+    const auto minimum = static_cast<double>(rotationRange.getMin());
+    const auto span = static_cast<double>(rotationRange.getMax()) - minimum + 1;
+    std::vector<MotionFilter::channel_t> channels;
+    channels.insert(channels.end(), axis_t::count, {1000.0, 0.0, 0.0});
+    channels.insert(channels.end(), axis_t::count, {1000000.0, span, minimum});
+    return std::make_unique<MotionFilter>(mode, channels);
+}
+
+void ConsumerThread::clearGroupFilter(system_t system, group_t group)
+{
+    post([this, system, group]() {
+        groupFilters.erase({static_cast<quint32>(system), static_cast<quint32>(group)});
+        removeFilterSlots([system, group](const address_t &address) {
+            return address.system == system && address.group == group;
+        });
+        markGroup(system, group);
+    });
+}
+
+void ConsumerThread::setDeadReckoning(bool enabled)
+{
+    post([this, enabled]() {
+        if (enabled == static_cast<bool>(deadReckoning)) return;
+        if (enabled)
+        {
+            deadReckoning = std::make_unique<DeadReckoning>(std::chrono::nanoseconds(DeadReckoningLimit).count());
+        } else {
+            deadReckoning.reset();
+            reckoningSlots.clear();
+        }
+
+        // Back to their received values
+        markAllPoints();
+        markGeneral();
+    });
+}
+
+void ConsumerThread::resetDeadReckoningError()
+{
+    post([this]() {
+        if (!deadReckoning) return;
+        deadReckoning->resetError();
+        markGeneral();
+    });
+}
+
+void ConsumerThread::setDeriveMotion(bool enabled)
+{
+    post([this, enabled]() {
+        if (enabled == static_cast<bool>(derivedMotion)) return;
+        if (enabled)
+        {
+            // Position, then rotation, which wraps
+            const auto rotationRange = VALUES::RANGES::getRange(VALUES::ROTATION);
+            const auto span = static_cast<double>(rotationRange.getMax()) - static_cast<double>(rotationRange.getMin()) + 1;
+            std::vector<double> wrapSpans(axis_t::count, 0.0);
+            wrapSpans.insert(wrapSpans.end(), axis_t::count, span);
+            derivedMotion = std::make_unique<DerivedMotion>(
+                        wrapSpans, std::chrono::nanoseconds(DerivedMotionSmoothing).count());
+        } else {
+            derivedMotion.reset();
+            derivedSlots.clear();
+        }
+        markAllPoints();
+    });
+}
+
+void ConsumerThread::post(std::function<void()> command)
+{
+    QMetaObject::invokeMethod(context, command, Qt::QueuedConnection);
+}
+
+void ConsumerThread::connectConsumer()
+{
+    auto consumer = otpConsumer.get();
+
+    // Only marks what needs capturing, snapshots are built by publish()
+    const auto structure = [this]() { markStructure(); };
+    connect(consumer, &Consumer::newGroup, context, structure, Qt::DirectConnection);
+    connect(consumer, &Consumer::removedGroup, context, structure, Qt::DirectConnection);
+    connect(consumer, &Consumer::newPoint, context, structure, Qt::DirectConnection);
+    connect(consumer, &Consumer::removedPoint, context, structure, Qt::DirectConnection);
+
+    const auto point = [this](cid_t, system_t system, group_t group, point_t point) {
+        markPoint(system, group, point);
+    };
+    connect(consumer, &Consumer::updatedPoint, context, point, Qt::DirectConnection);
+    connect(consumer, &Consumer::expiredPoint, context, point, Qt::DirectConnection);
+    connect(consumer, &Consumer::updatedPoint, context,
+            [this](cid_t cid, system_t system, group_t group, point_t point) {
+                measureArrival(cid, address_t(system, group, point));
+                if (derivedMotion) derivePoint(address_t(system, group, point));
+                if (deadReckoning) reckonPoint(address_t(system, group, point));
+            }, Qt::DirectConnection);
+    connect(consumer, &Consumer::removedComponent, context,
+            [this](const cid_t &cid) { arrivals.remove(cid); }, Qt::DirectConnection);
+
+    // Shared memory is written as each update arrives, not at the snapshot rate
+    const auto sharePoint = [this](cid_t, system_t system, group_t group, point_t point) {
+        if (sharedPoints) sharedPoints->update(*otpConsumer, address_t(system, group, point));
+    };
+    connect(consumer, &Consumer::newPoint, context, sharePoint, Qt::DirectConnection);
+    connect(consumer, &Consumer::updatedPoint, context, sharePoint, Qt::DirectConnection);
+    connect(consumer, &Consumer::expiredPoint, context, sharePoint, Qt::DirectConnection);
+    connect(consumer, &Consumer::removedPoint, context,
+            [this](cid_t, system_t system, group_t group, point_t point) {
+                if (!sharedPoints) return;
+                // Removed from one source, others may still have it
+                const address_t address(system, group, point);
+                if (otpConsumer->getPoints(system, group).contains(point))
+                    sharedPoints->update(*otpConsumer, address);
+                else
+                    sharedPoints->remove(address);
+            }, Qt::DirectConnection);
+
+    const auto component = [this](const cid_t &cid) { markComponent(cid); };
+    connect(consumer, &Consumer::newComponent, context, component, Qt::DirectConnection);
+    connect(consumer, &Consumer::removedComponent, context, component, Qt::DirectConnection);
+    connect(consumer, qOverload<const cid_t&, const name_t&>(&Consumer::updatedComponent),
+            context, component, Qt::DirectConnection);
+    connect(consumer, qOverload<const cid_t&, component_t::type_t>(&Consumer::updatedComponent),
+            context, component, Qt::DirectConnection);
+    connect(consumer, qOverload<const cid_t&, const QHostAddress&>(&Consumer::updatedComponent),
+            context, component, Qt::DirectConnection);
+    connect(consumer, qOverload<const cid_t&, const OTP::moduleList_t&>(&Consumer::updatedComponent),
+            context, component, Qt::DirectConnection);
+    connect(consumer, &Consumer::newSystem, context, component, Qt::DirectConnection);
+    connect(consumer, &Consumer::removedSystem, context, component, Qt::DirectConnection);
+
+    const auto general = [this]() { markGeneral(); };
+    connect(consumer, &Consumer::stateChangedNetworkInterface, context, general, Qt::DirectConnection);
+    connect(consumer, &Consumer::newLocalCID, context, general, Qt::DirectConnection);
+}
+
+void ConsumerThread::markPoint(system_t system, group_t group, point_t point)
+{
+    dirtyPoints.insert({static_cast<quint32>(system), static_cast<quint32>(group), static_cast<quint32>(point)});
+    if (publishTimer && !publishTimer->isActive()) publishTimer->start();
+}
+
+void ConsumerThread::markComponent(cid_t cid)
+{
+    dirtyComponents.insert(cid);
+    if (publishTimer && !publishTimer->isActive()) publishTimer->start();
+}
+
+void ConsumerThread::markStructure()
+{
+    structureDirty = true;
+    if (publishTimer && !publishTimer->isActive()) publishTimer->start();
+}
+
+void ConsumerThread::markGeneral()
+{
+    generalDirty = true;
+    if (publishTimer && !publishTimer->isActive()) publishTimer->start();
+}
+
+void ConsumerThread::markGroup(system_t system, group_t group)
+{
+    // Recaptured, filtered or not, with the next snapshot
+    for (const auto &point : otpConsumer->getPoints(system, group))
+        markPoint(system, group, point);
+}
+
+void ConsumerThread::markAllPoints()
+{
+    for (const auto &system : otpConsumer->getLocalSystems())
+        for (const auto &group : otpConsumer->getGroups(system))
+            markGroup(system, group);
+}
+
+void ConsumerThread::publish()
+{
+    const auto reckoning = deadReckoning && !reckoningSlots.empty();
+    if (!structureDirty && !generalDirty && dirtyPoints.empty() && dirtyComponents.isEmpty() && !reckoning)
+        return;
+
+    auto &consumer = *otpConsumer;
+    auto snapshot = std::make_shared<ConsumerSnapshot>(*published);
+    ++snapshot->frame;
+
+    if (generalDirty)
+    {
+        snapshot->localName = consumer.getLocalName();
+        snapshot->localCID = consumer.getLocalCID();
+        snapshot->networkInterface = consumer.getNetworkInterface();
+        snapshot->networkTransport = consumer.getNetworkTransport();
+        snapshot->ipv4State = consumer.getNetworkinterfaceState(QAbstractSocket::IPv4Protocol);
+        snapshot->ipv6State = consumer.getNetworkinterfaceState(QAbstractSocket::IPv6Protocol);
+        snapshot->localSystems = consumer.getLocalSystems();
+        for (const auto moduleValue : {
+                VALUES::POSITION, VALUES::POSITION_VELOCITY, VALUES::POSITION_ACCELERATION,
+                VALUES::ROTATION, VALUES::ROTATION_VELOCITY, VALUES::ROTATION_ACCELERATION})
+            snapshot->unitStrings.insert(moduleValue, consumer.getUnitString(moduleValue, true));
+    }
+
+    for (const auto &cid : qAsConst(dirtyComponents))
+        snapshot->components.insert(cid, ConsumerSnapshot::captureComponent(consumer, cid));
+
+    // Filtered once every point is captured, as one batch
+    const auto capture = [this, &consumer](const address_t &address) {
+        auto values = ConsumerSnapshot::capturePoint(consumer, address);
+        if (derivedMotion) applyDerived(address, *values);
+        if (!groupFilters.empty()) queueFilter(address, values);
+        return values;
+    };
+
+    const auto isDirty = [this](const address_t &address) {
+        return dirtyPoints.count({static_cast<quint32>(address.system),
+                                  static_cast<quint32>(address.group),
+                                  static_cast<quint32>(address.point)});
+    };
+    if (structureDirty)
+    {
+        // Walk the whole tree, keeping every clean point from the previous snapshot
+        QMap<system_t, ConsumerSnapshot::systemValues_t> systems;
+        for (const auto &system : consumer.getLocalSystems())
+        {
+            const auto previous = published->systems.value(system);
+            auto &systemValues = systems[system];
+            for (const auto &group : consumer.getGroups(system))
+            {
+                auto &groupValues = systemValues[group];
+                groupValues.expired = consumer.isGroupExpired(system, group);
+                const auto previousPoints = previous.value(group).points;
+                for (const auto &point : consumer.getPoints(system, group))
+                {
+                    const address_t address(system, group, point);
+                    auto values = previousPoints.value(point);
+                    if (!values || isDirty(address))
+                        values = capture(address);
+                    groupValues.points.insert(point, values);
+                }
+            }
+        }
+        snapshot->systems = systems;
+
+        // Points that have gone
+        if (!filterSlots.empty())
+            removeFilterSlots([&snapshot](const address_t &address) { return !snapshot->point(address); });
+        const auto gone = [&snapshot](const addressKey_t &key) {
+            const auto &[system, group, point] = key;
+            return !snapshot->point(address_t(system_t(system), group_t(group), point_t(point)));
+        };
+        for (auto it = reckoningSlots.begin(); it != reckoningSlots.end();)
+        {
+            if (!gone(it->first))
+            {
+                ++it;
+                continue;
+            }
+            deadReckoning->removePoint(it->second.slot);
+            it = reckoningSlots.erase(it);
+        }
+        for (auto it = derivedSlots.begin(); it != derivedSlots.end();)
+        {
+            if (!gone(it->first))
+            {
+                ++it;
+                continue;
+            }
+            derivedMotion->removePoint(it->second.slot);
+            it = derivedSlots.erase(it);
+        }
+    } else {
+        for (const auto &[system, group, point] : dirtyPoints)
+        {
+            const address_t address(system_t(system), group_t(group), point_t(point));
+            auto systemValues = snapshot->systems.find(address.system);
+            if (systemValues == snapshot->systems.end()) continue;
+            auto groupValues = systemValues->find(address.group);
+            if (groupValues == systemValues->end()) continue;
+            if (!groupValues->points.contains(address.point)) continue;
+            groupValues->points.insert(address.point, capture(address));
+            groupValues->expired = consumer.isGroupExpired(address.system, address.group);
+        }
+    }
+
+    filterPoints();
+    if (reckoning) reckonPoints(*snapshot);
+    snapshot->deadReckoning = static_cast<bool>(deadReckoning);
+    snapshot->deadReckoningError = deadReckoning ? deadReckoning->getError() : DeadReckoning::error_t();
+
+    structureDirty = false;
+    generalDirty = false;
+    dirtyPoints.clear();
+    dirtyComponents.clear();
+
+    snapshot->publishedAt = Metrics::now();
+    published = snapshot;
+    deliver(snapshot);
+
+    // Moving on whether or not anything arrives
+    if (reckoning && publishTimer) publishTimer->start();
+}
+
+void ConsumerThread::deliver(std::shared_ptr<const ConsumerSnapshot> snapshot)
+{
+    buffer.write(snapshot);
+
+    // One pending notification is enough, the GUI always reads the newest snapshot
+    if (!notifyPending.exchange(true))
+        QMetaObject::invokeMethod(this, [this]() {
+            notifyPending = false;
+            current = buffer.read();
+            emit snapshotPublished();
+        }, Qt::QueuedConnection);
+}
+
+void ConsumerThread::measureArrival(cid_t cid, address_t address)
+{
+    const auto now = Metrics::now();
+    auto &arrival = arrivals[cid][{static_cast<quint32>(address.system),
+                                   static_cast<quint32>(address.group),
+                                   static_cast<quint32>(address.point)}];
+
+    // Every point of a component arrives once per message, so per point intervals are its message intervals
+    if (arrival.time)
+    {
+        auto &histogram = interArrival[cid];
+        if (!histogram)
+            histogram = &Metrics::getInstance().histogram(
+                        QString("Consumer %1 inter-arrival").arg(cid.toString()));
+        histogram->record((now - arrival.time) / 1000);
+    }
+    arrival.time = now;
+
+    // Only new samples, an unchanged timestamp is just the same value resent.
+    // Timestamps are taken as milliseconds since the epoch, as our own producer sends them,
+    // anything else lands outside an hour and is ignored
+    const auto timestamp = static_cast<quint64>(otpConsumer->getPosition(address, axis_t::X).timestamp);
+    if (timestamp && timestamp != arrival.timestamp)
+    {
+        const auto received = std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::system_clock::now().time_since_epoch()).count();
+        const auto latency = received - static_cast<qint64>(timestamp) * 1000;
+        if (latency >= 0 && latency < std::chrono::microseconds(std::chrono::hours(1)).count())
+            sourceLatency.record(latency);
+    }
+    arrival.timestamp = timestamp;
+}
+
+void ConsumerThread::queueFilter(address_t address, const std::shared_ptr<ConsumerSnapshot::pointValues_t> &values)
+{
+    const addressKey_t key{static_cast<quint32>(address.system),
+                           static_cast<quint32>(address.group),
+                           static_cast<quint32>(address.point)};
+    const auto groupFilter = groupFilters.find({std::get<0>(key), std::get<1>(key)});
+    if (groupFilter == groupFilters.end()) return;
+
+    // Expired values are left as they are, not pulled towards
+    if (values->expired) return;
+
+    auto &filter = motionFilters[groupFilter->second.mode];
+    if (!filter)
+        filter = createMotionFilter(groupFilter->second.mode);
+
+    auto filterSlot = filterSlots.find(key);
+    if (filterSlot != filterSlots.end() && filterSlot->second.filter != filter.get())
+    {
+        filterSlot->second.filter->removePoint(filterSlot->second.slot);
+        filterSlots.erase(filterSlot);
+        filterSlot = filterSlots.end();
+    }
+    if (filterSlot == filterSlots.end())
+        filterSlot = filterSlots.insert({key, {filter.get(), filter->addPoint(groupFilter->second.parameters)}}).first;
+    else
+        filter->setParameters(filterSlot->second.slot, groupFilter->second.parameters);
+
+    filtering.push_back({values, filterSlot->second});
+}
+
+void ConsumerThread::filterPoints()
+{
+    if (filtering.empty()) return;
+    const auto start = Metrics::now();
+
+    for (const auto &[values, filterSlot] : filtering)
+    {
+        const auto &[filter, slot] = filterSlot;
+        filter->beginSample(slot, start);
+        for (auto axis = axis_t::first; axis < axis_t::count; ++axis)
+        {
+            const auto &position = values->axes[axis].position;
+            const auto toMicrometers = position.scale == PositionModule_t::scale_e::mm ? 1000.0 : 1.0;
+            filter->setValue(axis, slot, static_cast<double>(position.value) * toMicrometers);
+            filter->setValue(axis_t::count + axis, slot, static_cast<double>(values->axes[axis].rotation.value));
+        }
+    }
+
+    for (const auto &filter : motionFilters)
+        if (filter) filter->filter();
+
+    const auto positionRange = VALUES::RANGES::getRange(VALUES::POSITION);
+    const auto rotationRange = VALUES::RANGES::getRange(VALUES::ROTATION);
+    for (const auto &[values, filterSlot] : filtering)
+    {
+        const auto &[filter, slot] = filterSlot;
+        for (auto axis = axis_t::first; axis < axis_t::count; ++axis)
+        {
+            auto &position = values->axes[axis].position;
+            const auto toMicrometers = position.scale == PositionModule_t::scale_e::mm ? 1000.0 : 1.0;
+            position.value = static_cast<decltype(position.value)>(std::clamp(
+                        std::llround(filter->getValue(axis, slot) / toMicrometers),
+                        static_cast<long long>(positionRange.getMin()),
+                        static_cast<long long>(positionRange.getMax())));
+
+            // Only the top of the wrap can round over
+            auto &rotation = values->axes[axis].rotation;
+            auto rotated = std::llround(filter->getValue(axis_t::count + axis, slot));
+            if (rotated > static_cast<long long>(rotationRange.getMax()))
+                rotated = static_cast<long long>(rotationRange.getMin());
+            rotation.value = static_cast<decltype(rotation.value)>(rotated);
+        }
+    }
+
+    filtering.clear();
+    filterDuration.record(Metrics::microsecondsSince(start));
+}
+
+void ConsumerThread::removeFilterSlots(const std::function<bool(const address_t&)> &predicate)
+{
+    for (auto it = filterSlots.begin(); it != filterSlots.end();)
+    {
+        const auto &[system, group, point] = it->first;
+        if (predicate(address_t(system_t(system), group_t(group), point_t(point))))
+        {
+            it->second.filter->removePoint(it->second.slot);
+            it = filterSlots.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void ConsumerThread::reckonPoint(address_t address)
+{
+    const addressKey_t key{static_cast<quint32>(address.system),
+                           static_cast<quint32>(address.group),
+                           static_cast<quint32>(address.point)};
+    auto slot = reckoningSlots.find(key);
+    if (slot == reckoningSlots.end())
+        slot = reckoningSlots.insert({key, {deadReckoning->addPoint(), 0}}).first;
+
+    // Only new samples, a resend would restart the prediction and be scored as the next sample
+    auto &consumer = *otpConsumer;
+    const auto timestamp = static_cast<quint64>(consumer.getPosition(address, axis_t::X).timestamp);
+    if (timestamp && timestamp == slot->second.timestamp) return;
+    slot->second.timestamp = timestamp;
+
+    // Micrometers, per second and per second squared
+    DeadReckoning::vector_t position, velocity, acceleration;
+    for (auto axis = axis_t::first; axis < axis_t::count; ++axis)
+    {
+        const auto value = consumer.getPosition(address, axis);
+        const auto toMicrometers = value.scale == PositionModule_t::scale_e::mm ? 1000.0 : 1.0;
+        position[axis] = static_cast<double>(value.value) * toMicrometers;
+        velocity[axis] = static_cast<double>(consumer.getPositionVelocity(address, axis).value);
+        acceleration[axis] = static_cast<double>(consumer.getPositionAcceleration(address, axis).value);
+    }
+
+    // Or derived, when not sent
+    const auto derived = derivedMotion ? derivedSlots.find(key) : derivedSlots.end();
+    if (derived != derivedSlots.end())
+    {
+        const auto derivedSlot = derived->second.slot;
+        for (auto axis = axis_t::first; axis < axis_t::count; ++axis)
+        {
+            if (consumer.getPositionVelocity(address, axis).sourceCID.isNull() && derivedMotion->hasVelocity(derivedSlot))
+                velocity[axis] = derivedMotion->getVelocity(axis, derivedSlot);
+            if (consumer.getPositionAcceleration(address, axis).sourceCID.isNull() && derivedMotion->hasAcceleration(derivedSlot))
+                acceleration[axis] = derivedMotion->getAcceleration(axis, derivedSlot);
+        }
+    }
+    deadReckoning->setSample(slot->second.slot, Metrics::now(), position, velocity, acceleration);
+}
+
+void ConsumerThread::reckonPoints(ConsumerSnapshot &snapshot)
+{
+    deadReckoning->predict(Metrics::now(), reckoned);
+
+    const auto positionRange = VALUES::RANGES::getRange(VALUES::POSITION);
+    for (const auto &[key, reckoningSlot] : reckoningSlots)
+    {
+        const auto slot = reckoningSlot.slot;
+        if (!deadReckoning->isActive(slot)) continue;
+        const auto &[system, group, point] = key;
+
+        // Filtered groups are smoothed instead
+        if (groupFilters.count({system, group})) continue;
+
+        auto systemValues = snapshot.systems.find(system_t(system));
+        if (systemValues == snapshot.systems.end()) continue;
+        auto groupValues = systemValues->find(group_t(group));
+        if (groupValues == systemValues->end()) continue;
+        const auto current = groupValues->points.value(point_t(point));
+        if (!current || current->expired) continue;
+
+        std::array<long long, axis_t::count> predicted;
+        bool moved = false;
+        for (auto axis = axis_t::first; axis < axis_t::count; ++axis)
+        {
+            const auto &position = current->axes[axis].position;
+            const auto toMicrometers = position.scale == PositionModule_t::scale_e::mm ? 1000.0 : 1.0;
+            predicted[axis] = std::clamp(
+                        std::llround(reckoned[axis][static_cast<size_t>(slot)] / toMicrometers),
+                        static_cast<long long>(positionRange.getMin()),
+                        static_cast<long long>(positionRange.getMax()));
+            moved |= predicted[axis] != static_cast<long long>(position.value);
+        }
+
+        // Unmoved points keep their values, and so their pointer, or every view would see them change
+        if (!moved) continue;
+
+        auto values = std::make_shared<ConsumerSnapshot::pointValues_t>(*current);
+        for (auto axis = axis_t::first; axis < axis_t::count; ++axis)
+        {
+            auto &position = values->axes[axis].position;
+            position.value = static_cast<decltype(position.value)>(predicted[axis]);
+        }
+        groupValues->points.insert(point_t(point), values);
+    }
+}
+
+void ConsumerThread::derivePoint(address_t address)
+{
+    const addressKey_t key{static_cast<quint32>(address.system),
+                           static_cast<quint32>(address.group),
+                           static_cast<quint32>(address.point)};
+    auto derived = derivedSlots.find(key);
+    if (derived == derivedSlots.end())
+        derived = derivedSlots.insert({key, {derivedMotion->addPoint(), 0}}).first;
+
+    // Only new samples, an unchanged timestamp is just the same value resent
+    auto &consumer = *otpConsumer;
+    const auto timestamp = std::max(
+                static_cast<quint64>(consumer.getPosition(address, axis_t::X).timestamp),
+                static_cast<quint64>(consumer.getRotation(address, axis_t::X).timestamp));
+    if (timestamp && timestamp == derived->second.timestamp) return;
+    derived->second.timestamp = timestamp;
+
+    // Micrometers and millionths of a degree
+    const auto slot = derived->second.slot;
+    for (auto axis = axis_t::first; axis < axis_t::count; ++axis)
+    {
+        const auto position = consumer.getPosition(address, axis);
+        const auto toMicrometers = position.scale == PositionModule_t::scale_e::mm ? 1000.0 : 1.0;
+        derivedMotion->setValue(axis, slot, static_cast<double>(position.value) * toMicrometers);
+        derivedMotion->setValue(axis_t::count + axis, slot, static_cast<double>(consumer.getRotation(address, axis).value));
+    }
+    derivedMotion->update(slot, Metrics::now());
+}
+
+void ConsumerThread::applyDerived(address_t address, ConsumerSnapshot::pointValues_t &values)
+{
+    const auto derived = derivedSlots.find({static_cast<quint32>(address.system),
+                                            static_cast<quint32>(address.group),
+                                            static_cast<quint32>(address.point)});
+    if (derived == derivedSlots.end()) return;
+    const auto slot = derived->second.slot;
+
+    // Rotation velocity and acceleration are in thousandths of a degree, rotation in millionths
+    constexpr double RotationRateUnits = 0.001;
+
+    // Derived rates into a value no source sent, clamped to its module's range
+    const auto fill = [](auto &value, bool &flag, VALUES::moduleValue_t moduleValue, double rate) {
+        if (!value.sourceCID.isNull()) return;
+        const auto range = VALUES::RANGES::getRange(moduleValue);
+        value.value = static_cast<std::decay_t<decltype(value.value)>>(std::clamp(
+                    std::llround(rate),
+                    static_cast<long long>(range.getMin()),
+                    static_cast<long long>(range.getMax())));
+        flag = true;
+    };
+    for (auto axis = axis_t::first; axis < axis_t::count; ++axis)
+    {
+        auto &axisValues = values.axes[axis];
+        if (derivedMotion->hasVelocity(slot))
+        {
+            fill(axisValues.positionVelocity, axisValues.positionVelocityDerived, VALUES::POSITION_VELOCITY,
+                 derivedMotion->getVelocity(axis, slot));
+            fill(axisValues.rotationVelocity, axisValues.rotationVelocityDerived, VALUES::ROTATION_VELOCITY,
+                 derivedMotion->getVelocity(axis_t::count + axis, slot) * RotationRateUnits);
+        }
+        if (derivedMotion->hasAcceleration(slot))
+        {
+            fill(axisValues.positionAcceleration, axisValues.positionAccelerationDerived, VALUES::POSITION_ACCELERATION,
+                 derivedMotion->getAcceleration(axis, slot));
+            fill(axisValues.rotationAcceleration, axisValues.rotationAccelerationDerived, VALUES::ROTATION_ACCELERATION,
+                 derivedMotion->getAcceleration(axis_t::count + axis, slot) * RotationRateUnits);
+        }
+    }
+}
+
+void ConsumerThread::shareAllPoints()
+{
+    auto &consumer = *otpConsumer;
+    for (const auto &system : consumer.getLocalSystems())
+        for (const auto &group : consumer.getGroups(system))
+            for (const auto &point : consumer.getPoints(system, group))
+                sharedPoints->update(consumer, address_t(system, group, point));
+}
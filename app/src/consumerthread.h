@@ -0,0 +1,219 @@
+/*
+    OTPView
+    A QT Frontend for E1.59  (Entertainment  Technology  Object  Transform  Protocol  (OTP))
+    Copyright (C) 2026  Marcus Birkin
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#ifndef CONSUMERTHREAD_H
+#define CONSUMERTHREAD_H
+
+#include <QHash>
+#include <QObject>
+#include <QSet>
+#include <QThread>
+#include <QTimer>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
+#include <set>
+#include <tuple>
+#include "OTPLib.hpp"
+#include "consumersnapshot.h"
+#include "derivedmotion.h"
+#include "metrics.h"
+#include "motionfilter.h"
+#include "sharedpointtable.h"
+#include "triplebuffer.h"
+
+/*
+ * OTP consumer running on its own thread
+ *
+ * Receiving, winner selection and expiry all happen on the worker thread,
+ * so nothing the GUI does (resizing, chart repaints) can delay them.
+ * The GUI reads immutable snapshots instead, published through a triple buffer
+ * no more than once every PublishInterval, and is told about new ones by snapshotPublished().
+ *
+ * Commands are queued to the worker thread, their effect shows in a following snapshot.
+ *
+ * Groups can be given a MotionFilter, their points' winning positions and rotations
+ * are then smoothed as each snapshot is built, before anything reads them.
+ * With dead reckoning, the other points' positions are moved on from their last sample
+ * in every snapshot, which are then published every PublishInterval.
+ * Velocities and accelerations no source sends can be derived from positions and rotations
+ */
+class ConsumerThread : public QObject
+{
+    Q_OBJECT
+public:
+    static constexpr std::chrono::milliseconds PublishInterval{20};
+    static constexpr std::chrono::milliseconds DeadReckoningLimit{500};
+    static constexpr std::chrono::milliseconds DerivedMotionSmoothing{50};
+
+    explicit ConsumerThread(
+            QNetworkInterface iface,
+            QAbstractSocket::NetworkLayerProtocol transport,
+            OTP::cid_t CID,
+            QString name,
+            QObject *parent = nullptr);
+    ~ConsumerThread();
+
+    // Stops receiving, afterwards commands are ignored and the last snapshot remains
+    void stop();
+
+    // Latest snapshot, GUI thread only
+    std::shared_ptr<const ConsumerSnapshot> snapshot() const { return current; }
+
+    // The consumer lives on the worker thread, connect to it with Qt::DirectConnection
+    // only when the receiver is thread safe (see ComponentStatistics)
+    std::shared_ptr<class OTP::Consumer> consumer() const { return otpConsumer; }
+
+    void setNetworkInterface(QNetworkInterface value);
+    void setNetworkTransport(QAbstractSocket::NetworkLayerProtocol value);
+    void setLocalName(QString value);
+    void setLocalCID(OTP::cid_t value);
+    void addLocalSystem(OTP::system_t system);
+    void removeLocalSystem(OTP::system_t system);
+    void updateOTPMap();
+
+    // Publishes every point's winning values to the named shared memory, empty to stop
+    void setSharedMemory(QString name);
+
+    // Smooths the group's points in every following snapshot
+    void setGroupFilter(OTP::system_t system, OTP::group_t group,
+                        MotionFilter::mode_t mode, MotionFilter::parameters_t parameters);
+    void clearGroupFilter(OTP::system_t system, OTP::group_t group);
+
+    // Worker thread only, for those connected to the consumer, false when the group isn't filtered
+    bool getGroupFilter(OTP::system_t system, OTP::group_t group,
+                        MotionFilter::mode_t &mode, MotionFilter::parameters_t &parameters) const;
+
+    // Filters channels of position in micrometers, then rotation in millionths of a degree
+    static std::unique_ptr<MotionFilter> createMotionFilter(MotionFilter::mode_t mode);
+
+    // Predicts positions between samples from their velocity and acceleration
+    void setDeadReckoning(bool enabled);
+    void resetDeadReckoningError();
+
+    // Fills in velocities and accelerations that aren't sent, from successive samples
+    void setDeriveMotion(bool enabled);
+
+signals:
+    void snapshotPublished();
+    void sharedMemoryFailed(QString message);
+
+protected:
+    // Without a consumer or worker thread, for synthetic sources that build their own snapshots
+    explicit ConsumerThread(QObject *parent);
+
+    // Hands a finished snapshot over to the GUI thread, only ever from one thread,
+    // publishedAt should already be set
+    void deliver(std::shared_ptr<const ConsumerSnapshot> snapshot);
+
+private:
+    // Worker thread
+    void post(std::function<void()> command);
+    void connectConsumer();
+    void markPoint(OTP::system_t system, OTP::group_t group, OTP::point_t point);
+    void markComponent(OTP::cid_t cid);
+    void markStructure();
+    void markGeneral();
+    void publish();
+    void measureArrival(OTP::cid_t cid, OTP::address_t address);
+    void shareAllPoints();
+    void markGroup(OTP::system_t system, OTP::group_t group);
+    void queueFilter(OTP::address_t address, const std::shared_ptr<ConsumerSnapshot::pointValues_t> &values);
+    void filterPoints();
+    void removeFilterSlots(const std::function<bool(const OTP::address_t&)> &predicate);
+    void markAllPoints();
+    void reckonPoint(OTP::address_t address);
+    void derivePoint(OTP::address_t address);
+    void applyDerived(OTP::address_t address, ConsumerSnapshot::pointValues_t &values);
+    void reckonPoints(ConsumerSnapshot &snapshot);
+
+    QThread thread;
+    QObject *context; // Lives on the worker thread
+    std::shared_ptr<class OTP::Consumer> otpConsumer;
+
+    // Worker thread only
+    QTimer *publishTimer = nullptr;
+    std::shared_ptr<const ConsumerSnapshot> published;
+    typedef std::tuple<quint32, quint32, quint32> addressKey_t;
+    std::set<addressKey_t> dirtyPoints;
+    QSet<OTP::cid_t> dirtyComponents;
+    bool structureDirty = false;
+    bool generalDirty = false;
+
+    // Worker thread only, timing metrics
+    typedef struct arrival_s
+    {
+        qint64 time = 0;
+        quint64 timestamp = 0;
+    } arrival_t;
+    QHash<OTP::cid_t, std::map<addressKey_t, arrival_t>> arrivals;
+    QHash<OTP::cid_t, Histogram*> interArrival;
+    Histogram &sourceLatency;
+
+    // Worker thread only
+    std::unique_ptr<SharedPointTable> sharedPoints;
+
+    // Worker thread only, motion filtering
+    typedef struct groupFilter_s
+    {
+        MotionFilter::mode_t mode;
+        MotionFilter::parameters_t parameters;
+    } groupFilter_t;
+    std::map<std::pair<quint32, quint32>, groupFilter_t> groupFilters;
+    std::array<std::unique_ptr<MotionFilter>, 2> motionFilters; // By mode, made on first use
+    typedef struct filterSlot_s
+    {
+        MotionFilter *filter;
+        int slot;
+    } filterSlot_t;
+    std::map<addressKey_t, filterSlot_t> filterSlots;
+    typedef struct filtering_s
+    {
+        std::shared_ptr<ConsumerSnapshot::pointValues_t> values;
+        filterSlot_t filterSlot;
+    } filtering_t;
+    std::vector<filtering_t> filtering; // Captured for this snapshot
+    Histogram &filterDuration;
+
+    // Worker thread only, slots of the engines taking every new sample
+    typedef struct sampleSlot_s
+    {
+        int slot;
+        quint64 timestamp; // Of the last sample, resent values are skipped
+    } sampleSlot_t;
+
+    // Worker thread only, dead reckoning
+    std::unique_ptr<DeadReckoning> deadReckoning;
+    std::map<addressKey_t, sampleSlot_t> reckoningSlots;
+    std::array<std::vector<double>, DeadReckoning::Axes> reckoned;
+
+    // Worker thread only, derived motion
+    std::unique_ptr<DerivedMotion> derivedMotion;
+    std::map<addressKey_t, sampleSlot_t> derivedSlots;
+
+    TripleBuffer<std::shared_ptr<const ConsumerSnapshot>> buffer;
+    std::atomic<bool> notifyPending = false;
+
+    // GUI thread only
+    std::shared_ptr<const ConsumerSnapshot> current;
+};
+
+#endif // CONSUMERTHREAD_H
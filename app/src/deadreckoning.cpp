@@ -0,0 +1,126 @@
+/*
+    OTPView
+    A QT Frontend for E1.59  (Entertainment  Technology  Object  Transform  Protocol  (OTP))
+    Copyright (C) 2026  Marcus Birkin
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "deadreckoning.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    constexpr double NanosecondsPerSecond = 1e9;
+}
+
+DeadReckoning::DeadReckoning(qint64 limit) :
+    limit(limit)
+{}
+
+int DeadReckoning::addPoint()
+{
+    if (!freeSlots.empty())
+    {
+        const auto slot = freeSlots.back();
+        freeSlots.pop_back();
+        return slot;
+    }
+
+    for (auto *perAxis : {&position, &velocity, &acceleration})
+        for (auto &values : *perAxis)
+            values.push_back(0);
+    sampleTime.push_back(0);
+    active.push_back(0);
+    return getSlotCount() - 1;
+}
+
+void DeadReckoning::removePoint(int slot)
+{
+    active[slot] = 0;
+    freeSlots.push_back(slot);
+}
+
+void DeadReckoning::setSample(int slot, qint64 time, const vector_t &position, const vector_t &velocity, const vector_t &acceleration)
+{
+    if (active[slot])
+    {
+        const auto predicted = predict(slot, time);
+        double squared = 0;
+        for (int axis = 0; axis < Axes; ++axis)
+            squared += (predicted[axis] - position[axis]) * (predicted[axis] - position[axis]);
+        const auto error = std::sqrt(squared);
+        ++errorCount;
+        errorSum += error;
+        errorSquares += squared;
+        errorMax = std::max(errorMax, error);
+    }
+
+    for (int axis = 0; axis < Axes; ++axis)
+    {
+        this->position[axis][slot] = position[axis];
+        this->velocity[axis][slot] = velocity[axis];
+        this->acceleration[axis][slot] = acceleration[axis];
+    }
+    sampleTime[slot] = time;
+    active[slot] = 1;
+}
+
+DeadReckoning::vector_t DeadReckoning::predict(int slot, qint64 time) const
+{
+    const auto t = static_cast<double>(std::clamp<qint64>(time - sampleTime[slot], 0, limit)) / NanosecondsPerSecond;
+    vector_t ret;
+    for (int axis = 0; axis < Axes; ++axis)
+        ret[axis] = position[axis][slot] + velocity[axis][slot] * t + 0.5 * acceleration[axis][slot] * t * t;
+    return ret;
+}
+
+void DeadReckoning::predict(qint64 time, std::array<std::vector<double>, Axes> &out)
+{
+    const auto count = sampleTime.size();
+    elapsed.resize(count);
+    for (size_t slot = 0; slot < count; ++slot)
+        elapsed[slot] = static_cast<double>(std::clamp<qint64>(time - sampleTime[slot], 0, limit)) / NanosecondsPerSecond;
+
+    // Plain loops over contiguous arrays, left for the compiler to vectorise
+    const auto *t = elapsed.data();
+    for (int axis = 0; axis < Axes; ++axis)
+    {
+        out[axis].resize(count);
+        const auto *p = position[axis].data();
+        const auto *v = velocity[axis].data();
+        const auto *a = acceleration[axis].data();
+        auto *values = out[axis].data();
+        for (size_t slot = 0; slot < count; ++slot)
+            values[slot] = p[slot] + (v[slot] + 0.5 * a[slot] * t[slot]) * t[slot];
+    }
+}
+
+DeadReckoning::error_t DeadReckoning::getError() const
+{
+    error_t ret;
+    ret.count = errorCount;
+    if (!errorCount) return ret;
+    ret.mean = errorSum / static_cast<double>(errorCount);
+    ret.rms = std::sqrt(errorSquares / static_cast<double>(errorCount));
+    ret.max = errorMax;
+    return ret;
+}
+
+void DeadReckoning::resetError()
+{
+    errorCount = 0;
+    errorSum = 0;
+    errorSquares = 0;
+    errorMax = 0;
+}
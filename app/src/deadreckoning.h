@@ -0,0 +1,87 @@
+/*
+    OTPView
+    A QT Frontend for E1.59  (Entertainment  Technology  Object  Transform  Protocol  (OTP))
+    Copyright (C) 2026  Marcus Birkin
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#ifndef DEADRECKONING_H
+#define DEADRECKONING_H
+
+#include <QtGlobal>
+#include <array>
+#include <vector>
+
+/*
+ * Predicts point positions between samples from their transmitted velocity and acceleration
+ *
+ * As Resampler, points are slots and every axis is one contiguous array across all points,
+ * so predicting tens of thousands of points is a few plain loops. A prediction is
+ * position + velocity·t + ½·acceleration·t², t from the sample's arrival and no longer than the limit.
+ *
+ * Each new sample is compared with what was predicted for it, the distance between the two
+ * is kept as the error. Positions are in micrometers, velocities per second, accelerations
+ * per second squared. Times are in nanoseconds, as Metrics::now()
+ */
+class DeadReckoning
+{
+public:
+    static constexpr int Axes = 3;
+    typedef std::array<double, Axes> vector_t;
+
+    typedef struct error_s
+    {
+        quint64 count = 0;
+        double mean = 0; // Micrometers
+        double rms = 0;
+        double max = 0;
+    } error_t;
+
+    explicit DeadReckoning(qint64 limit);
+
+    int getSlotCount() const { return static_cast<int>(sampleTime.size()); }
+
+    int addPoint();
+    void removePoint(int slot);
+    bool isActive(int slot) const { return active[slot] > 0; }
+
+    void setSample(int slot, qint64 time, const vector_t &position, const vector_t &velocity, const vector_t &acceleration);
+
+    // Every slot at time, one array per axis, values of inactive slots are meaningless
+    void predict(qint64 time, std::array<std::vector<double>, Axes> &out);
+
+    error_t getError() const;
+    void resetError();
+
+private:
+    vector_t predict(int slot, qint64 time) const;
+
+    qint64 limit;
+
+    // Per axis
+    std::array<std::vector<double>, Axes> position, velocity, acceleration;
+
+    // Per slot
+    std::vector<qint64> sampleTime;
+    std::vector<int> active;
+    std::vector<int> freeSlots;
+    std::vector<double> elapsed; // Reused by predict()
+
+    quint64 errorCount = 0;
+    double errorSum = 0;
+    double errorSquares = 0;
+    double errorMax = 0;
+};
+
+#endif // DEADRECKONING_H
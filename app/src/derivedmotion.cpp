@@ -0,0 +1,93 @@
+/*
+    OTPView
+    A QT Frontend for E1.59  (Entertainment  Technology  Object  Transform  Protocol  (OTP))
+    Copyright (C) 2026  Marcus Birkin
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "derivedmotion.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    constexpr double NanosecondsPerSecond = 1e9;
+}
+
+DerivedMotion::DerivedMotion(const std::vector<double> &wrapSpans, qint64 smoothingTime) :
+    wrapSpans(wrapSpans),
+    smoothingTime(static_cast<double>(smoothingTime) / NanosecondsPerSecond),
+    sample(wrapSpans.size()),
+    previous(wrapSpans.size()),
+    velocity(wrapSpans.size()),
+    acceleration(wrapSpans.size())
+{}
+
+int DerivedMotion::addPoint()
+{
+    if (!freeSlots.empty())
+    {
+        const auto slot = freeSlots.back();
+        freeSlots.pop_back();
+        return slot;
+    }
+
+    for (auto *perChannel : {&sample, &previous, &velocity, &acceleration})
+        for (auto &values : *perChannel)
+            values.push_back(0);
+    sampleTime.push_back(0);
+    sampleCount.push_back(0);
+    return getSlotCount() - 1;
+}
+
+void DerivedMotion::removePoint(int slot)
+{
+    sampleCount[slot] = 0;
+    freeSlots.push_back(slot);
+}
+
+void DerivedMotion::update(int slot, qint64 time)
+{
+    // Nothing to difference against, or no time between them
+    const auto count = sampleCount[slot];
+    const auto dt = static_cast<double>(time - sampleTime[slot]) / NanosecondsPerSecond;
+    if (count && dt <= 0) return;
+
+    const auto alpha = dt / (dt + smoothingTime);
+    for (size_t channel = 0; channel < wrapSpans.size(); ++channel)
+    {
+        const auto value = sample[channel][slot];
+        auto &last = previous[channel][slot];
+        if (count)
+        {
+            auto difference = value - last;
+            if (wrapSpans[channel] > 0)
+                difference = std::remainder(difference, wrapSpans[channel]);
+
+            // The first difference starts the velocity, the first change of that the acceleration
+            auto &v = velocity[channel][slot];
+            auto &a = acceleration[channel][slot];
+            const auto oldVelocity = v;
+            v = count == 1 ? difference / dt : v + alpha * (difference / dt - v);
+            if (count >= 2)
+            {
+                const auto change = (v - oldVelocity) / dt;
+                a = count == 2 ? change : a + alpha * (change - a);
+            }
+        }
+        last = value;
+    }
+
+    sampleTime[slot] = time;
+    sampleCount[slot] = std::min(count + 1, 3);
+}
@@ -0,0 +1,72 @@
+/*
+    OTPView
+    A QT Frontend for E1.59  (Entertainment  Technology  Object  Transform  Protocol  (OTP))
+    Copyright (C) 2026  Marcus Birkin
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#ifndef DERIVEDMOTION_H
+#define DERIVEDMOTION_H
+
+#include <QtGlobal>
+#include <vector>
+
+/*
+ * Velocity and acceleration of point streams that only carry position and rotation
+ *
+ * Worked out incrementally as each sample arrives, by finite differences of successive samples,
+ * each smoothed by a first order low pass with the given time constant.
+ * As Resampler, every point is a slot and every channel is one contiguous array across all points.
+ * Channels with a wrap span (rotations) change the short way around.
+ * Rates are per second, times are in nanoseconds, as Metrics::now()
+ */
+class DerivedMotion
+{
+public:
+    // A wrap span per channel, 0 for none
+    DerivedMotion(const std::vector<double> &wrapSpans, qint64 smoothingTime);
+
+    int getChannelCount() const { return static_cast<int>(wrapSpans.size()); }
+    int getSlotCount() const { return static_cast<int>(sampleTime.size()); }
+
+    int addPoint();
+    void removePoint(int slot);
+
+    // Set every channel, then update() with the sample's time
+    void setValue(int channel, int slot, double value) { sample[channel][slot] = value; }
+    void update(int slot, qint64 time);
+
+    // After two samples, and three
+    bool hasVelocity(int slot) const { return sampleCount[slot] >= 2; }
+    bool hasAcceleration(int slot) const { return sampleCount[slot] >= 3; }
+    double getVelocity(int channel, int slot) const { return velocity[channel][slot]; }
+    double getAcceleration(int channel, int slot) const { return acceleration[channel][slot]; }
+
+private:
+    std::vector<double> wrapSpans;
+    double smoothingTime; // Seconds
+
+    // Per channel
+    std::vector<std::vector<double>> sample;
+    std::vector<std::vector<double>> previous;
+    std::vector<std::vector<double>> velocity;
+    std::vector<std::vector<double>> acceleration;
+
+    // Per slot
+    std::vector<qint64> sampleTime;
+    std::vector<int> sampleCount; // Up to 3, 0 when free
+    std::vector<int> freeSlots;
+};
+
+#endif // DERIVEDMOTION_H
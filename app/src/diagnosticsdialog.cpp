@@ -0,0 +1,166 @@
+/*
+    OTPView
+    A QT Frontend for E1.59  (Entertainment  Technology  Object  Transform  Protocol  (OTP))
+    Copyright (C) 2026  Marcus Birkin
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "diagnosticsdialog.h"
+#include "ui_diagnosticsdialog.h"
+#include "metrics.h"
+#include "profiler.h"
+#include <QFileDialog>
+#include <QHeaderView>
+#include <QMessageBox>
+#include <chrono>
+
+DiagnosticsDialog::DiagnosticsDialog(QWidget *parent) :
+    QDialog(parent),
+    ui(new Ui::DiagnosticsDialog)
+{
+    ui->setupUi(this);
+    setWindowFlag(Qt::WindowContextHelpButtonHint, false);
+
+    ui->twMetrics->setColumnCount(9);
+    ui->twMetrics->setHorizontalHeaderLabels({
+        tr("Metric"), tr("Count"),
+        tr("Min (ms)"), tr("Mean (ms)"), tr("P50 (ms)"), tr("P90 (ms)"), tr("P99 (ms)"), tr("P99.9 (ms)"), tr("Max (ms)")});
+    ui->twMetrics->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+    ui->twMetrics->horizontalHeader()->setSectionResizeMode(0, QHeaderView::Stretch);
+
+    ui->twProfile->setColumnCount(4);
+    ui->twProfile->setHorizontalHeaderLabels({tr("Section"), tr("Calls"), tr("Total (ms)"), tr("Max (ms)")});
+    ui->twProfile->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+    ui->twProfile->horizontalHeader()->setSectionResizeMode(0, QHeaderView::Stretch);
+    ui->cbProfiler->setChecked(Profiler::isEnabled());
+    connect(&Profiler::getInstance(), &Profiler::summarised, this, &DiagnosticsDialog::refreshProfile);
+    refreshProfile();
+
+    refreshTimer.setInterval(std::chrono::seconds(1));
+    connect(&refreshTimer, &QTimer::timeout, this, &DiagnosticsDialog::refresh);
+    refreshTimer.start();
+    refresh();
+}
+
+DiagnosticsDialog::~DiagnosticsDialog()
+{
+    delete ui;
+}
+
+void DiagnosticsDialog::refresh()
+{
+    const auto histograms = Metrics::getInstance().histograms();
+    ui->twMetrics->setRowCount(histograms.count());
+
+    const auto setCell = [this](int row, int column, const QString &text) {
+        auto item = ui->twMetrics->item(row, column);
+        if (!item)
+        {
+            item = new QTableWidgetItem();
+            if (column) item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+            ui->twMetrics->setItem(row, column, item);
+        }
+        item->setText(text);
+    };
+    const auto ms = [](double microseconds) { return QString::number(microseconds / 1000.0, 'f', 3); };
+
+    for (int row = 0; row < histograms.count(); ++row)
+    {
+        const auto &[name, histogram] = histograms.at(row);
+        const auto summary = histogram->summary();
+        setCell(row, 0, name);
+        setCell(row, 1, QString::number(summary.count));
+        setCell(row, 2, ms(summary.min));
+        setCell(row, 3, ms(summary.mean));
+        setCell(row, 4, ms(summary.p50));
+        setCell(row, 5, ms(summary.p90));
+        setCell(row, 6, ms(summary.p99));
+        setCell(row, 7, ms(summary.p999));
+        setCell(row, 8, ms(summary.max));
+    }
+}
+
+void DiagnosticsDialog::on_pbReset_clicked()
+{
+    Metrics::getInstance().reset();
+    emit metricsReset();
+    refresh();
+}
+
+void DiagnosticsDialog::on_pbSave_clicked()
+{
+    auto fileName = QFileDialog::getSaveFileName(
+                this, tr("Save Diagnostics"), QString(),
+                tr("JSON (*.json)"));
+    if (fileName.isEmpty())
+        return;
+
+    QString errorString;
+    if (!Metrics::getInstance().save(fileName, &errorString))
+        QMessageBox::warning(this, tr("Save Diagnostics"),
+                             tr("Unable to save %1\n%2").arg(fileName, errorString));
+}
+
+void DiagnosticsDialog::refreshProfile()
+{
+    const auto summaries = Profiler::getInstance().getSummaries();
+    if (summaries.isEmpty())
+    {
+        ui->lblEventLoop->setText(Profiler::isEnabled() ? tr("Waiting for first second") : QString());
+        ui->twProfile->setRowCount(0);
+        return;
+    }
+
+    const auto &summary = summaries.last();
+    ui->lblEventLoop->setText(tr("Event loop latency: %1 ms avg, %2 ms max").arg(
+                                  QString::number(summary.eventLoopLatencyMeanMs, 'f', 2),
+                                  QString::number(summary.eventLoopLatencyMaxMs, 'f', 2)));
+
+    ui->twProfile->setRowCount(summary.sections.count());
+    int row = 0;
+    for (auto it = summary.sections.cbegin(); it != summary.sections.cend(); ++it, ++row)
+    {
+        const QString cells[] = {
+            it.key(),
+            QString::number(it->count),
+            QString::number(it->totalMs, 'f', 3),
+            QString::number(it->maxMs, 'f', 3)};
+        for (int column = 0; column < 4; ++column)
+        {
+            auto item = new QTableWidgetItem(cells[column]);
+            if (column) item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+            ui->twProfile->setItem(row, column, item);
+        }
+    }
+}
+
+void DiagnosticsDialog::on_cbProfiler_toggled(bool checked)
+{
+    Profiler::getInstance().setEnabled(checked);
+    refreshProfile();
+}
+
+void DiagnosticsDialog::on_pbExportTrace_clicked()
+{
+    auto fileName = QFileDialog::getSaveFileName(
+                this, tr("Export Trace"), QString(),
+                tr("Chrome Trace (*.json)"));
+    if (fileName.isEmpty())
+        return;
+
+    QString errorString;
+    if (!Profiler::getInstance().exportTrace(fileName, &errorString))
+        QMessageBox::warning(this, tr("Export Trace"),
+                             tr("Unable to save %1\n%2").arg(fileName, errorString));
+}
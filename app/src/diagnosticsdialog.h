@@ -0,0 +1,58 @@
+/*
+    OTPView
+    A QT Frontend for E1.59  (Entertainment  Technology  Object  Transform  Protocol  (OTP))
+    Copyright (C) 2026  Marcus Birkin
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#ifndef DIAGNOSTICSDIALOG_H
+#define DIAGNOSTICSDIALOG_H
+
+#include <QDialog>
+#include <QTimer>
+
+namespace Ui {
+class DiagnosticsDialog;
+}
+
+/*
+ * Summary of every Metrics histogram, refreshed once a second,
+ * and the controls and last per second summary of the GUI profiler
+ */
+class DiagnosticsDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    explicit DiagnosticsDialog(QWidget *parent = nullptr);
+    ~DiagnosticsDialog();
+
+signals:
+    void metricsReset(); // For statistics kept outside Metrics
+
+private slots:
+    void on_pbReset_clicked();
+    void on_pbSave_clicked();
+    void on_cbProfiler_toggled(bool checked);
+    void on_pbExportTrace_clicked();
+
+private:
+    Ui::DiagnosticsDialog *ui;
+    void refresh();
+    void refreshProfile();
+
+    QTimer refreshTimer;
+};
+
+#endif // DIAGNOSTICSDIALOG_H
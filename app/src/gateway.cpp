@@ -0,0 +1,512 @@
+/*
+    OTPView
+    A QT Frontend for E1.59  (Entertainment  Technology  Object  Transform  Protocol  (OTP))
+    Copyright (C) 2026  Marcus Birkin
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "gateway.h"
+#include "producertransaction.h"
+#include <QTimer>
+#include <algorithm>
+#include <cmath>
+
+using namespace OTP;
+using namespace OTP::MODULES::STANDARD;
+
+namespace {
+    // Rotations are in millionths of a degree
+    constexpr double Pi = 3.14159265358979323846;
+    constexpr double DegreesToRadians = Pi / 180.0;
+    constexpr double RotationToRadians = DegreesToRadians / 1000000.0;
+    constexpr double RadiansToRotation = 1.0 / RotationToRadians;
+    constexpr std::array<double, axis_t::count> NoOffset{};
+
+    // In the order of Gateway::moduleVectors()
+    constexpr std::array<VALUES::moduleValue_t, 7> Modules{
+        VALUES::POSITION, VALUES::POSITION_VELOCITY, VALUES::POSITION_ACCELERATION,
+        VALUES::ROTATION, VALUES::ROTATION_VELOCITY, VALUES::ROTATION_ACCELERATION,
+        VALUES::SCALE};
+
+    // X, Y then Z applied about the fixed axes, as SceneCrossfade
+    std::array<double, 4> toQuaternion(double x, double y, double z)
+    {
+        const auto cx = std::cos(x / 2), sx = std::sin(x / 2);
+        const auto cy = std::cos(y / 2), sy = std::sin(y / 2);
+        const auto cz = std::cos(z / 2), sz = std::sin(z / 2);
+        return {cx * cy * cz + sx * sy * sz,
+                sx * cy * cz - cx * sy * sz,
+                cx * sy * cz + sx * cy * sz,
+                cx * cy * sz - sx * sy * cz};
+    }
+}
+
+Gateway::Gateway(std::shared_ptr<ConsumerThread> otpConsumer, const config_t &config, QObject *parent) : QObject(parent),
+    otpConsumer(otpConsumer),
+    config(config),
+    context(new QObject),
+    latency(Metrics::getInstance().histogram(
+                QString("Gateway %1 to %2 receive to apply latency")
+                .arg(static_cast<quint32>(config.sourceSystem))
+                .arg(static_cast<quint32>(config.targetSystem))))
+{
+    const auto &transform = config.transform;
+    rotationQuaternion = toQuaternion(transform.rotation[axis_t::X] * DegreesToRadians,
+                                      transform.rotation[axis_t::Y] * DegreesToRadians,
+                                      transform.rotation[axis_t::Z] * DegreesToRadians);
+    const auto [w, x, y, z] = rotationQuaternion;
+    rotationMatrix = {{
+        {1 - 2 * (y * y + z * z), 2 * (x * y - w * z), 2 * (x * z + w * y)},
+        {2 * (x * y + w * z), 1 - 2 * (x * x + z * z), 2 * (y * z - w * x)},
+        {2 * (x * z - w * y), 2 * (y * z + w * x), 1 - 2 * (x * x + y * y)}}};
+    for (size_t row = 0; row < 3; ++row)
+        for (size_t column = 0; column < 3; ++column)
+            linearMatrix[row][column] = rotationMatrix[row][column] * transform.scale[column];
+
+    otpProducer = std::make_shared<ProducerThread>(
+                config.iface, config.transport, config.CID, config.name, config.transformRate);
+    otpProducer->addLocalSystem(config.targetSystem);
+
+    // Only received while a local system, left as it was found
+    if (!otpConsumer->snapshot()->localSystems.contains(config.sourceSystem))
+    {
+        otpConsumer->addLocalSystem(config.sourceSystem);
+        addedLocalSystem = true;
+    }
+
+    const auto consumer = otpConsumer->consumer();
+    if (!consumer) return;
+    context->moveToThread(consumer->thread());
+    QMetaObject::invokeMethod(context, [this]() {
+        // Fires once the rest of the message being received has been handled
+        batchTimer = new QTimer(context);
+        batchTimer->setSingleShot(true);
+        batchTimer->setInterval(0);
+        connect(batchTimer, &QTimer::timeout, context, [this]() { sendBatch(); });
+
+        if (this->config.resample)
+        {
+            // Rotations change the short way around
+            std::vector<double> wrapSpans;
+            for (const auto moduleValue : Modules)
+            {
+                const auto range = VALUES::RANGES::getRange(moduleValue);
+                const auto span = moduleValue == VALUES::ROTATION
+                        ? static_cast<double>(range.getMax()) - static_cast<double>(range.getMin()) + 1 : 0.0;
+                wrapSpans.insert(wrapSpans.end(), axis_t::count, span);
+            }
+            resampler = std::make_unique<Resampler>(
+                        this->config.resampleMode, wrapSpans,
+                        std::chrono::nanoseconds(ExtrapolationLimit).count());
+
+            if (this->config.deadReckoning)
+                deadReckoning = std::make_unique<DeadReckoning>(
+                            std::chrono::nanoseconds(ExtrapolationLimit).count());
+
+            outputTimer = new QTimer(context);
+            outputTimer->setTimerType(Qt::PreciseTimer);
+            outputTimer->setInterval(this->config.transformRate);
+            connect(outputTimer, &QTimer::timeout, context, [this]() { sendResampled(); });
+            outputTimer->start();
+        }
+
+        connectConsumer();
+        auto &consumer = *this->otpConsumer->consumer();
+        for (const auto &group : consumer.getGroups(this->config.sourceSystem))
+            for (const auto &point : consumer.getPoints(this->config.sourceSystem, group))
+                addPoint(address_t(this->config.sourceSystem, group, point));
+    }, Qt::BlockingQueuedConnection);
+}
+
+Gateway::~Gateway()
+{
+    if (context->thread() != QThread::currentThread() && context->thread()->isRunning())
+    {
+        QMetaObject::invokeMethod(context, [this]() {
+            delete batchTimer;
+            batchTimer = nullptr;
+            delete outputTimer;
+            outputTimer = nullptr;
+            if (const auto consumer = otpConsumer->consumer())
+                consumer->disconnect(context);
+        }, Qt::BlockingQueuedConnection);
+        context->deleteLater();
+    } else {
+        delete context;
+    }
+
+    if (addedLocalSystem)
+        otpConsumer->removeLocalSystem(config.sourceSystem);
+}
+
+address_t Gateway::remap(const config_t &config, address_t source)
+{
+    const auto group = static_cast<qint64>(source.group) + config.groupOffset;
+    const auto point = static_cast<qint64>(source.point) + config.pointOffset;
+    if (group < static_cast<qint64>(group_t::getMin()) || group > static_cast<qint64>(group_t::getMax())
+            || point < static_cast<qint64>(point_t::getMin()) || point > static_cast<qint64>(point_t::getMax()))
+        return address_t();
+    return address_t(config.targetSystem, group_t(static_cast<quint32>(group)), point_t(static_cast<quint32>(point)));
+}
+
+Gateway::addressKey_t Gateway::toKey(address_t address)
+{
+    return {static_cast<quint32>(address.system),
+            static_cast<quint32>(address.group),
+            static_cast<quint32>(address.point)};
+}
+
+void Gateway::connectConsumer()
+{
+    const auto consumer = otpConsumer->consumer().get();
+
+    connect(consumer, &Consumer::newPoint, context,
+            [this](cid_t, system_t system, group_t group, point_t point) {
+                if (system == config.sourceSystem) addPoint(address_t(system, group, point));
+            }, Qt::DirectConnection);
+    connect(consumer, &Consumer::updatedPoint, context,
+            [this](cid_t, system_t system, group_t group, point_t point) {
+                if (system == config.sourceSystem) markPoint(address_t(system, group, point));
+            }, Qt::DirectConnection);
+
+    // Downstream sees the point expire too, it returns with its next update
+    connect(consumer, &Consumer::expiredPoint, context,
+            [this](cid_t, system_t system, group_t group, point_t point) {
+                if (system == config.sourceSystem) removePoint(address_t(system, group, point));
+            }, Qt::DirectConnection);
+    connect(consumer, &Consumer::removedPoint, context,
+            [this](cid_t, system_t system, group_t group, point_t point) {
+                // Removed from one source, others may still have it
+                if (system == config.sourceSystem && !otpConsumer->consumer()->getPoints(system, group).contains(point))
+                    removePoint(address_t(system, group, point));
+            }, Qt::DirectConnection);
+}
+
+void Gateway::addPoint(address_t source)
+{
+    const auto target = remap(config, source);
+    if (!target.isValid()) return;
+    const auto key = toKey(source);
+    if (!targets.insert(key).second) return;
+
+    // Added to the producer with the next batch, a wait for the producer thread per point would hold up receiving
+    if (targetGroups.insert(static_cast<quint32>(target.group)).second)
+        addedGroups.insert(static_cast<quint32>(target.group));
+    if (!removedPoints.erase(toKey(target)))
+        addedPoints.insert(toKey(target));
+    named.insert(key);
+    if (resampler)
+    {
+        const auto slot = resampler->addPoint();
+        if (deadReckoning)
+        {
+            // Added and removed together, so both hand out the same slots
+            const auto reckoningSlot = deadReckoning->addPoint();
+            Q_ASSERT(reckoningSlot == slot);
+            Q_UNUSED(reckoningSlot);
+        }
+        slots[key] = slot;
+        slotTargets.resize(static_cast<size_t>(resampler->getSlotCount()));
+        slotTargets[static_cast<size_t>(slot)] = target;
+    }
+    ++pointCount;
+    markPoint(source);
+}
+
+void Gateway::removePoint(address_t source)
+{
+    const auto key = toKey(source);
+    if (!targets.erase(key)) return;
+    named.erase(key);
+    pending.erase(key);
+    const auto filterSlot = filterSlots.find(key);
+    if (filterSlot != filterSlots.end())
+    {
+        filterSlot->second.first->removePoint(filterSlot->second.second);
+        filterSlots.erase(filterSlot);
+    }
+    if (resampler)
+    {
+        const auto slot = slots.find(key);
+        resampler->removePoint(slot->second);
+        if (deadReckoning) deadReckoning->removePoint(slot->second);
+        slotTargets[static_cast<size_t>(slot->second)] = address_t();
+        slots.erase(slot);
+    }
+    // Never sent yet, or removed with the next batch
+    const auto target = toKey(remap(config, source));
+    if (!addedPoints.erase(target))
+        removedPoints.insert(target);
+    if (!batchTimer->isActive())
+        batchTimer->start();
+    --pointCount;
+}
+
+void Gateway::markPoint(address_t source)
+{
+    const auto key = toKey(source);
+    if (!targets.count(key))
+        return addPoint(source);
+
+    if (pending.empty())
+        pendingSince = Metrics::now();
+    pending.insert(key);
+    if (!batchTimer->isActive())
+        batchTimer->start();
+}
+
+void Gateway::sendBatch()
+{
+    const auto structure = !addedGroups.empty() || !addedPoints.empty() || !removedPoints.empty();
+    if (pending.empty() && !structure) return;
+    auto &consumer = *otpConsumer->consumer();
+
+    // Gathered into the arrays kept from the last batch, clearing keeps their capacity
+    batchAddresses.clear();
+    for (auto *vectors : moduleVectors())
+        for (auto &values : *vectors)
+            values.clear();
+
+    for (const auto &[system, group, point] : pending)
+    {
+        const address_t source(system_t(system), group_t(group), point_t(point));
+        batchAddresses.push_back(source);
+        for (auto axis = axis_t::first; axis < axis_t::count; ++axis)
+        {
+            const auto positionValue = consumer.getPosition(source, axis);
+            const auto toMicrometers = positionValue.scale == PositionModule_t::scale_e::mm ? 1000.0 : 1.0;
+            position[axis].push_back(static_cast<double>(positionValue.value) * toMicrometers);
+            positionVelocity[axis].push_back(static_cast<double>(consumer.getPositionVelocity(source, axis).value));
+            positionAcceleration[axis].push_back(static_cast<double>(consumer.getPositionAcceleration(source, axis).value));
+            rotation[axis].push_back(static_cast<double>(consumer.getRotation(source, axis).value));
+            rotationVelocity[axis].push_back(static_cast<double>(consumer.getRotationVelocity(source, axis).value));
+            rotationAcceleration[axis].push_back(static_cast<double>(consumer.getRotationAcceleration(source, axis).value));
+            scale[axis].push_back(static_cast<double>(consumer.getScale(source, axis).value));
+        }
+    }
+
+    filterBatch();
+    transformBatch();
+
+    const auto vectors = moduleVectors();
+    ProducerTransaction transaction(otpProducer);
+    if (resampler)
+    {
+        // Only stored, sendResampled() sends them
+        const auto now = Metrics::now();
+        for (size_t i = 0; i < batchAddresses.size(); ++i)
+        {
+            const auto slot = slots.at(toKey(batchAddresses[i]));
+            resampler->beginSample(slot, now);
+            int channel = 0;
+            for (const auto *values : vectors)
+                for (auto axis = axis_t::first; axis < axis_t::count; ++axis)
+                    resampler->setValue(channel++, slot, (*values)[axis][i]);
+
+            if (deadReckoning)
+            {
+                DeadReckoning::vector_t sample[3];
+                for (auto axis = axis_t::first; axis < axis_t::count; ++axis)
+                {
+                    sample[0][axis] = position[axis][i];
+                    sample[1][axis] = positionVelocity[axis][i];
+                    sample[2][axis] = positionAcceleration[axis][i];
+                }
+                deadReckoning->setSample(slot, now, sample[0], sample[1], sample[2]);
+            }
+        }
+    } else {
+        for (size_t i = 0; i < batchAddresses.size(); ++i)
+        {
+            const auto target = remap(config, batchAddresses[i]);
+            for (size_t module = 0; module < Modules.size(); ++module)
+                for (auto axis = axis_t::first; axis < axis_t::count; ++axis)
+                    transaction.setValue(target, axis, Modules[module], std::llround((*vectors[module])[axis][i]));
+        }
+    }
+    for (const auto &source : batchAddresses)
+        if (named.erase(toKey(source)))
+            transaction.setName(remap(config, source), consumer.getPointName(source));
+
+    const auto record = !resampler && !pending.empty();
+    const auto since = pendingSince;
+    if (structure)
+    {
+        // New points go out with their values, never with defaults
+        otpProducer->call([&](Producer &producer) {
+            for (const auto &[system, group, point] : removedPoints)
+                producer.removeLocalPoint(address_t(system_t(system), group_t(group), point_t(point)));
+            for (const auto group : addedGroups)
+                producer.addLocalGroup(config.targetSystem, group_t(group));
+            for (const auto &[system, group, point] : addedPoints)
+                producer.addLocalPoint(system_t(system), group_t(group), point_t(point), config.priority);
+            transaction.apply(producer);
+            if (record) latency.record(Metrics::microsecondsSince(since));
+        });
+        addedGroups.clear();
+        addedPoints.clear();
+        removedPoints.clear();
+    } else {
+        transaction.commit();
+
+        // Queued behind the values, so recorded as they are applied
+        if (record)
+            otpProducer->enqueue([since, &histogram = latency](Producer &) {
+                histogram.record(Metrics::microsecondsSince(since));
+            });
+    }
+
+    pending.clear();
+    ++batchCount;
+}
+
+void Gateway::filterBatch()
+{
+    const auto now = Metrics::now();
+    filtering.clear();
+    for (size_t i = 0; i < batchAddresses.size(); ++i)
+    {
+        const auto &source = batchAddresses[i];
+        const auto key = toKey(source);
+        auto filterSlot = filterSlots.find(key);
+
+        // Following the consumer's filter as it is set, changed and cleared
+        MotionFilter::mode_t mode;
+        MotionFilter::parameters_t parameters;
+        const auto filtered = otpConsumer->getGroupFilter(source.system, source.group, mode, parameters);
+        auto &filter = motionFilters[filtered ? mode : 0];
+        if (filterSlot != filterSlots.end() && (!filtered || filterSlot->second.first != filter.get()))
+        {
+            filterSlot->second.first->removePoint(filterSlot->second.second);
+            filterSlots.erase(filterSlot);
+            filterSlot = filterSlots.end();
+        }
+        if (!filtered) continue;
+
+        if (!filter)
+            filter = ConsumerThread::createMotionFilter(mode);
+        if (filterSlot == filterSlots.end())
+            filterSlot = filterSlots.insert({key, {filter.get(), filter->addPoint(parameters)}}).first;
+        else
+            filter->setParameters(filterSlot->second.second, parameters);
+
+        const auto [motionFilter, slot] = filterSlot->second;
+        motionFilter->beginSample(slot, now);
+        for (auto axis = axis_t::first; axis < axis_t::count; ++axis)
+        {
+            motionFilter->setValue(axis, slot, position[axis][i]);
+            motionFilter->setValue(axis_t::count + axis, slot, rotation[axis][i]);
+        }
+        filtering.push_back({i, filterSlot->second});
+    }
+    if (filtering.empty()) return;
+
+    for (const auto &filter : motionFilters)
+        if (filter) filter->filter();
+
+    for (const auto &[i, filterSlot] : filtering)
+    {
+        const auto &[motionFilter, slot] = filterSlot;
+        for (auto axis = axis_t::first; axis < axis_t::count; ++axis)
+        {
+            position[axis][i] = motionFilter->getValue(axis, slot);
+            rotation[axis][i] = motionFilter->getValue(axis_t::count + axis, slot);
+        }
+    }
+}
+
+void Gateway::sendResampled()
+{
+    const auto now = Metrics::now();
+    resampler->sample(now, resampled);
+
+    // Position is the first module, so its axes are the first channels
+    if (deadReckoning)
+    {
+        deadReckoning->predict(now, reckoned);
+        for (auto axis = axis_t::first; axis < axis_t::count; ++axis)
+            resampled[axis].swap(reckoned[axis]);
+    }
+
+    ProducerTransaction transaction(otpProducer);
+    for (size_t slot = 0; slot < slotTargets.size(); ++slot)
+    {
+        if (!resampler->isActive(static_cast<int>(slot))) continue;
+        size_t channel = 0;
+        for (const auto moduleValue : Modules)
+            for (auto axis = axis_t::first; axis < axis_t::count; ++axis)
+                transaction.setValue(slotTargets[slot], axis, moduleValue, std::llround(resampled[channel++][slot]));
+    }
+    transaction.commit();
+}
+
+std::array<Gateway::vectors_t*, 7> Gateway::moduleVectors()
+{
+    return {&position, &positionVelocity, &positionAcceleration,
+            &rotation, &rotationVelocity, &rotationAcceleration, &scale};
+}
+
+void Gateway::transformBatch()
+{
+    const auto count = batchAddresses.size();
+
+    // Plain loops over contiguous arrays, left for the compiler to vectorise
+    const auto multiply = [count](const std::array<std::array<double, 3>, 3> &matrix,
+                                  vectors_t &vectors,
+                                  const std::array<double, axis_t::count> &offset) {
+        auto *x = vectors[axis_t::X].data();
+        auto *y = vectors[axis_t::Y].data();
+        auto *z = vectors[axis_t::Z].data();
+        for (size_t i = 0; i < count; ++i)
+        {
+            const auto px = x[i], py = y[i], pz = z[i];
+            x[i] = matrix[0][0] * px + matrix[0][1] * py + matrix[0][2] * pz + offset[0];
+            y[i] = matrix[1][0] * px + matrix[1][1] * py + matrix[1][2] * pz + offset[1];
+            z[i] = matrix[2][0] * px + matrix[2][1] * py + matrix[2][2] * pz + offset[2];
+        }
+    };
+    multiply(linearMatrix, position, config.transform.translation);
+    multiply(linearMatrix, positionVelocity, NoOffset);
+    multiply(linearMatrix, positionAcceleration, NoOffset);
+    multiply(rotationMatrix, rotationVelocity, NoOffset);
+    multiply(rotationMatrix, rotationAcceleration, NoOffset);
+
+    for (auto axis = axis_t::first; axis < axis_t::count; ++axis)
+    {
+        const auto factor = config.transform.scale[axis];
+        auto *values = scale[axis].data();
+        for (size_t i = 0; i < count; ++i)
+            values[i] *= factor;
+    }
+
+    // The point's rotation, followed by the transform's
+    const auto [rw, rx, ry, rz] = rotationQuaternion;
+    auto *outX = rotation[axis_t::X].data();
+    auto *outY = rotation[axis_t::Y].data();
+    auto *outZ = rotation[axis_t::Z].data();
+    for (size_t i = 0; i < count; ++i)
+    {
+        const auto [pw, px, py, pz] = toQuaternion(
+                    outX[i] * RotationToRadians, outY[i] * RotationToRadians, outZ[i] * RotationToRadians);
+        const auto w = rw * pw - rx * px - ry * py - rz * pz;
+        const auto x = rw * px + rx * pw + ry * pz - rz * py;
+        const auto y = rw * py - rx * pz + ry * pw + rz * px;
+        const auto z = rw * pz + rx * py - ry * px + rz * pw;
+
+        // Back to X, Y, Z, the transaction wraps these into range
+        outX[i] = std::atan2(2 * (w * x + y * z), 1 - 2 * (x * x + y * y)) * RadiansToRotation;
+        outY[i] = std::asin(std::clamp(2 * (w * y - z * x), -1.0, 1.0)) * RadiansToRotation;
+        outZ[i] = std::atan2(2 * (w * z + x * y), 1 - 2 * (y * y + z * z)) * RadiansToRotation;
+    }
+}
@@ -0,0 +1,173 @@
+/*
+    OTPView
+    A QT Frontend for E1.59  (Entertainment  Technology  Object  Transform  Protocol  (OTP))
+    Copyright (C) 2026  Marcus Birkin
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#ifndef GATEWAY_H
+#define GATEWAY_H
+
+#include <QNetworkInterface>
+#include <QObject>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <set>
+#include <tuple>
+#include <vector>
+#include "OTPLib.hpp"
+#include "consumerthread.h"
+#include "deadreckoning.h"
+#include "metrics.h"
+#include "producerthread.h"
+#include "resampler.h"
+
+class QTimer;
+
+/*
+ * Republishes a system received by the consumer as another system, through its own producer
+ *
+ * Every point of the source system is renumbered, into the target system with its group
+ * and point offset, and passed through an affine transform: scaled, rotated about the origin,
+ * then translated. Positions take all three, their velocities and accelerations are scaled
+ * and rotated, rotations and their velocities and accelerations are only rotated,
+ * and scale is multiplied by the transform's scale.
+ *
+ * Runs on the consumer's worker thread as updates arrive. The points updated by a message are
+ * gathered until its signals are done, transformed together as contiguous arrays and queued
+ * to the producer, which applies them on its next pacing tick. Points added and removed meanwhile
+ * are applied with them, in one call to the producer thread. The time from the message arriving
+ * until its values are applied is measured into "Gateway <source> to <target> receive to apply latency",
+ * OTPLib then sends them on its own transmit timer, which isn't included.
+ *
+ * Points of groups the consumer filters are passed through the same motion filter first,
+ * once per sample rather than per snapshot, before being transformed.
+ *
+ * When resampling, transformed values go to a Resampler instead, sampled and sent once
+ * every transform period, so the output rate no longer follows the input's.
+ * Dead reckoned output holds every value but position, which is moved on from the last sample
+ * by its transformed velocity and acceleration
+ */
+class Gateway : public QObject
+{
+    Q_OBJECT
+public:
+    static constexpr std::chrono::milliseconds ExtrapolationLimit{100};
+
+    typedef struct transform_s
+    {
+        std::array<double, OTP::axis_t::count> scale{{1.0, 1.0, 1.0}};
+        std::array<double, OTP::axis_t::count> rotation{}; // Degrees, X, Y then Z about the fixed axes
+        std::array<double, OTP::axis_t::count> translation{}; // Micrometers
+    } transform_t;
+
+    typedef struct config_s
+    {
+        OTP::system_t sourceSystem;
+        OTP::system_t targetSystem;
+        int groupOffset = 0;
+        int pointOffset = 0;
+        transform_t transform;
+        OTP::priority_t priority;
+        QNetworkInterface iface;
+        QAbstractSocket::NetworkLayerProtocol transport = QAbstractSocket::IPv4Protocol;
+        OTP::cid_t CID;
+        QString name;
+        std::chrono::milliseconds transformRate = OTP::OTP_TRANSFORM_TIMING_MAX;
+        bool resample = false;
+        Resampler::mode_t resampleMode = Resampler::Linear;
+        bool deadReckoning = false; // When resampling
+    } config_t;
+
+    explicit Gateway(std::shared_ptr<ConsumerThread> otpConsumer, const config_t &config, QObject *parent = nullptr);
+    ~Gateway();
+
+    // Target address of a source point, invalid when the offsets take it out of range
+    static OTP::address_t remap(const config_t &config, OTP::address_t source);
+
+    int getPointCount() const { return pointCount.load(); }
+    quint64 getBatchCount() const { return batchCount.load(); }
+    const Histogram &getLatency() const { return latency; } // Receive to apply, not recorded when resampling
+    bool isResampling() const { return config.resample; }
+
+private:
+    typedef std::tuple<quint32, quint32, quint32> addressKey_t;
+    static addressKey_t toKey(OTP::address_t address);
+
+    // One array per axis
+    typedef std::array<std::vector<double>, OTP::axis_t::count> vectors_t;
+
+    // Consumer thread
+    void connectConsumer();
+    void addPoint(OTP::address_t source);
+    void removePoint(OTP::address_t source);
+    void markPoint(OTP::address_t source);
+    void sendBatch();
+    void filterBatch();
+    void transformBatch();
+    void sendResampled();
+    std::array<vectors_t*, 7> moduleVectors();
+
+    std::shared_ptr<ConsumerThread> otpConsumer;
+    std::shared_ptr<ProducerThread> otpProducer;
+    const config_t config;
+    bool addedLocalSystem = false;
+
+    // Transform, as a matrix and quaternion
+    std::array<std::array<double, 3>, 3> rotationMatrix;
+    std::array<std::array<double, 3>, 3> linearMatrix; // Rotation times scale
+    std::array<double, 4> rotationQuaternion; // W, X, Y, Z
+
+    QObject *context; // Lives on the consumer's worker thread
+
+    // Consumer thread only
+    QTimer *batchTimer = nullptr;
+    std::set<addressKey_t> targets; // Source addresses being republished
+    std::set<quint32> targetGroups;
+    std::set<addressKey_t> named; // Source addresses whose target still needs its name
+    std::set<addressKey_t> pending;
+    qint64 pendingSince = 0;
+    std::set<quint32> addedGroups; // Target groups and addresses, for the producer with the next batch
+    std::set<addressKey_t> addedPoints;
+    std::set<addressKey_t> removedPoints;
+
+    // Consumer thread only, when resampling
+    std::unique_ptr<Resampler> resampler;
+    QTimer *outputTimer = nullptr;
+    std::map<addressKey_t, int> slots;
+    std::vector<OTP::address_t> slotTargets;
+    std::vector<std::vector<double>> resampled; // Per channel, module then axis
+    std::unique_ptr<DeadReckoning> deadReckoning; // Same slots as the resampler
+    std::array<std::vector<double>, DeadReckoning::Axes> reckoned;
+
+    // Consumer thread only, filtering as the consumer's group filters
+    std::array<std::unique_ptr<MotionFilter>, 2> motionFilters; // By mode, made on first use
+    std::map<addressKey_t, std::pair<MotionFilter*, int>> filterSlots;
+    std::vector<std::pair<size_t, std::pair<MotionFilter*, int>>> filtering; // Batch index, filter slot
+
+    // Consumer thread only, reused by every batch
+    std::vector<OTP::address_t> batchAddresses;
+    vectors_t position, positionVelocity, positionAcceleration;
+    vectors_t rotation, rotationVelocity, rotationAcceleration;
+    vectors_t scale;
+
+    std::atomic<int> pointCount{0};
+    std::atomic<quint64> batchCount{0};
+    Histogram &latency;
+};
+
+#endif // GATEWAY_H
@@ -0,0 +1,161 @@
+/*
+    OTPView
+    A QT Frontend for E1.59  (Entertainment  Technology  Object  Transform  Protocol  (OTP))
+    Copyright (C) 2026  Marcus Birkin
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "gatewaydialog.h"
+#include "ui_gatewaydialog.h"
+#include "settings.h"
+#include <limits>
+
+using namespace OTP;
+
+namespace {
+    const auto componentSettingsGroup_GATEWAY = QStringLiteral("GATEWAY");
+    constexpr int ResamplingOff = 0;
+    constexpr int ResamplingDeadReckoning = 4;
+}
+
+GatewayDialog::GatewayDialog(std::shared_ptr<ConsumerThread> otpConsumer, QWidget *parent) :
+    QDialog(parent),
+    ui(new Ui::GatewayDialog),
+    otpConsumer(otpConsumer)
+{
+    ui->setupUi(this);
+    setWindowFlag(Qt::WindowContextHelpButtonHint, false);
+
+    for (auto *spinBox : {ui->sbSourceSystem, ui->sbTargetSystem})
+        spinBox->setRange(static_cast<int>(system_t::getMin()), static_cast<int>(system_t::getMax()));
+    ui->sbTargetSystem->setValue(ui->sbSourceSystem->value() + 1);
+    ui->sbGroupOffset->setRange(-static_cast<int>(group_t::getMax()), static_cast<int>(group_t::getMax()));
+    ui->sbPointOffset->setRange(std::numeric_limits<int>::min(), std::numeric_limits<int>::max());
+    ui->sbPriority->setRange(static_cast<int>(RANGES::Priority.getMin()), static_cast<int>(RANGES::Priority.getMax()));
+    ui->sbPriority->setValue(static_cast<int>(OTP::priority_t()));
+    ui->sbOutputInterval->setRange(static_cast<int>(OTP_TRANSFORM_TIMING_MIN.count()),
+                                   static_cast<int>(OTP_TRANSFORM_TIMING_MAX.count()));
+    ui->sbOutputInterval->setValue(static_cast<int>(Settings::getInstance().getTransformMessageRate().count()));
+
+    // Only resampled output has its own interval, otherwise it follows the input
+    const auto checkResampling = [this](int index) {
+        ui->sbOutputInterval->setEnabled(index != ResamplingOff);
+    };
+    connect<void(QComboBox::*)(int)>(ui->cbResampling, &QComboBox::currentIndexChanged, this, checkResampling);
+    checkResampling(ui->cbResampling->currentIndex());
+
+    // Refuses to feed a system back into itself
+    const auto checkSystems = [this]() {
+        ui->pbStart->setEnabled(!gateway && ui->sbSourceSystem->value() != ui->sbTargetSystem->value());
+    };
+    connect<void(QSpinBox::*)(int)>(ui->sbSourceSystem, &QSpinBox::valueChanged, this, checkSystems);
+    connect<void(QSpinBox::*)(int)>(ui->sbTargetSystem, &QSpinBox::valueChanged, this, checkSystems);
+
+    statusTimer.setInterval(std::chrono::seconds(1));
+    connect(&statusTimer, &QTimer::timeout, this, &GatewayDialog::updateStatus);
+    setRunning(false);
+}
+
+GatewayDialog::~GatewayDialog()
+{
+    delete ui;
+}
+
+void GatewayDialog::on_pbStart_clicked()
+{
+    Gateway::config_t config;
+    config.sourceSystem = static_cast<system_t>(ui->sbSourceSystem->value());
+    config.targetSystem = static_cast<system_t>(ui->sbTargetSystem->value());
+    config.groupOffset = ui->sbGroupOffset->value();
+    config.pointOffset = ui->sbPointOffset->value();
+    config.priority = static_cast<priority_t>(ui->sbPriority->value());
+
+    // Millimeters and degrees in the dialog
+    const QDoubleSpinBox *translation[] = {ui->dsbTranslationX, ui->dsbTranslationY, ui->dsbTranslationZ};
+    const QDoubleSpinBox *rotation[] = {ui->dsbRotationX, ui->dsbRotationY, ui->dsbRotationZ};
+    const QDoubleSpinBox *scale[] = {ui->dsbScaleX, ui->dsbScaleY, ui->dsbScaleZ};
+    for (auto axis = axis_t::first; axis < axis_t::count; ++axis)
+    {
+        config.transform.translation[axis] = translation[axis]->value() * 1000;
+        config.transform.rotation[axis] = rotation[axis]->value();
+        config.transform.scale[axis] = scale[axis]->value();
+    }
+
+    const auto details = Settings::getInstance().getComponentSettings(componentSettingsGroup_GATEWAY);
+    Settings::getInstance().setComponentSettings(componentSettingsGroup_GATEWAY, details);
+    config.iface = Settings::getInstance().getNetworkInterface();
+    config.transport = Settings::getInstance().getNetworkTransport();
+    config.CID = details.CID;
+    config.name = details.Name;
+    config.transformRate = Settings::getInstance().getTransformMessageRate();
+
+    // Listed as off, each Resampler::mode_t, then dead reckoning
+    const auto resampling = ui->cbResampling->currentIndex();
+    config.resample = resampling != ResamplingOff;
+    if (config.resample)
+    {
+        config.deadReckoning = resampling == ResamplingDeadReckoning;
+        config.resampleMode = config.deadReckoning
+                ? Resampler::Hold : static_cast<Resampler::mode_t>(resampling - 1);
+        config.transformRate = std::chrono::milliseconds(ui->sbOutputInterval->value());
+    }
+
+    gateway = std::make_unique<Gateway>(otpConsumer, config);
+    setRunning(true);
+}
+
+void GatewayDialog::on_pbStop_clicked()
+{
+    gateway.reset();
+    setRunning(false);
+}
+
+void GatewayDialog::setRunning(bool value)
+{
+    ui->pbStart->setEnabled(!value && ui->sbSourceSystem->value() != ui->sbTargetSystem->value());
+    ui->pbStop->setEnabled(value);
+    ui->gbAddress->setEnabled(!value);
+    ui->gbTransform->setEnabled(!value);
+    ui->gbOutput->setEnabled(!value);
+    if (value)
+        statusTimer.start();
+    else
+        statusTimer.stop();
+    updateStatus();
+}
+
+void GatewayDialog::updateStatus()
+{
+    if (!gateway)
+    {
+        ui->lblStatus->setText(tr("Stopped"));
+        return;
+    }
+
+    if (gateway->isResampling())
+    {
+        ui->lblStatus->setText(tr("%1 points, %2 batches, resampled every %3 ms")
+                               .arg(gateway->getPointCount())
+                               .arg(gateway->getBatchCount())
+                               .arg(ui->sbOutputInterval->value()));
+        return;
+    }
+
+    const auto summary = gateway->getLatency().summary();
+    ui->lblStatus->setText(tr("%1 points, %2 batches, receive to apply latency p50 %3 µs, p99 %4 µs")
+                           .arg(gateway->getPointCount())
+                           .arg(gateway->getBatchCount())
+                           .arg(summary.p50)
+                           .arg(summary.p99));
+}
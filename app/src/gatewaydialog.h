@@ -0,0 +1,57 @@
+/*
+    OTPView
+    A QT Frontend for E1.59  (Entertainment  Technology  Object  Transform  Protocol  (OTP))
+    Copyright (C) 2026  Marcus Birkin
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#ifndef GATEWAYDIALOG_H
+#define GATEWAYDIALOG_H
+
+#include <QDialog>
+#include <QTimer>
+#include <memory>
+#include "consumerthread.h"
+#include "gateway.h"
+
+namespace Ui {
+class GatewayDialog;
+}
+
+/*
+ * Republishes a system received by the consumer as another, see Gateway
+ */
+class GatewayDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    explicit GatewayDialog(std::shared_ptr<ConsumerThread> otpConsumer, QWidget *parent = nullptr);
+    ~GatewayDialog();
+
+private slots:
+    void on_pbStart_clicked();
+    void on_pbStop_clicked();
+
+private:
+    Ui::GatewayDialog *ui;
+    void setRunning(bool value);
+    void updateStatus();
+
+    std::shared_ptr<ConsumerThread> otpConsumer;
+    std::unique_ptr<Gateway> gateway;
+    QTimer statusTimer;
+};
+
+#endif // GATEWAYDIALOG_H
@@ -20,12 +20,13 @@
 #include "ui_groupwindow.h"
 #include "producerwindow.h"
 #include "pointselectiondialog.h"
-#include "widgets/spacialspinbox.h"
+#include "producertransaction.h"
 #include "models/pointstablemodel.h"
+#include "models/pointdetailsmodel.h"
+#include "widgets/pointdetailsdelegate.h"
 #include "widgets/systemspinbox.h"
 #include "widgets/groupspinbox.h"
 #include "widgets/pointspinbox.h"
-#include "widgets/scalespinbox.h"
 #include "widgets/priorityspinbox.h"
 #include <QSettings>
 #include <cstring>
@@ -33,7 +34,7 @@
 using namespace OTP;
 
 GroupWindow::GroupWindow(
-        std::shared_ptr<class OTP::Producer> otpProducer,
+        std::shared_ptr<ProducerThread> otpProducer,
         OTP::system_t system,
         OTP::group_t group,
         QWidget *parent) :
@@ -65,18 +66,17 @@ GroupWindow::GroupWindow(
             on_tablePoints_itemSelectionChanged();
         }
     });
-
-    // Producer Points Details
-    on_tablePoints_itemSelectionChanged();
-    connect(ui->tablePoints->selectionModel(), &QItemSelectionModel::selectionChanged,
-             this, &GroupWindow::on_tablePoints_itemSelectionChanged);
+    connect(ui->tablePoints->model(), &QAbstractItemModel::rowsRemoved,
+            this, &GroupWindow::on_tablePoints_itemSelectionChanged);
+    connect(ui->tablePoints->model(), &QAbstractItemModel::modelReset,
+            this, &GroupWindow::on_tablePoints_itemSelectionChanged);
 
     // - Name
     ui->leName->setMaxLength(name_t::maxSize());
-    connect(otpProducer.get(), &Producer::updatedLocalPointName, this, [=](address_t address) {
+    connect(otpProducer.get(), &ProducerThread::updatedLocalPointName, this, [=](address_t address) {
         const auto &selectedAddress = getSelectedAddress();
         if (selectedAddress.count() == 1 && selectedAddress.first() == address) {
-            ui->leName->setText(otpProducer->getLocalPointName(address));
+            ui->leName->setText(otpProducer->read()->getLocalPointName(address));
         }
     });
 
@@ -86,67 +86,44 @@ GroupWindow::GroupWindow(
 
     // - Parent
     ui->cbParentDisable->setChecked(true);
-    connect(otpProducer.get(), &Producer::updatedReferenceFrame, this, [=](address_t address) {
+    connect(otpProducer.get(), &ProducerThread::updatedReferenceFrame, this, [=](address_t address) {
         const auto &selectedAddress = getSelectedAddress();
         if (selectedAddress.count() == 1 && selectedAddress.first() == address) {
-            auto parent = otpProducer->getLocalReferenceFrame(address);
+            auto parent = otpProducer->read()->getLocalReferenceFrame(address);
             ui->sbParentSystem->setValue(parent.value.system);
             ui->sbParentGroup->setValue(parent.value.group);
             ui->sbParentPoint->setValue(parent.value.point);
         }
     });
 
-    // - Scale
-    ui->tableScale->setColumnCount(ScaleHeaders.count());
-    ui->tableScale->setHorizontalHeaderLabels(ScaleHeaders);
-    ui->tableScale->setRowCount(Axes.count());
-    ui->tableScale->setVerticalHeaderLabels(Axes);
-    ui->tableScale->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
-    ui->tableScale->verticalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
-    for (auto axis = axis_t::first; axis < axis_t::count; axis++)
+    // - Scale, Position and Rotation
+    // Cells are only given an editor widget while being edited
+    auto delegate = new PointDetailsDelegate(otpProducer, this);
+    scaleModel = new PointDetailsModel(otpProducer, PointDetailsModel::Scale, this);
+    positionModel = new PointDetailsModel(otpProducer, PointDetailsModel::Position, this);
+    rotationModel = new PointDetailsModel(otpProducer, PointDetailsModel::Rotation, this);
+    const std::pair<QTableView*, PointDetailsModel*> detailTables[] = {
+        {ui->tableScale, scaleModel},
+        {ui->tablePointsPosition, positionModel},
+        {ui->tablePointsRotation, rotationModel}};
+    for (const auto &[table, model] : detailTables)
     {
-        auto scaleWidget = new ScaleSpinBox(otpProducer, axis, ui->tableScale);
-        ui->tableScale->setCellWidget(axis, ScaleHeaders_e::Scale, scaleWidget);
+        table->setModel(model);
+        table->setItemDelegate(delegate);
+        table->setSelectionBehavior(QAbstractItemView::SelectItems);
+        table->setSelectionMode(QAbstractItemView::SingleSelection);
+        table->setEditTriggers(
+                    QAbstractItemView::DoubleClicked
+                    | QAbstractItemView::EditKeyPressed
+                    | QAbstractItemView::AnyKeyPressed);
+        table->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+        table->verticalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
     }
 
-    // - Position
-    ui->tablePointsPosition->setColumnCount(PointsDetailsHeaders.count());
-    ui->tablePointsPosition->setHorizontalHeaderLabels(PointsDetailsHeaders);
-    ui->tablePointsPosition->setRowCount(Axes.count());
-    ui->tablePointsPosition->setVerticalHeaderLabels(Axes);
-    ui->tablePointsPosition->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
-    ui->tablePointsPosition->verticalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
-    for (auto axis = axis_t::first; axis < axis_t::count; axis++)
-    {
-        auto valueWidget = new SpacialSpinBox(otpProducer, axis, MODULES::STANDARD::VALUES::POSITION, ui->tablePointsPosition);
-        ui->tablePointsPosition->setCellWidget(axis, PointsDetailsHeaders_e::Value, valueWidget);
-
-        auto velocityWidget = new SpacialSpinBox(otpProducer, axis, MODULES::STANDARD::VALUES::POSITION_VELOCITY, ui->tablePointsPosition);
-        ui->tablePointsPosition->setCellWidget(axis, PointsDetailsHeaders_e::Velocity, velocityWidget);
-
-        auto accelerationWidget = new SpacialSpinBox(otpProducer, axis, MODULES::STANDARD::VALUES::POSITION_ACCELERATION, ui->tablePointsPosition);
-        ui->tablePointsPosition->setCellWidget(axis, PointsDetailsHeaders_e::Acceleration, accelerationWidget);
-    }
-
-    // - Rotation
-    ui->tablePointsRotation->setColumnCount(PointsDetailsHeaders.count());
-    ui->tablePointsRotation->setHorizontalHeaderLabels(PointsDetailsHeaders);
-    ui->tablePointsRotation->setRowCount(Axes.count());
-    ui->tablePointsRotation->setVerticalHeaderLabels(Axes);
-    ui->tablePointsRotation->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
-    ui->tablePointsRotation->verticalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
-    ui->tablePointsRotation->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
-    for (auto axis = axis_t::first; axis < axis_t::count; axis++)
-    {
-        auto valueWidget = new SpacialSpinBox(otpProducer, axis, MODULES::STANDARD::VALUES::ROTATION, ui->tablePointsPosition);
-        ui->tablePointsRotation->setCellWidget(axis, PointsDetailsHeaders_e::Value, valueWidget);
-
-        auto velocityWidget = new SpacialSpinBox(otpProducer, axis, MODULES::STANDARD::VALUES::ROTATION_VELOCITY, ui->tablePointsPosition);
-        ui->tablePointsRotation->setCellWidget(axis, PointsDetailsHeaders_e::Velocity, velocityWidget);
-
-        auto accelerationWidget = new SpacialSpinBox(otpProducer, axis, MODULES::STANDARD::VALUES::ROTATION_ACCELERATION, ui->tablePointsPosition);
-        ui->tablePointsRotation->setCellWidget(axis, PointsDetailsHeaders_e::Acceleration, accelerationWidget);
-    }
+    // Producer Points Details
+    on_tablePoints_itemSelectionChanged();
+    connect(ui->tablePoints->selectionModel(), &QItemSelectionModel::selectionChanged,
+             this, &GroupWindow::on_tablePoints_itemSelectionChanged);
 }
 
 GroupWindow::~GroupWindow()
@@ -201,7 +178,7 @@ void GroupWindow::setSystem(OTP::system_t newSystem)
 
     otpProducer->addLocalSystem(newSystem);
     otpProducer->addLocalGroup(newSystem, group);
-    auto pointsList = otpProducer->getLocalPoints(oldSystem, group);
+    auto pointsList = otpProducer->read()->getLocalPoints(oldSystem, group);
     for (const auto &point : pointsList) {
         address_t oldAddress = {oldSystem, group, point};
         address_t newAddress = {newSystem, group, point};
@@ -227,7 +204,7 @@ QList<address_t> GroupWindow::getSelectedAddress()
 
 void GroupWindow::on_pbAddPoint_clicked()
 {
-    auto dialog = new PointSelectionDialog(otpProducer->getLocalPoints(system, group), this);
+    auto dialog = new PointSelectionDialog(otpProducer->read()->getLocalPoints(system, group), this);
     if (dialog->exec() == QDialog::Rejected)
         return;
 
@@ -242,23 +219,34 @@ void GroupWindow::on_pbRemovePoint_clicked()
     const auto &selectedAddress = getSelectedAddress();
     for (const auto &address : selectedAddress)
         otpProducer->removeLocalPoint(address);
-
-    on_tablePoints_itemSelectionChanged();
 }
 
 void GroupWindow::on_tablePoints_itemSelectionChanged()
 {
     const auto &selectedAddress = getSelectedAddress();
 
-    // Only show details for a single point
-    ui->frameDetails->setDisabled(selectedAddress.count() != 1);
+    // Scale, Position and Rotation offset all selected points,
+    // the remaining details are only shown for a single point
+    ui->frameDetails->setDisabled(selectedAddress.isEmpty());
+    for (const auto &model : {scaleModel, positionModel, rotationModel})
+        model->setAddresses(selectedAddress);
+    for (const auto &widget : std::initializer_list<QWidget*>{ui->gbName, ui->gbPriority, ui->gbParent})
+        widget->setEnabled(selectedAddress.count() == 1);
     if (selectedAddress.count() != 1) return;
 
     // Address
     auto address = selectedAddress.first();
 
+    // Changing the selection must only read from the producer,
+    // so keep the editors quiet while they are populated
+    const QSignalBlocker nameBlocker(ui->leName);
+    const QSignalBlocker parentDisableBlocker(ui->cbParentDisable);
+    const QSignalBlocker parentSystemBlocker(ui->sbParentSystem);
+    const QSignalBlocker parentGroupBlocker(ui->sbParentGroup);
+    const QSignalBlocker parentPointBlocker(ui->sbParentPoint);
+
     // - Name
-    ui->leName->setText(otpProducer->getLocalPointName(address));
+    ui->leName->setText(otpProducer->read()->getLocalPointName(address));
 
     // - Priority
     auto priorityWidget = static_cast<PrioritySpinBox*>(ui->gbPriority->layout()->itemAt(0)->widget());
@@ -266,74 +254,36 @@ void GroupWindow::on_tablePoints_itemSelectionChanged()
         priorityWidget->setAddress(address);
 
     // - Reference Frame
-    auto parent = otpProducer->getLocalReferenceFrame(address);
+    auto parent = otpProducer->read()->getLocalReferenceFrame(address);
     ui->cbParentDisable->setChecked(parent.value == address || !parent.value.isValid());
+    setParentWidgetsEnabled(!ui->cbParentDisable->isChecked());
     ui->sbParentSystem->setValue(parent.value.system);
     ui->sbParentGroup->setValue(parent.value.group);
     ui->sbParentPoint->setValue(parent.value.point);
-
-    for (auto axis = axis_t::first; axis < axis_t::count; axis++)
-    {
-        // - Scale
-        {
-            auto scaleWidget = static_cast<ScaleSpinBox*>(ui->tableScale->cellWidget(axis, ScaleHeaders_e::Scale));
-            if (scaleWidget)
-                scaleWidget->setAddress(address);
-        }
-
-        // - Position
-        {
-            auto valueWidget = static_cast<SpacialSpinBox*>(ui->tablePointsPosition->cellWidget(axis, PointsDetailsHeaders_e::Value));
-            if (valueWidget)
-                valueWidget->setAddress(address);
-
-            auto velocityWidget = static_cast<SpacialSpinBox*>(ui->tablePointsPosition->cellWidget(axis, PointsDetailsHeaders_e::Velocity));
-            if (velocityWidget)
-                velocityWidget->setAddress(address);
-
-            auto accelerationWidget = static_cast<SpacialSpinBox*>(ui->tablePointsPosition->cellWidget(axis, PointsDetailsHeaders_e::Acceleration));
-            if (accelerationWidget)
-                accelerationWidget->setAddress(address);
-        }
-
-        // - Rotation
-        {
-            auto valueWidget = static_cast<SpacialSpinBox*>(ui->tablePointsRotation->cellWidget(axis, PointsDetailsHeaders_e::Value));
-            if (valueWidget)
-                valueWidget->setAddress(address);
-
-            auto velocityWidget = static_cast<SpacialSpinBox*>(ui->tablePointsRotation->cellWidget(axis, PointsDetailsHeaders_e::Velocity));
-            if (velocityWidget)
-                velocityWidget->setAddress(address);
-
-            auto accelerationWidget = static_cast<SpacialSpinBox*>(ui->tablePointsRotation->cellWidget(axis, PointsDetailsHeaders_e::Acceleration));
-            if (accelerationWidget)
-                accelerationWidget->setAddress(address);
-        }
-    }
 }
 
 void GroupWindow::on_leName_textChanged(const QString &arg1)
 {
     const auto &selectedAddress = getSelectedAddress();
     if (selectedAddress.count() != 1) return;
-    otpProducer->setLocalPointName(selectedAddress.first(), arg1);
+    ProducerTransaction transaction(otpProducer);
+    transaction.setName(selectedAddress.first(), arg1);
+    transaction.commit();
 }
 
 void GroupWindow::on_sbParent_valueChanged()
 {
     const auto &selectedAddress = getSelectedAddress();
     if (selectedAddress.count() != 1) return;
-    auto referenceFrame = otpProducer->getLocalReferenceFrame(selectedAddress.first());
-    referenceFrame.timestamp = ui->cbParentDisable->isChecked() ? 0 :
-            static_cast<OTP::timestamp_t>(QDateTime::currentDateTime().toMSecsSinceEpoch());
+    ProducerTransaction transaction(otpProducer);
     if (ui->cbParentDisable->isChecked()) {
-        referenceFrame.value = selectedAddress.first();
+        transaction.setReferenceFrame(selectedAddress.first(), selectedAddress.first());
     } else {
-        referenceFrame.value = {ui->sbParentSystem->value(), ui->sbParentGroup->value(), ui->sbParentPoint->value()};
+        transaction.setReferenceFrame(
+                    selectedAddress.first(),
+                    {ui->sbParentSystem->value(), ui->sbParentGroup->value(), ui->sbParentPoint->value()});
     }
-
-    otpProducer->setLocalReferenceFrame(selectedAddress.first(), referenceFrame);
+    transaction.commit();
 }
 
 void GroupWindow::on_sbParentSystem_valueChanged(int arg1)
@@ -355,6 +305,13 @@ void GroupWindow::on_sbParentPoint_valueChanged(int arg1)
 }
 
 void GroupWindow::on_cbParentDisable_stateChanged(int arg1)
+{
+    setParentWidgetsEnabled(arg1 != Qt::CheckState::Checked);
+
+    on_sbParent_valueChanged();
+}
+
+void GroupWindow::setParentWidgetsEnabled(bool enabled)
 {
     // Disable all widgets in Parent groupbox, except the disable checkbox!
     for (int ln = 0; ln < ui->gbParent->layout()->count(); ln++) {
@@ -362,9 +319,7 @@ void GroupWindow::on_cbParentDisable_stateChanged(int arg1)
         for (int wn = 0; wn < layout->count(); wn++) {
             auto widget = layout->itemAt(wn)->widget();
             if (widget && (widget != ui->cbParentDisable))
-                widget->setEnabled(arg1 != Qt::CheckState::Checked);
+                widget->setEnabled(enabled);
         }
     }
-
-    on_sbParent_valueChanged();
 }
@@ -23,6 +23,7 @@
 #include <QMainWindow>
 #include <memory>
 #include "OTPLib.hpp"
+#include "producerthread.h"
 
 namespace Ui {
 class GroupWindow;
@@ -34,12 +35,14 @@ class GroupWindow : public QWidget
 
 public:
     explicit GroupWindow(
-            std::shared_ptr<class OTP::Producer> otpProducer,
+            std::shared_ptr<ProducerThread> otpProducer,
             OTP::system_t system,
             OTP::group_t group,
             QWidget *parent = nullptr);
     ~GroupWindow();
 
+    OTP::group_t getGroup() const { return group; }
+
 public slots:
     void setSystem(OTP::system_t newSystem);
 
@@ -67,31 +70,15 @@ private slots:
 private:
     Ui::GroupWindow *ui;
 
-    std::shared_ptr<class OTP::Producer> otpProducer;
+    std::shared_ptr<ProducerThread> otpProducer;
     OTP::system_t system;
     OTP::group_t group;
 
-    QStringList Axes {QStringLiteral("X"),QStringLiteral("Y"),QStringLiteral("Z")};
-
-    enum ScaleHeaders_e
-    {
-        Scale
-    };
-    QStringList ScaleHeaders = {
-        tr("Scale")
-    };
-
-    enum PointsDetailsHeaders_e
-    {
-        Value,
-        Velocity,
-        Acceleration
-    };
-    QStringList PointsDetailsHeaders = {
-        tr("Value"),
-        tr("Velocity"),
-        tr("Acceleration")
-    };
+    class PointDetailsModel *scaleModel;
+    class PointDetailsModel *positionModel;
+    class PointDetailsModel *rotationModel;
+
+    void setParentWidgetsEnabled(bool enabled);
 
     QList<OTP::address_t> getSelectedAddress();
 };
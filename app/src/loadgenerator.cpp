@@ -0,0 +1,354 @@
+/*
+    OTPView
+    A QT Frontend for E1.59  (Entertainment  Technology  Object  Transform  Protocol  (OTP))
+    Copyright (C) 2026  Marcus Birkin
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "loadgenerator.h"
+#include "settings.h"
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QRandomGenerator>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+
+using namespace OTP;
+
+namespace
+{
+    constexpr double Pi = 3.14159265358979323846;
+    constexpr double Radius = 5000000; // Micrometers
+    constexpr double Spacing = 500000; // Micrometers, between points of the static grid
+    constexpr int GridWidth = 100; // Points
+
+    const QList<QPair<QString, LoadGenerator::pattern_t>> Patterns = {
+        {"static", LoadGenerator::PatternStatic},
+        {"circle", LoadGenerator::PatternCircle},
+        {"wave", LoadGenerator::PatternWave},
+        {"lissajous", LoadGenerator::PatternLissajous},
+        {"random", LoadGenerator::PatternRandomWalk}};
+}
+
+bool LoadGenerator::isRequested(int argc, char *argv[])
+{
+    for (int arg = 1; arg < argc; ++arg)
+        if (std::strcmp(argv[arg], "--load-generator") == 0)
+            return true;
+    return false;
+}
+
+bool LoadGenerator::parseArguments(const QStringList &arguments, config_t &config, QString &message)
+{
+    QStringList patternNames;
+    for (const auto &pattern : Patterns)
+        patternNames << pattern.first;
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Headless OTP producer load generator");
+    const auto helpOption = parser.addHelpOption();
+    const QCommandLineOption generatorOption("load-generator", "Run the load generator, rather than the GUI.");
+    const QCommandLineOption interfaceOption("interface", "Network interface, as in the settings by default.", "name");
+    const QCommandLineOption transportOption("transport", "ipv4, ipv6 or both, as in the settings by default.", "transport");
+    const QCommandLineOption producersOption("producers", "Producers, each sending every point.", "count", "1");
+    const QCommandLineOption systemsOption("systems", "Systems, from 1.", "count", "1");
+    const QCommandLineOption groupsOption("groups", "Groups per system, from 1.", "count", "1");
+    const QCommandLineOption pointsOption("points", "Points per group, from 1.", "count", "100");
+    const QCommandLineOption priorityOption("priority", "Priority of every point.", "priority",
+                                            QString::number(static_cast<int>(priority_t())));
+    const QCommandLineOption rateOption("rate", "Transform message rate, in milliseconds, as in the settings by default.", "ms");
+    const QCommandLineOption updateOption("update", "Interval between value updates, in milliseconds, the transform rate by default.", "ms");
+    const QCommandLineOption patternOption("pattern", QString("Motion pattern: %1.").arg(patternNames.join(", ")), "pattern", "circle");
+    const QCommandLineOption speedOption("speed", "Motion cycles per second.", "hz", "0.25");
+    const QCommandLineOption durationOption("duration", "Seconds to run for, until stopped by default.", "seconds", "0");
+    parser.addOptions({generatorOption, interfaceOption, transportOption, producersOption, systemsOption,
+                       groupsOption, pointsOption, priorityOption, rateOption, updateOption, patternOption,
+                       speedOption, durationOption});
+
+    if (!parser.parse(arguments))
+    {
+        message = parser.errorText();
+        return false;
+    }
+    if (parser.isSet(helpOption))
+        parser.showHelp();
+
+    const auto toInt = [&](const QCommandLineOption &option, int min, int max, int &value) {
+        bool ok = false;
+        const auto number = parser.value(option).toInt(&ok);
+        if (!ok || number < min || number > max)
+        {
+            message = QString("--%1 must be from %2 to %3").arg(option.names().first()).arg(min).arg(max);
+            return false;
+        }
+        value = number;
+        return true;
+    };
+
+    config.iface = Settings::getInstance().getNetworkInterface();
+    if (parser.isSet(interfaceOption))
+    {
+        config.iface = QNetworkInterface::interfaceFromName(parser.value(interfaceOption));
+        if (!config.iface.isValid())
+        {
+            message = QString("Unknown interface %1").arg(parser.value(interfaceOption));
+            return false;
+        }
+    }
+    if (!SocketManager::isValid(config.iface))
+    {
+        message = "No usable network interface, choose one with --interface or in the settings";
+        return false;
+    }
+
+    config.transport = Settings::getInstance().getNetworkTransport();
+    if (parser.isSet(transportOption))
+    {
+        const auto transport = parser.value(transportOption).toLower();
+        if (transport == "ipv4") config.transport = QAbstractSocket::IPv4Protocol;
+        else if (transport == "ipv6") config.transport = QAbstractSocket::IPv6Protocol;
+        else if (transport == "both") config.transport = QAbstractSocket::AnyIPProtocol;
+        else
+        {
+            message = QString("Unknown transport %1").arg(transport);
+            return false;
+        }
+    }
+
+    int priority = 0;
+    int transformRate = static_cast<int>(Settings::getInstance().getTransformMessageRate().count());
+    if (!toInt(producersOption, 1, 100, config.producers)
+            || !toInt(systemsOption, static_cast<int>(RANGES::System.getMin()), static_cast<int>(RANGES::System.getMax()), config.systems)
+            || !toInt(groupsOption, 1, MaxPoints, config.groups)
+            || !toInt(pointsOption, 1, MaxPoints, config.points)
+            || !toInt(priorityOption, static_cast<int>(RANGES::Priority.getMin()), static_cast<int>(RANGES::Priority.getMax()), priority)
+            || (parser.isSet(rateOption) && !toInt(rateOption, 1, 50, transformRate)))
+        return false;
+    config.priority = static_cast<priority_t>(priority);
+    config.transformRate = std::chrono::milliseconds(transformRate);
+
+    int updateInterval = transformRate;
+    if (parser.isSet(updateOption) && !toInt(updateOption, 1, 60000, updateInterval))
+        return false;
+    config.updateInterval = std::chrono::milliseconds(updateInterval);
+
+    if (config.systems * config.groups * config.points > MaxPoints)
+    {
+        message = QString("At most %1 points per producer").arg(MaxPoints);
+        return false;
+    }
+
+    const auto pattern = std::find_if(Patterns.cbegin(), Patterns.cend(), [&](const auto &item) {
+        return item.first == parser.value(patternOption).toLower();
+    });
+    if (pattern == Patterns.cend())
+    {
+        message = QString("Unknown pattern %1").arg(parser.value(patternOption));
+        return false;
+    }
+    config.pattern = pattern->second;
+
+    bool ok = false;
+    config.speed = parser.value(speedOption).toDouble(&ok);
+    if (!ok || config.speed < 0)
+    {
+        message = "--speed must be zero or more";
+        return false;
+    }
+
+    int duration = 0;
+    if (!toInt(durationOption, 0, std::numeric_limits<int>::max(), duration))
+        return false;
+    config.duration = std::chrono::seconds(duration);
+
+    return true;
+}
+
+LoadGenerator::LoadGenerator(const config_t &config, QObject *parent) : QObject(parent),
+    config(config)
+{
+    updateTimer.setTimerType(Qt::PreciseTimer);
+    updateTimer.setInterval(config.updateInterval);
+    connect(&updateTimer, &QTimer::timeout, this, &LoadGenerator::update);
+
+    reportTimer.setInterval(std::chrono::seconds(1));
+    connect(&reportTimer, &QTimer::timeout, this, &LoadGenerator::report);
+}
+
+void LoadGenerator::start()
+{
+    const auto pointCount = config.systems * config.groups * config.points;
+    for (int index = 0; index < config.producers; ++index)
+    {
+        producer_t producer;
+        producer.thread = std::make_shared<ProducerThread>(
+                    config.iface, config.transport, cid_t::createUuid(),
+                    QString("%1 Load Generator %2").arg(QCoreApplication::applicationName()).arg(index + 1),
+                    config.transformRate);
+        producer.walk = std::make_shared<std::vector<std::array<double, 3>>>(pointCount);
+
+        // One call for the whole tree, rather than a wait per point
+        producer.thread->call([this](Producer &otpProducer) {
+            for (int system = 1; system <= config.systems; ++system)
+            {
+                otpProducer.addLocalSystem(system_t(system));
+                for (int group = 1; group <= config.groups; ++group)
+                {
+                    otpProducer.addLocalGroup(system_t(system), group_t(group));
+                    for (int point = 1; point <= config.points; ++point)
+                        otpProducer.addLocalPoint(system_t(system), group_t(group), point_t(point), config.priority);
+                }
+            }
+        });
+        producers.push_back(producer);
+    }
+
+    std::printf("%d producer(s) of %d points on %s, transform rate %lld ms, updates every %lld ms\n",
+                config.producers, pointCount, qPrintable(config.iface.humanReadableName()),
+                static_cast<long long>(config.transformRate.count()),
+                static_cast<long long>(config.updateInterval.count()));
+    std::fflush(stdout);
+
+    clock.start();
+    update();
+    updateTimer.start();
+    reportTimer.start();
+    if (config.duration.count())
+        QTimer::singleShot(config.duration, this, [this]() {
+            updateTimer.stop();
+            reportTimer.stop();
+            report();
+            producers.clear();
+            emit finished();
+        });
+}
+
+void LoadGenerator::update()
+{
+    // A static pattern only needs setting once, the producers keep sending it
+    if (config.pattern == PatternStatic && updates)
+        return;
+
+    const auto time = clock.nsecsElapsed() / 1e9;
+    const auto timestamp = static_cast<timestamp_t>(QDateTime::currentDateTime().toMSecsSinceEpoch());
+    for (const auto &producer : producers)
+    {
+        producer.thread->enqueue([config = config, time, timestamp, walk = producer.walk](Producer &otpProducer) {
+            applyPattern(otpProducer, config, time, timestamp, *walk);
+        });
+    }
+    ++updates;
+}
+
+void LoadGenerator::report()
+{
+    const auto now = clock.elapsed();
+    const auto elapsed = now - lastReportTime;
+    const auto pointCount = config.systems * config.groups * config.points;
+    const auto rate = elapsed > 0 ? (updates - lastReportUpdates) * 1000.0 / elapsed : 0;
+    lastReportTime = now;
+    lastReportUpdates = updates;
+
+    auto jitterMax = std::chrono::microseconds(0);
+    auto jitterMean = std::chrono::microseconds(0);
+    for (const auto &producer : producers)
+    {
+        const auto jitter = producer.thread->getJitter();
+        jitterMax = std::max(jitterMax, jitter.max);
+        jitterMean += jitter.mean / static_cast<int>(producers.size());
+    }
+
+    std::printf("%7.1f s  %8.1f updates/s  %10.0f values/s  jitter %.3f ms avg, %.3f ms max\n",
+                now / 1000.0, rate, rate * pointCount * config.producers,
+                jitterMean.count() / 1000.0, jitterMax.count() / 1000.0);
+    std::fflush(stdout);
+}
+
+void LoadGenerator::applyPattern(
+        Producer &producer,
+        const config_t &config,
+        double time,
+        timestamp_t timestamp,
+        std::vector<std::array<double, 3>> &walk)
+{
+    const auto pointCount = config.systems * config.groups * config.points;
+    const auto cycle = 2 * Pi * config.speed * time;
+
+    const auto setPosition = [&](const address_t &address, axis_t axis, double value) {
+        auto position = producer.getLocalPosition(address, axis);
+        position.value = static_cast<decltype(position.value)>(value);
+        position.timestamp = timestamp;
+        producer.setLocalPosition(address, axis, position);
+    };
+    const auto setRotation = [&](const address_t &address, axis_t axis, double degrees) {
+        degrees = std::fmod(std::fmod(degrees, 360.0) + 360.0, 360.0);
+        auto rotation = producer.getLocalRotation(address, axis);
+        rotation.value = static_cast<decltype(rotation.value)>(degrees * 1000000);
+        rotation.timestamp = timestamp;
+        producer.setLocalRotation(address, axis, rotation);
+    };
+
+    int index = 0;
+    for (int system = 1; system <= config.systems; ++system)
+        for (int group = 1; group <= config.groups; ++group)
+            for (int point = 1; point <= config.points; ++point, ++index)
+            {
+                const address_t address(system_t(system), group_t(group), point_t(point));
+                const auto phase = 2 * Pi * index / pointCount;
+                const auto gridX = (index % GridWidth) * Spacing;
+                const auto gridY = (index / GridWidth) * Spacing;
+
+                std::array<double, 3> position = {gridX, gridY, 0};
+                double heading = 0;
+                switch (config.pattern)
+                {
+                    case PatternStatic: break;
+
+                    case PatternCircle:
+                        position = {Radius * std::cos(cycle + phase), Radius * std::sin(cycle + phase), 0};
+                        heading = (cycle + phase) * 180 / Pi + 90;
+                        break;
+
+                    case PatternWave:
+                        position[2] = Radius / 5 * std::sin(cycle + phase * 4);
+                        break;
+
+                    case PatternLissajous:
+                        position = {Radius * std::sin(3 * (cycle + phase)),
+                                    Radius * std::sin(2 * (cycle + phase)),
+                                    Radius / 5 * std::sin(cycle + phase)};
+                        heading = (cycle + phase) * 180 / Pi;
+                        break;
+
+                    case PatternRandomWalk:
+                    {
+                        auto &current = walk[index];
+                        const auto step = Radius / 50 * std::max(config.speed, 0.01);
+                        for (auto &value : current)
+                            value = std::clamp(value + step * (QRandomGenerator::global()->generateDouble() * 2 - 1),
+                                               -Radius, Radius);
+                        position = current;
+                        break;
+                    }
+                }
+
+                for (auto axis = axis_t::first; axis < axis_t::count; ++axis)
+                    setPosition(address, axis, position[axis]);
+                setRotation(address, axis_t::Z, heading);
+            }
+}
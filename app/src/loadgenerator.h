@@ -0,0 +1,116 @@
+/*
+    OTPView
+    A QT Frontend for E1.59  (Entertainment  Technology  Object  Transform  Protocol  (OTP))
+    Copyright (C) 2026  Marcus Birkin
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#ifndef LOADGENERATOR_H
+#define LOADGENERATOR_H
+
+#include <QElapsedTimer>
+#include <QNetworkInterface>
+#include <QObject>
+#include <QStringList>
+#include <QTimer>
+#include <array>
+#include <chrono>
+#include <memory>
+#include <vector>
+#include "OTPLib.hpp"
+#include "producerthread.h"
+
+/*
+ * Headless producer load generator
+ *
+ * Runs one or more producers, each sending the same tree of systems, groups and points,
+ * with every point following a motion pattern. Nothing but QtCore and the network is needed,
+ * so it can stress consumers, ours or anyone else's, from a bench machine.
+ *
+ * Started with --load-generator, see --help for the rest of its options
+ */
+class LoadGenerator : public QObject
+{
+    Q_OBJECT
+public:
+    static constexpr int MaxPoints = 60000; // Per producer
+
+    typedef enum pattern_e
+    {
+        PatternStatic,
+        PatternCircle,
+        PatternWave,
+        PatternLissajous,
+        PatternRandomWalk
+    } pattern_t;
+
+    typedef struct config_s
+    {
+        QNetworkInterface iface;
+        QAbstractSocket::NetworkLayerProtocol transport = QAbstractSocket::IPv4Protocol;
+        int producers = 1;
+        int systems = 1;
+        int groups = 1;
+        int points = 100; // Per group
+        OTP::priority_t priority;
+        std::chrono::milliseconds transformRate{50};
+        std::chrono::milliseconds updateInterval{50};
+        pattern_t pattern = PatternCircle;
+        double speed = 0.25; // Cycles per second
+        std::chrono::seconds duration{0}; // Until stopped
+    } config_t;
+
+    static bool isRequested(int argc, char *argv[]);
+
+    // Defaults come from the application's settings, false with a message on error, --help exits
+    static bool parseArguments(const QStringList &arguments, config_t &config, QString &message);
+
+    explicit LoadGenerator(const config_t &config, QObject *parent = nullptr);
+
+    void start();
+
+signals:
+    void finished();
+
+private:
+    typedef struct producer_s
+    {
+        std::shared_ptr<ProducerThread> thread;
+
+        // Random walk positions, only touched by edits on the producer's thread
+        std::shared_ptr<std::vector<std::array<double, 3>>> walk;
+    } producer_t;
+
+    void update();
+    void report();
+
+    static void applyPattern(
+            OTP::Producer &producer,
+            const config_t &config,
+            double time,
+            OTP::timestamp_t timestamp,
+            std::vector<std::array<double, 3>> &walk);
+
+    const config_t config;
+    std::vector<producer_t> producers;
+
+    QTimer updateTimer;
+    QTimer reportTimer;
+    QElapsedTimer clock;
+    quint64 updates = 0;
+    quint64 lastReportUpdates = 0;
+    qint64 lastReportTime = 0;
+};
+
+#endif // LOADGENERATOR_H
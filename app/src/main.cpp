@@ -16,14 +16,39 @@
     You should have received a copy of the GNU Lesser General Public License
     along with this program.  If not, see <https://www.gnu.org/licenses/>.
 */
+#include "loadgenerator.h"
 #include "mainwindow.h"
+#include "profiler.h"
 #include "settings.h"
 #include "settingsdialog.h"
 #include <QApplication>
 #include <QMessageBox>
+#include <cstdio>
 
 int main(int argc, char *argv[])
 {
+    // Headless, without widgets
+    if (LoadGenerator::isRequested(argc, argv))
+    {
+        QCoreApplication a(argc, argv);
+        QCoreApplication::setApplicationName(VER_PRODUCTNAME_STR);
+        QCoreApplication::setOrganizationName(VER_COMPANYNAME_STR);
+        QCoreApplication::setApplicationVersion(VER_PRODUCTVERSION_STR);
+
+        LoadGenerator::config_t config;
+        QString message;
+        if (!LoadGenerator::parseArguments(QCoreApplication::arguments(), config, message))
+        {
+            std::fprintf(stderr, "%s\n", qPrintable(message));
+            return 1;
+        }
+
+        LoadGenerator generator(config);
+        QObject::connect(&generator, &LoadGenerator::finished, &a, &QCoreApplication::quit);
+        generator.start();
+        return a.exec();
+    }
+
     QApplication a(argc, argv);
     QApplication::setApplicationName(VER_PRODUCTNAME_STR);
     QApplication::setOrganizationName(VER_COMPANYNAME_STR);
@@ -45,6 +70,10 @@ int main(int argc, char *argv[])
             return 0;
     }
 
+    // Opt in profiling from start up
+    if (qEnvironmentVariableIsSet("OTPVIEW_PROFILE"))
+        Profiler::getInstance().setEnabled(true);
+
     // Main Consumer Window
     MainWindow w;
     w.show();
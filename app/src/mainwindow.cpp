@@ -18,14 +18,20 @@
 */
 #include "mainwindow.h"
 #include "ui_mainwindow.h"
+#include "capturereplaydialog.h"
+#include "diagnosticsdialog.h"
+#include "gatewaydialog.h"
 #include "settingsdialog.h"
 #include "settings.h"
+#include "snapshotserver.h"
+#include <QHeaderView>
+#include <QLabel>
 #include <QMessageBox>
-#include <QTimer>
 #include <QMdiSubWindow>
 #include <QSettings>
 #include "systemselectiondialog.h"
 #include "models/componentsmodel.h"
+#include "systemrequestscheduler.h"
 
 using namespace OTP;
 
@@ -78,78 +84,129 @@ MainWindow::MainWindow(QWidget *parent) :
             });
 
     // OTP Consumer Object
-    otpConsumer.reset(new class Consumer(
+    otpConsumer.reset(new ConsumerThread(
                           Settings::getInstance().getNetworkInterface(),
                           Settings::getInstance().getNetworkTransport(),
-                          QList<system_t>(),
                           Settings::getInstance().getComponentSettings(componentSettingsGroup_CONSUMER).CID,
-                          Settings::getInstance().getComponentSettings(componentSettingsGroup_CONSUMER).Name,
-                          this));
+                          Settings::getInstance().getComponentSettings(componentSettingsGroup_CONSUMER).Name));
+    connect(otpConsumer.get(), &ConsumerThread::snapshotPublished, this, &MainWindow::snapshotPublished);
 
     // OTP Consumer Interface
     connect(&Settings::getInstance(), &Settings::newNetworkInterface, this,
             [this](QNetworkInterface interface) {
                 otpConsumer->setNetworkInterface(interface);
-
-                connect(otpConsumer.get(), &OTP::Consumer::stateChangedNetworkInterface, this,
-                        [this]() {
-                            updateStatusBar();
-                });
-
-                updateStatusBar();
             });
-    updateStatusBar();
 
     // OTP Consumer Transport
     connect(&Settings::getInstance(), &Settings::newNetworkTransport, this,
             [this](QAbstractSocket::NetworkLayerProtocol transport) {
                 otpConsumer->setNetworkTransport(transport);
-                updateStatusBar();
             });
     updateStatusBar();
 
+    // OTP Consumer Shared Memory
+    const auto publishSharedMemory = [this](bool value) {
+        otpConsumer->setSharedMemory(value ? QString(SharedPointTable::DefaultName) : QString());
+    };
+    publishSharedMemory(Settings::getInstance().getPublishSharedMemory());
+    connect(&Settings::getInstance(), &Settings::newPublishSharedMemory, this, publishSharedMemory);
+    connect(otpConsumer.get(), &ConsumerThread::sharedMemoryFailed, this,
+            [this](QString message) {
+                QMessageBox::warning(this, tr("Shared Memory"), message);
+            });
+
+    // OTP Consumer Motion Filters
+    for (const auto &filter : Settings::getInstance().getGroupFilters())
+        otpConsumer->setGroupFilter(filter.system, filter.group, filter.mode, filter.parameters);
+    connect(&Settings::getInstance(), &Settings::newGroupFilter, this,
+            [this](OTP::system_t system, OTP::group_t group) {
+                Settings::groupFilter_t filter;
+                if (Settings::getInstance().getGroupFilter(system, group, filter))
+                    otpConsumer->setGroupFilter(system, group, filter.mode, filter.parameters);
+                else
+                    otpConsumer->clearGroupFilter(system, group);
+            });
+
+    // OTP Consumer Dead Reckoning
+    otpConsumer->setDeadReckoning(Settings::getInstance().getDeadReckoning());
+    connect(&Settings::getInstance(), &Settings::newDeadReckoning, this,
+            [this](bool value) { otpConsumer->setDeadReckoning(value); });
+    otpConsumer->setDeriveMotion(Settings::getInstance().getDeriveMotion());
+    connect(&Settings::getInstance(), &Settings::newDeriveMotion, this,
+            [this](bool value) { otpConsumer->setDeriveMotion(value); });
+    lblDeadReckoning = new QLabel(this);
+    lblDeadReckoning->setVisible(false);
+    ui->statusbar->addPermanentWidget(lblDeadReckoning);
+
+    // OTP Consumer Snapshot Server
+    snapshotServer = new SnapshotServer(this);
+    auto lblSnapshotServer = new QLabel(this);
+    ui->statusbar->addPermanentWidget(lblSnapshotServer);
+    const auto listenSnapshotServer = [this, lblSnapshotServer](quint16 port) {
+        lblSnapshotServer->setText(tr("Snapshot server: 0 clients"));
+        lblSnapshotServer->setVisible(port != 0);
+        if (!snapshotServer->listen(port))
+        {
+            lblSnapshotServer->setVisible(false);
+            QMessageBox::warning(this, tr("Snapshot Server"),
+                                 tr("Unable to listen on port %1\n%2").arg(port).arg(snapshotServer->errorString()));
+        }
+        snapshotServer->publish(otpConsumer->snapshot());
+    };
+    listenSnapshotServer(Settings::getInstance().getSnapshotServerPort());
+    connect(&Settings::getInstance(), &Settings::newSnapshotServerPort, this, listenSnapshotServer);
+    connect(snapshotServer, &SnapshotServer::clientCountChanged, this,
+            [lblSnapshotServer](int count) {
+                lblSnapshotServer->setText(tr("Snapshot server: %1 clients").arg(count));
+            });
+
     // OTP Consumer Name
+    ui->leConsumerName->setText(otpConsumer->snapshot()->localName);
+    ui->leConsumerName->setMaxLength(PDU::NAME_LENGTH);
     connect(ui->leConsumerName, &QLineEdit::textChanged, this,
             [this](const QString &arg1) {
                 otpConsumer->setLocalName(arg1);
                 saveComponentDetails();
             });
-    ui->leConsumerName->setText(otpConsumer->getLocalName());
-    ui->leConsumerName->setMaxLength(PDU::NAME_LENGTH);
 
     // OTP Consumer CID
     connect(ui->pbConsumerNewCID, &QPushButton::clicked, this,
             [this]() {
                 otpConsumer->setLocalCID(cid_t::createUuid());
             });
-    connect(otpConsumer.get(), &Consumer::newLocalCID, this,
-            [this](const cid_t CID) {
-                ui->lblConsumerCID->setText(CID.toString());
-                saveComponentDetails();
-            });
-    ui->lblConsumerCID->setText(otpConsumer->getLocalCID().toString());
+    ui->lblConsumerCID->setText(otpConsumer->snapshot()->localCID.toString());
 
     // OTP Components Table
     ui->tvComponents->setModel(new ComponentsModel(otpConsumer, this));
+    ui->tvComponents->header()->setStretchLastSection(false);
+    ui->tvComponents->header()->setSectionResizeMode(QHeaderView::ResizeToContents);
+    ui->tvComponents->header()->setSectionResizeMode(ComponentsModel::ComponentColumn, QHeaderView::Stretch);
     connect(ui->tvComponents, &QTreeView::doubleClicked, this, &MainWindow::on_tvComponents_doubleClicked);
 
     // System requests
-    QTimer *timer = new QTimer(this);
-    connect(timer, &QTimer::timeout, this,
-        [this]() {
-           otpConsumer->UpdateOTPMap();
-        });
-    timer->start(Settings::getInstance().getSystemRequestInterval());
-    connect(&Settings::getInstance(), &Settings::newSystemRequestInterval, this,
-            [timer](std::chrono::seconds value) {
-                timer->setInterval(value);
+    auto systemRequestScheduler = new SystemRequestScheduler(
+                otpConsumer, Settings::getInstance().getSystemRequestInterval(), this);
+    connect(&Settings::getInstance(), &Settings::newSystemRequestInterval,
+            systemRequestScheduler, &SystemRequestScheduler::setNominalInterval);
+    auto lblSystemRequests = new QLabel(this);
+    ui->statusbar->addPermanentWidget(lblSystemRequests);
+    connect(systemRequestScheduler, &SystemRequestScheduler::statisticsChanged, this,
+            [systemRequestScheduler, lblSystemRequests]() {
+                lblSystemRequests->setText(
+                            tr("System requests: %1 (%2 in the last minute, every %3 s, %4 changes)")
+                            .arg(systemRequestScheduler->getRequestCount())
+                            .arg(systemRequestScheduler->getRequestsPerMinute(), 0, 'f', 0)
+                            .arg(static_cast<double>(systemRequestScheduler->getInterval().count()) / 1000, 0, 'f', 1)
+                            .arg(systemRequestScheduler->getChurnCount()));
             });
-    otpConsumer->UpdateOTPMap();
+    systemRequestScheduler->request();
 }
 
 MainWindow::~MainWindow()
 {
-    otpConsumer.get()->disconnect();
+    // Join the consumer thread while everything connected to it directly still exists
+    otpConsumer->disconnect(this);
+    otpConsumer->stop();
     delete ui;
 }
 
@@ -183,35 +240,64 @@ void MainWindow::on_tvComponents_doubleClicked(const QModelIndex &index)
     }
 }
 
+void MainWindow::snapshotPublished()
+{
+    const auto snapshot = otpConsumer->snapshot();
+
+    // New CID
+    if (ui->lblConsumerCID->text() != snapshot->localCID.toString())
+    {
+        ui->lblConsumerCID->setText(snapshot->localCID.toString());
+        saveComponentDetails();
+    }
+
+    snapshotServer->publish(snapshot);
+    updateStatusBar();
+
+    // Prediction error against the following sample
+    lblDeadReckoning->setVisible(snapshot->deadReckoning);
+    if (snapshot->deadReckoning)
+    {
+        const auto &error = snapshot->deadReckoningError;
+        lblDeadReckoning->setText(tr("Dead reckoning error: mean %1 mm, RMS %2 mm, max %3 mm")
+                                  .arg(error.mean / 1000, 0, 'f', 3)
+                                  .arg(error.rms / 1000, 0, 'f', 3)
+                                  .arg(error.max / 1000, 0, 'f', 3));
+    }
+}
+
 void MainWindow::updateStatusBar()
 {
     QString message = QObject::tr("Not connected");
     if (otpConsumer)
     {
+        const auto snapshot = otpConsumer->snapshot();
         message = QObject::tr("Selected interface: %1").arg(
-                    otpConsumer->getNetworkInterface().humanReadableName());
+                    snapshot->networkInterface.humanReadableName());
 
-        if ((otpConsumer->getNetworkTransport() == QAbstractSocket::IPv4Protocol) ||
-                (otpConsumer->getNetworkTransport() == QAbstractSocket::AnyIPProtocol))
+        if ((snapshot->networkTransport == QAbstractSocket::IPv4Protocol) ||
+                (snapshot->networkTransport == QAbstractSocket::AnyIPProtocol))
         {
-            auto status = otpConsumer->getNetworkinterfaceState(QAbstractSocket::IPv4Protocol);
+            auto status = snapshot->ipv4State;
             message.append(QString(" OTP-4 (%1)").arg(status == QAbstractSocket::BoundState ? tr("OK") : tr("Error")));
         }
 
-        if ((otpConsumer->getNetworkTransport() == QAbstractSocket::IPv6Protocol) ||
-                (otpConsumer->getNetworkTransport() == QAbstractSocket::AnyIPProtocol))
+        if ((snapshot->networkTransport == QAbstractSocket::IPv6Protocol) ||
+                (snapshot->networkTransport == QAbstractSocket::AnyIPProtocol))
         {
-            auto status = otpConsumer->getNetworkinterfaceState(QAbstractSocket::IPv6Protocol);
+            auto status = snapshot->ipv6State;
             message.append(QString(" OTP-6 (%1)").arg(status == QAbstractSocket::BoundState ? tr("OK") : tr("Error")));
         }
     }
 
-    ui->statusbar->showMessage(message);
+    if (message != ui->statusbar->currentMessage())
+        ui->statusbar->showMessage(message);
 }
 
 void MainWindow::saveComponentDetails()
 {
-    Settings::componentDetails_t details(otpConsumer->getLocalName(), otpConsumer->getLocalCID());
+    // The snapshot may not yet reflect a name that was just typed
+    Settings::componentDetails_t details(ui->leConsumerName->text(), otpConsumer->snapshot()->localCID);
     Settings::getInstance().setComponentSettings(componentSettingsGroup_CONSUMER, details);
 }
 
@@ -220,18 +306,15 @@ bool MainWindow::openSystemWindow(system_t system)
     if (!system.isValid()) return false;
 
     // Already open?
-    if (otpConsumer->getLocalSystems().contains(system))
+    for (const auto &subWindow : ui->mdiArea->subWindowList())
     {
-        for (const auto &subWindow : ui->mdiArea->subWindowList())
+        auto systemWindow = qobject_cast<SystemWindow*>(subWindow->widget());
+        if (systemWindow && systemWindow->getSystem() == system)
         {
-            auto systemWindow = reinterpret_cast<SystemWindow*>(subWindow->widget());
-            if ( systemWindow->getSystem() == system)
-            {
-                qDebug() << this << "Set focus system window" << systemWindow->windowTitle();
-                systemWindow->setFocus();
-                systemWindow->setWindowState(Qt::WindowState::WindowActive);
-                return true;
-            }
+            qDebug() << this << "Set focus system window" << systemWindow->windowTitle();
+            systemWindow->setFocus();
+            systemWindow->setWindowState(Qt::WindowState::WindowActive);
+            return true;
         }
     }
 
@@ -258,9 +341,47 @@ void MainWindow::on_actionNew_Producer_triggered()
     producer->show();
 }
 
+void MainWindow::on_actionDiagnostics_triggered()
+{
+    if (!diagnosticsDialog)
+    {
+        diagnosticsDialog = new DiagnosticsDialog(this);
+        diagnosticsDialog->setAttribute(Qt::WA_DeleteOnClose);
+        connect(diagnosticsDialog, &DiagnosticsDialog::metricsReset,
+                otpConsumer.get(), &ConsumerThread::resetDeadReckoningError);
+    }
+    diagnosticsDialog->show();
+    diagnosticsDialog->raise();
+    diagnosticsDialog->activateWindow();
+}
+
+void MainWindow::on_actionReplay_Capture_triggered()
+{
+    if (!captureReplayDialog)
+    {
+        captureReplayDialog = new CaptureReplayDialog(otpConsumer, this);
+        captureReplayDialog->setAttribute(Qt::WA_DeleteOnClose);
+    }
+    captureReplayDialog->show();
+    captureReplayDialog->raise();
+    captureReplayDialog->activateWindow();
+}
+
+void MainWindow::on_actionGateway_triggered()
+{
+    if (!gatewayDialog)
+    {
+        gatewayDialog = new GatewayDialog(otpConsumer, this);
+        gatewayDialog->setAttribute(Qt::WA_DeleteOnClose);
+    }
+    gatewayDialog->show();
+    gatewayDialog->raise();
+    gatewayDialog->activateWindow();
+}
+
 void MainWindow::on_actionNew_Consumer_triggered()
 {
-    auto dialog = new SystemSelectionDialog(otpConsumer->getLocalSystems(), this);
+    auto dialog = new SystemSelectionDialog(otpConsumer->snapshot()->localSystems, this);
     if (dialog->exec() == QDialog::Rejected)
         return;
 
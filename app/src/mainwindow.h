@@ -20,10 +20,12 @@
 #define MAINWINDOW_H
 
 #include <QMainWindow>
+#include <QPointer>
 #include <QTreeWidget>
 #include <QTreeWidgetItem>
 #include <memory>
 #include "OTPLib.hpp"
+#include "consumerthread.h"
 #include "producerwindow.h"
 #include "systemwindow.h"
 
@@ -45,17 +47,26 @@ private slots:
     void on_actionSettings_triggered();
     void on_actionNew_Producer_triggered();
     void on_actionNew_Consumer_triggered();
+    void on_actionDiagnostics_triggered();
+    void on_actionReplay_Capture_triggered();
+    void on_actionGateway_triggered();
     void on_tvComponents_doubleClicked(const QModelIndex &index);
 
 private:
     Ui::MainWindow *ui;
+    void snapshotPublished();
     void updateStatusBar();
     void saveComponentDetails();
 
     bool openSystemWindow(OTP::system_t system);
 
-    std::shared_ptr<class OTP::Consumer> otpConsumer;
+    std::shared_ptr<ConsumerThread> otpConsumer;
+    class SnapshotServer *snapshotServer;
+    class QLabel *lblDeadReckoning;
     QList<ProducerWindow*> producerWindows;
+    QPointer<class DiagnosticsDialog> diagnosticsDialog;
+    QPointer<class CaptureReplayDialog> captureReplayDialog;
+    QPointer<class GatewayDialog> gatewayDialog;
 };
 
 #endif // MAINWINDOW_H
@@ -0,0 +1,222 @@
+/*
+    OTPView
+    A QT Frontend for E1.59  (Entertainment  Technology  Object  Transform  Protocol  (OTP))
+    Copyright (C) 2026  Marcus Birkin
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "metrics.h"
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QtAlgorithms>
+#include <algorithm>
+#include <cmath>
+
+void Histogram::record(qint64 microseconds)
+{
+    const auto value = std::clamp<qint64>(microseconds, 0, MaxValue);
+    counts[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    total.fetch_add(1, std::memory_order_relaxed);
+    sum.fetch_add(value, std::memory_order_relaxed);
+
+    auto current = minimum.load(std::memory_order_relaxed);
+    while (value < current && !minimum.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+    current = maximum.load(std::memory_order_relaxed);
+    while (value > current && !maximum.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+}
+
+Histogram::summary_t Histogram::summary() const
+{
+    summary_t ret;
+
+    // Counted from the buckets, so the percentiles agree with the count
+    std::array<quint64, BucketCount> snapshot;
+    for (int index = 0; index < BucketCount; ++index)
+    {
+        snapshot[index] = counts[index].load(std::memory_order_relaxed);
+        ret.count += snapshot[index];
+    }
+    if (!ret.count) return ret;
+
+    ret.min = minimum.load(std::memory_order_relaxed);
+    ret.max = maximum.load(std::memory_order_relaxed);
+    ret.mean = static_cast<double>(sum.load(std::memory_order_relaxed))
+            / static_cast<double>(std::max<quint64>(total.load(std::memory_order_relaxed), 1));
+
+    // Each percentile is the highest value equivalent to its bucket, as HdrHistogram reports
+    const std::pair<double, qint64*> percentiles[] = {
+        {0.50, &ret.p50}, {0.90, &ret.p90}, {0.99, &ret.p99}, {0.999, &ret.p999}};
+    quint64 seen = 0;
+    int index = 0;
+    for (const auto &[fraction, result] : percentiles)
+    {
+        const auto target = std::max<quint64>(1, static_cast<quint64>(std::ceil(fraction * ret.count)));
+        while (index < BucketCount && seen + snapshot[index] < target)
+            seen += snapshot[index++];
+        *result = std::min(bucketUpperBound(std::min(index, BucketCount - 1)), ret.max);
+    }
+
+    return ret;
+}
+
+QVector<Histogram::bucket_t> Histogram::buckets() const
+{
+    QVector<bucket_t> ret;
+    for (int index = 0; index < BucketCount; ++index)
+    {
+        const auto count = counts[index].load(std::memory_order_relaxed);
+        if (count)
+            ret.append({bucketLowerBound(index), bucketUpperBound(index), count});
+    }
+    return ret;
+}
+
+void Histogram::reset()
+{
+    for (auto &count : counts)
+        count.store(0, std::memory_order_relaxed);
+    total.store(0, std::memory_order_relaxed);
+    sum.store(0, std::memory_order_relaxed);
+    minimum.store(std::numeric_limits<qint64>::max(), std::memory_order_relaxed);
+    maximum.store(0, std::memory_order_relaxed);
+}
+
+int Histogram::bucketIndex(qint64 value)
+{
+    if (value < SubBucketCount)
+        return static_cast<int>(value);
+
+    const auto magnitude = 63 - qCountLeadingZeroBits(static_cast<quint64>(value));
+    const auto shift = magnitude - SubBucketBits;
+    const auto subBucket = (value >> shift) - SubBucketCount;
+    return static_cast<int>((shift + 1) * SubBucketCount + subBucket);
+}
+
+qint64 Histogram::bucketLowerBound(int index)
+{
+    if (index < SubBucketCount)
+        return index;
+
+    const auto shift = index / SubBucketCount - 1;
+    const auto subBucket = index % SubBucketCount + SubBucketCount;
+    return qint64(subBucket) << shift;
+}
+
+qint64 Histogram::bucketUpperBound(int index)
+{
+    if (index < SubBucketCount)
+        return index;
+
+    const auto shift = index / SubBucketCount - 1;
+    return bucketLowerBound(index) + (qint64(1) << shift) - 1;
+}
+
+Metrics &Metrics::getInstance()
+{
+    static Metrics instance;
+    return instance;
+}
+
+Histogram &Metrics::histogram(const QString &name)
+{
+    {
+        QReadLocker locker(&lock);
+        const auto it = histogramMap.constFind(name);
+        if (it != histogramMap.constEnd())
+            return *it.value();
+    }
+
+    QWriteLocker locker(&lock);
+    auto &ret = histogramMap[name];
+    if (!ret)
+        ret = std::make_shared<Histogram>();
+    return *ret;
+}
+
+QList<QPair<QString, const Histogram*>> Metrics::histograms() const
+{
+    QList<QPair<QString, const Histogram*>> ret;
+    QReadLocker locker(&lock);
+    for (auto it = histogramMap.cbegin(); it != histogramMap.cend(); ++it)
+        ret.append({it.key(), it.value().get()});
+    return ret;
+}
+
+void Metrics::reset()
+{
+    QReadLocker locker(&lock);
+    for (const auto &histogram : qAsConst(histogramMap))
+        histogram->reset();
+}
+
+bool Metrics::save(const QString &fileName, QString *errorString) const
+{
+    QJsonArray histogramsJson;
+    for (const auto &[name, histogram] : histograms())
+    {
+        const auto summary = histogram->summary();
+        QJsonArray bucketsJson;
+        for (const auto &bucket : histogram->buckets())
+            bucketsJson.append(QJsonArray{bucket.lowerBound, bucket.upperBound, static_cast<qint64>(bucket.count)});
+
+        QJsonObject histogramJson;
+        histogramJson.insert("name", name);
+        histogramJson.insert("count", static_cast<qint64>(summary.count));
+        histogramJson.insert("min", summary.min);
+        histogramJson.insert("mean", summary.mean);
+        histogramJson.insert("p50", summary.p50);
+        histogramJson.insert("p90", summary.p90);
+        histogramJson.insert("p99", summary.p99);
+        histogramJson.insert("p99.9", summary.p999);
+        histogramJson.insert("max", summary.max);
+        histogramJson.insert("buckets", bucketsJson);
+        histogramsJson.append(histogramJson);
+    }
+
+    QJsonObject root;
+    root.insert("application", QCoreApplication::applicationName());
+    root.insert("version", QCoreApplication::applicationVersion());
+    root.insert("generated", QDateTime::currentDateTimeUtc().toString(Qt::ISODateWithMs));
+    root.insert("unit", QStringLiteral("us"));
+    root.insert("histograms", histogramsJson);
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        if (errorString) *errorString = file.errorString();
+        return false;
+    }
+    file.write(QJsonDocument(root).toJson());
+    if (!file.flush())
+    {
+        if (errorString) *errorString = file.errorString();
+        return false;
+    }
+    return true;
+}
+
+qint64 Metrics::now()
+{
+    static const QElapsedTimer clock = []() {
+        QElapsedTimer ret;
+        ret.start();
+        return ret;
+    }();
+    return clock.nsecsElapsed();
+}
@@ -0,0 +1,122 @@
+/*
+    OTPView
+    A QT Frontend for E1.59  (Entertainment  Technology  Object  Transform  Protocol  (OTP))
+    Copyright (C) 2026  Marcus Birkin
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <QList>
+#include <QMap>
+#include <QPair>
+#include <QReadWriteLock>
+#include <QString>
+#include <QVector>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <memory>
+
+/*
+ * Lock free histogram of durations, in microseconds
+ *
+ * Buckets are log linear, as in HdrHistogram: values below SubBucketCount are exact,
+ * above that every power of two is split into SubBucketCount equal steps,
+ * which keeps about 3% precision from a microsecond up to MaxValue.
+ * Recording is a few relaxed atomic operations, from any thread
+ */
+class Histogram
+{
+public:
+    static constexpr int SubBucketBits = 5;
+    static constexpr qint64 SubBucketCount = qint64(1) << SubBucketBits;
+    static constexpr int MaxMagnitude = 36;
+    static constexpr qint64 MaxValue = (qint64(1) << MaxMagnitude) - 1; // About 19 hours
+    static constexpr int BucketCount = (MaxMagnitude - SubBucketBits + 1) * SubBucketCount;
+
+    typedef struct summary_s
+    {
+        quint64 count = 0;
+        qint64 min = 0;
+        qint64 max = 0;
+        double mean = 0;
+        qint64 p50 = 0;
+        qint64 p90 = 0;
+        qint64 p99 = 0;
+        qint64 p999 = 0;
+    } summary_t;
+
+    typedef struct bucket_s
+    {
+        qint64 lowerBound;
+        qint64 upperBound;
+        quint64 count;
+    } bucket_t;
+
+    void record(qint64 microseconds);
+    void record(std::chrono::microseconds value) { record(value.count()); }
+
+    summary_t summary() const;
+    QVector<bucket_t> buckets() const; // Non empty only
+
+    // Not atomic with respect to concurrent record() calls, a few samples may survive
+    void reset();
+
+    static int bucketIndex(qint64 value);
+    static qint64 bucketLowerBound(int index);
+    static qint64 bucketUpperBound(int index);
+
+private:
+    std::array<std::atomic<quint64>, BucketCount> counts{};
+    std::atomic<quint64> total{0};
+    std::atomic<qint64> sum{0};
+    std::atomic<qint64> minimum{std::numeric_limits<qint64>::max()};
+    std::atomic<qint64> maximum{0};
+};
+
+/*
+ * Named histograms for timing quality, shared by the whole application
+ *
+ * Histograms are created on first use and never destroyed,
+ * so callers on hot paths look theirs up once and keep the reference
+ */
+class Metrics final
+{
+public:
+    static Metrics &getInstance();
+
+    Histogram &histogram(const QString &name);
+    QList<QPair<QString, const Histogram*>> histograms() const; // Sorted by name
+
+    void reset();
+
+    // JSON, with every non empty bucket
+    bool save(const QString &fileName, QString *errorString = nullptr) const;
+
+    // Monotonic nanoseconds, comparable between threads
+    static qint64 now();
+    static qint64 microsecondsSince(qint64 then) { return (now() - then) / 1000; }
+
+private:
+    Metrics() = default;
+    ~Metrics() = default;
+
+    mutable QReadWriteLock lock;
+    QMap<QString, std::shared_ptr<Histogram>> histogramMap;
+};
+
+#endif // METRICS_H
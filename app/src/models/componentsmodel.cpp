@@ -17,8 +17,12 @@
     along with this program.  If not, see <https://www.gnu.org/licenses/>.
 */
 #include "componentsmodel.h"
+#include "componentstatistics.h"
+#include "metrics.h"
+#include "profiler.h"
 #include "settings.h"
 #include <QFont>
+#include <algorithm>
 
 using namespace OTP;
 
@@ -30,138 +34,113 @@ static QFont italic()
 }
 
 ComponentsItem::ComponentsItem(
-        std::shared_ptr<class Consumer> otpConsumer,
         cid_t CID,
         itemType_t type,
         ComponentsItem *parentItem)
-    : QObject(parentItem), otpConsumer(otpConsumer), CID(CID), type(type)
+    : QObject(parentItem), CID(CID), type(type),
+      componentItem((type == ComponentFirst || !parentItem) ? this : parentItem->componentItem),
+      details(std::make_shared<const componentDetails_t>())
 {
     if (type == ComponentFirst)
     {
         auto firstType = ComponentFirst + 1;
-        childItems.resize((ComponentLast - firstType) + 1);
+        childItems.reserve((ComponentLast - firstType) + 1);
         for (auto newType = firstType; newType <= ComponentLast; newType++)
-        {
-            auto childItem = new ComponentsItem(
-                            this->otpConsumer,
-                            CID,
-                            static_cast<itemType_t>(newType),
-                            this);
-            connect(childItem, &ComponentsItem::dataChanged, this, &ComponentsItem::dataChanged);
-            connect(childItem, &ComponentsItem::layoutChanged, this, &ComponentsItem::layoutChanged);
-            childItems[newType - firstType] = childItem;
-        }
+            adoptChild(new ComponentsItem(
+                           CID,
+                           static_cast<itemType_t>(newType),
+                           this));
     }
+}
 
-    switch (type)
-    {
-        case ComponentRootItem: break;
-        case ComponentSystemListItem: break;
-        case ComponentModuleListItem: break;
-        case ComponentCID:
-        {
-            connect(otpConsumer.get(), &Consumer::removedComponent, this,
-                    [this](cid_t cid)
-            {
-                if (Settings::getInstance().getRemoveExpiredComponents()) {
-                    if (cid == this->CID) {
-                        for (const auto &child : qAsConst(childItems))
-                            removeChild(child);
-                        this->parentItem()->removeChild(this);
-                        emit layoutChanged();
-                    }
-                } else {
-                    emit dataChanged();
-                }
-            });
-        } break;
-
-        case ComponentName:
-        {
-            connect(otpConsumer.get(), qOverload<const cid_t&, const name_t&>(&Consumer::updatedComponent),
-                    this, &ComponentsItem::dataChanged);
-        } break;
+ComponentsItem *ComponentsItem::detailItem(itemType_t type)
+{
+    Q_ASSERT(this->type == ComponentFirst);
+    return child(type - (ComponentFirst + 1));
+}
 
-        case ComponentType:
-        {
-            connect(otpConsumer.get(), qOverload<const cid_t&, component_t::type_t>(&Consumer::updatedComponent),
-                    this, &ComponentsItem::dataChanged);
-        } break;
+void ComponentsItem::setDetails(std::shared_ptr<const componentDetails_t> value)
+{
+    Q_ASSERT(type == ComponentFirst);
+    if (!value || value == details) return;
+    details = value;
+
+    // Rows simply list the systems and modules in order, so any change may alter every row
+    detailItem(ComponentSystemList)->resizeChildren(
+                (details->type == component_t::consumer) ? 0 : details->systems.count(), // Consumers don't send system lists
+                ComponentSystemListItem);
+    detailItem(ComponentModuleList)->resizeChildren(details->moduleList.count(), ComponentModuleListItem);
+    notifyDataChanged(true);
+}
 
-        case ComponentIP:
-        {
-            connect(otpConsumer.get(), qOverload<const cid_t&, const QHostAddress&>(&Consumer::updatedComponent),
-                    this, &ComponentsItem::dataChanged);
-        } break;
+void ComponentsItem::adoptChild(ComponentsItem *item)
+{
+    item->cachedRow = childItems.count();
+    connect(item, &ComponentsItem::dataChanged, this, &ComponentsItem::dataChanged);
+    connect(item, &ComponentsItem::childrenDataChanged, this, &ComponentsItem::childrenDataChanged);
+    connect(item, &ComponentsItem::childrenAboutToBeInserted, this, &ComponentsItem::childrenAboutToBeInserted);
+    connect(item, &ComponentsItem::childrenInserted, this, &ComponentsItem::childrenInserted);
+    connect(item, &ComponentsItem::childrenAboutToBeRemoved, this, &ComponentsItem::childrenAboutToBeRemoved);
+    connect(item, &ComponentsItem::childrenRemoved, this, &ComponentsItem::childrenRemoved);
+    childItems.append(item);
+}
 
-        case ComponentSystemList:
-        {
-            connect(otpConsumer.get(), &Consumer::newSystem, this, [this](cid_t cid)
-            {
-                if (cid == this->CID)
-                {
-                    if (this->otpConsumer->getComponent(cid).getType() == component_t::consumer)
-                        return; // Consumers don't send system lists
-
-                    this->childItems.append(
-                                new ComponentsItem(this->otpConsumer, this->CID, ComponentSystemListItem, this));
-                    emit layoutChanged();
-                }
-            });
-            connect(otpConsumer.get(), &Consumer::removedSystem, this, [this, CID](cid_t cid)
-            {
-                if (cid == CID)
-                {
-                    if (childItems.size()) {
-                        this->childItems.resize(childItems.size() - 1);
-                        emit layoutChanged();
-                    }
-                }
-            });
-        } break;
-
-        case ComponentModuleList:
-        {
-            connect(otpConsumer.get(), qOverload<const cid_t&, const OTP::moduleList_t&>(&Consumer::updatedComponent),
-                    this, [this](cid_t cid, OTP::moduleList_t moduleList)
-            {
-                if (cid == this->CID)
-                {
-                    if (moduleList.count() < this->childItems.count())
-                        this->childItems.resize(moduleList.count());
-                    else
-                        for (int n = this->childItems.count(); n < moduleList.count(); ++n)
-                            this->childItems.append(
-                                        new ComponentsItem(this->otpConsumer, this->CID, ComponentModuleListItem, this));
-                    emit layoutChanged();
-                }
-            });
-
-            const auto moduleList = this->otpConsumer->getComponent(CID).getModuleList();
-            if (moduleList.count() < this->childItems.count())
-                this->childItems.resize(moduleList.count());
-            else
-                for (int n = this->childItems.count(); n < moduleList.count(); ++n)
-                    this->childItems.append(
-                                new ComponentsItem(this->otpConsumer, this->CID, ComponentModuleListItem, this));
-
-        } break;
+void ComponentsItem::appendChild(ComponentsItem *item)
+{
+    emit childrenAboutToBeInserted(this, childCount(), childCount());
+    adoptChild(item);
+    emit childrenInserted();
+}
+
+void ComponentsItem::removeChildren(int first, int count)
+{
+    if (first < 0 || count <= 0 || first + count > childCount())
+        return;
+
+    emit childrenAboutToBeRemoved(this, first, first + count - 1);
+    const auto removed = childItems.mid(first, count);
+    childItems.remove(first, count);
+    for (int row = first; row < childItems.count(); ++row)
+        childItems.at(row)->cachedRow = row;
+    emit childrenRemoved();
+
+    // Removal may be requested from within one of the item's own slots
+    for (const auto &item : removed)
+    {
+        disconnect(item, nullptr, this, nullptr);
+        item->cachedRow = -1;
+        item->deleteLater();
     }
 }
 
-void ComponentsItem::appendChild(ComponentsItem *item)
+void ComponentsItem::resizeChildren(int count, itemType_t type)
 {
-    childItems.append(item);
+    count = std::max(count, 0);
+    if (count < childCount())
+    {
+        removeChildren(count, childCount() - count);
+    } else if (count > childCount()) {
+        emit childrenAboutToBeInserted(this, childCount(), count - 1);
+        while (childCount() < count)
+            adoptChild(new ComponentsItem(CID, type, this));
+        emit childrenInserted();
+    }
 }
 
-void ComponentsItem::removeChild(ComponentsItem *item)
+void ComponentsItem::notifyDataChanged(bool recursive)
 {
-    childItems.removeAll(item);
+    emit dataChanged(this);
+    if (!recursive || childItems.isEmpty()) return;
+
+    emit childrenDataChanged(this);
+    for (const auto &child : qAsConst(childItems))
+        if (child->childCount())
+            child->notifyDataChanged(true);
 }
 
 ComponentsItem *ComponentsItem::child(int row)
 {
-    if (row < 0 || row > childCount())
+    if (row < 0 || row >= childCount())
         return nullptr;
     return childItems.at(row);
 }
@@ -176,9 +155,14 @@ QVariant ComponentsItem::data(int column, int role) const
     if (column < 0 || column >= columnCount())
         return QVariant();
 
+    if (type == ComponentRootItem)
+        return (role == Qt::DisplayRole) ? QString("Components") : QVariant();
+
+    const auto &details = getDetails();
+
     if (role == Qt::FontRole)
     {
-        if (otpConsumer->isComponentExpired(CID))
+        if (details.expired)
             return italic();
         else
             return QVariant();
@@ -188,50 +172,46 @@ QVariant ComponentsItem::data(int column, int role) const
     {
         switch (type)
         {
-            case ComponentRootItem:
-                return QString("Components");
-
             case ComponentCID:
                 return QString("%1").arg(CID.toString());
 
             case ComponentName:
                 return QString("Name: %1")
-                        .arg(otpConsumer->isComponentExpired(CID)
-                             ? QStringLiteral("Offline") : otpConsumer->getComponent(CID).getName().toString());
+                        .arg(details.expired
+                             ? QStringLiteral("Offline") : details.name);
 
             case ComponentIP:
                 return QString("IP: %1")
-                        .arg(otpConsumer->isComponentExpired(CID)
-                             ? QStringLiteral("Offline") : otpConsumer->getComponent(CID).getIPAddr().toString());
+                        .arg(details.expired
+                             ? QStringLiteral("Offline") : details.ipAddr.toString());
 
             case ComponentType:
                 return QString("Type: %1")
-                        .arg(otpConsumer->isComponentExpired(CID)
-                            ? QStringLiteral("Offline") : otpConsumer->getComponent(CID).getType()
+                        .arg(details.expired
+                            ? QStringLiteral("Offline") : details.type
                                 == component_t::consumer ? QString("Consumer") : QString("Producer"));
 
             case ComponentSystemList:
-                if (otpConsumer->getComponent(CID).getType() == component_t::consumer)
+                if (details.type == component_t::consumer)
                     return "Systems: N/A";
                 else
                     return QString("Systems%1").arg(
-                                otpConsumer->getSystems(CID).isEmpty() ? ": None" : "");
+                                details.systems.isEmpty() ? ": None" : "");
 
             case ComponentSystemListItem:
-                return QString::number(otpConsumer->getSystems(CID).value(row()));
+                return QString::number(details.systems.value(row()));
 
             case ComponentModuleList:
             {
-                const auto moduleList = this->otpConsumer->getComponent(CID).getModuleList();
                 return QString("Modules (%1)%2").arg(
-                            (otpConsumer->getComponent(CID).getType() == component_t::consumer) ?
+                            (details.type == component_t::consumer) ?
                                 QString("Advertised") : QString("Active"),
-                            moduleList.isEmpty() ? ": None" : "");
+                            details.moduleList.isEmpty() ? ": None" : "");
             }
 
             case ComponentModuleListItem:
             {
-                const auto moduleList = this->otpConsumer->getComponent(CID).getModuleList();
+                const auto &moduleList = details.moduleList;
                 auto moduleDescription = OTP::MODULES::getModuleDescription(moduleList.value(row()));
                 const auto manufacturerID = moduleList.value(row()).ManufacturerID;
                 const auto moduleNumber = moduleList.value(row()).ModuleNumber;
@@ -258,47 +238,108 @@ ComponentsItem *ComponentsItem::parentItem() const
 int ComponentsItem::row() const
 {
     if (parentItem())
-        return parentItem()->childItems.indexOf(const_cast<ComponentsItem*>(this));
+        return cachedRow;
 
     return 0;
 }
 
 ComponentsModel::ComponentsModel(
-        std::shared_ptr<class Consumer> otpConsumer,
+        std::shared_ptr<ConsumerThread> otpConsumer,
         QObject *parent)
     : QAbstractItemModel(parent),
       otpConsumer(otpConsumer)
 {
-    rootItem = new ComponentsItem(otpConsumer);
+    rootItem = new ComponentsItem();
+    connect(rootItem, &ComponentsItem::dataChanged, this, [this](ComponentsItem *item) {
+        const auto index = indexOf(item);
+        if (index.isValid())
+            emit dataChanged(index, index);
+    });
+    connect(rootItem, &ComponentsItem::childrenDataChanged, this, [this](ComponentsItem *item) {
+        const auto parent = indexOf(item);
+        if ((item != rootItem && !parent.isValid()) || !item->childCount())
+            return;
+        emit dataChanged(index(0, 0, parent), index(item->childCount() - 1, 0, parent));
+    });
+    connect(rootItem, &ComponentsItem::childrenAboutToBeInserted, this, [this](ComponentsItem *item, int first, int last) {
+        beginInsertRows(indexOf(item), first, last);
+    });
+    connect(rootItem, &ComponentsItem::childrenInserted, this, [this]() { endInsertRows(); });
+    connect(rootItem, &ComponentsItem::childrenAboutToBeRemoved, this, [this](ComponentsItem *item, int first, int last) {
+        beginRemoveRows(indexOf(item), first, last);
+    });
+    connect(rootItem, &ComponentsItem::childrenRemoved, this, [this]() { endRemoveRows(); });
+
+    // Statistics
+    statistics = new ComponentStatistics(otpConsumer->consumer(), this);
+    connect(statistics, &ComponentStatistics::sampled, this, [this]() {
+        const ProfileScope profile("ComponentsModel statistics");
+        if (rootItem->childCount())
+            emit dataChanged(
+                    index(0, PointUpdatesColumn),
+                    index(rootItem->childCount() - 1, ColumnCount - 1),
+                    {Qt::DisplayRole});
+    });
+
+    // Components
+    connect(otpConsumer.get(), &ConsumerThread::snapshotPublished, this, &ComponentsModel::snapshotPublished);
+    snapshotPublished();
+}
+
+ComponentsModel::~ComponentsModel()
+{
+    delete rootItem;
+}
 
-    // New Components
-    connect(otpConsumer.get(), &Consumer::newComponent, this, &ComponentsModel::newComponent);
+void ComponentsModel::snapshotPublished()
+{
+    const ProfileScope profile("ComponentsModel::snapshotPublished");
+    const auto snapshot = otpConsumer->snapshot();
+    const auto removeExpired = Settings::getInstance().getRemoveExpiredComponents();
+
+    // Unchanged components share their details with the previous snapshot
+    for (auto it = snapshot->components.cbegin(); it != snapshot->components.cend(); ++it)
+    {
+        const auto &cid = it.key();
+        const auto &details = it.value();
+        auto item = componentItems.value(cid);
+        if (item && &item->getDetails() == details.get())
+            continue;
+
+        if (details->expired && removeExpired)
+        {
+            if (!item) continue;
+            componentItems.remove(cid);
+            rootItem->removeChildren(item->row(), 1);
+            continue;
+        }
 
-    // Existing Components
-    for (const auto &cid : otpConsumer->getComponents())
-        emit otpConsumer.get()->newComponent(cid);
+        if (item)
+        {
+            // Updated, or returning from expiry
+            item->setDetails(details);
+            continue;
+        }
+
+        auto newItem = new ComponentsItem(cid, ComponentsItem::ComponentFirst, rootItem);
+        newItem->setDetails(details);
+        componentItems.insert(cid, newItem);
+        rootItem->appendChild(newItem);
+    }
+
+    static auto &updateLatency = Metrics::getInstance().histogram(QStringLiteral("GUI components model update latency"));
+    updateLatency.record(Metrics::microsecondsSince(snapshot->publishedAt));
 }
 
-void ComponentsModel::newComponent(OTP::cid_t cid)
+QModelIndex ComponentsModel::indexOf(ComponentsItem *item) const
 {
-    for (const auto &child : rootItem->children())
-        if (reinterpret_cast<ComponentsItem*>(child)->getCID() == cid)
-            return;
+    if (!item || item == rootItem)
+        return QModelIndex();
 
-    auto newItem = new ComponentsItem(
-                this->otpConsumer,
-                cid,
-                ComponentsItem::ComponentFirst,
-                rootItem);
-    connect(newItem, &ComponentsItem::dataChanged, this, [this]() {
-        emit dataChanged(QModelIndex(),QModelIndex());
-    });
-    connect(newItem, &ComponentsItem::layoutChanged, this, [this]() {
-        emit layoutChanged();
-    });
-    beginInsertRows(QModelIndex(), rootItem->childCount(), rootItem->childCount());
-    rootItem->appendChild(newItem);
-    endInsertRows();
+    const auto row = item->row();
+    if (row < 0)
+        return QModelIndex();
+    return createIndex(row, 0, item);
 }
 
 QVariant ComponentsModel::data(const QModelIndex &index, int role) const
@@ -308,9 +349,46 @@ QVariant ComponentsModel::data(const QModelIndex &index, int role) const
 
     ComponentsItem *item = static_cast<ComponentsItem*>(index.internalPointer());
 
+    if (index.column() != ComponentColumn)
+        return statisticsData(item, index.column(), role);
+
     return item->data(index.column(), role);
 }
 
+QVariant ComponentsModel::statisticsData(const ComponentsItem *item, int column, int role) const
+{
+    if (item->getType() != ComponentsItem::ComponentCID)
+        return QVariant();
+
+    switch (role)
+    {
+        case Qt::FontRole:
+            return item->data(ComponentColumn, role);
+
+        case Qt::TextAlignmentRole:
+            return QVariant(Qt::AlignRight | Qt::AlignVCenter);
+
+        case Qt::DisplayRole:
+        {
+            const auto stats = statistics->getStatistics(item->getCID());
+            switch (column)
+            {
+                case PointUpdatesColumn: return QString::number(stats.pointUpdatesPerSecond, 'f', 1);
+                case PointsColumn: return QString::number(stats.points);
+                case LastSeenColumn:
+                    return (stats.lastSeenAge < 0)
+                            ? QString("Never")
+                            : QString("%1 s").arg(static_cast<double>(stats.lastSeenAge) / 1000, 0, 'f', 1);
+                case ExpiriesColumn: return QString::number(stats.expiries);
+                default: return QVariant();
+            }
+        }
+
+        default:
+            return QVariant();
+    }
+}
+
 Qt::ItemFlags ComponentsModel::flags(const QModelIndex &index) const
 {
     if (!index.isValid())
@@ -323,7 +401,17 @@ QVariant ComponentsModel::headerData(int section, Qt::Orientation orientation,
                                int role) const
 {
     if (orientation == Qt::Horizontal && role == Qt::DisplayRole)
-        return rootItem->data(section);
+    {
+        switch (section)
+        {
+            case ComponentColumn: return rootItem->data(section);
+            case PointUpdatesColumn: return QString("Point Updates/s");
+            case PointsColumn: return QString("Points");
+            case LastSeenColumn: return QString("Last Seen");
+            case ExpiriesColumn: return QString("Expiries");
+            default: return QVariant();
+        }
+    }
 
     return QVariant();
 }
@@ -376,7 +464,6 @@ int ComponentsModel::rowCount(const QModelIndex &parent) const
 
 int ComponentsModel::columnCount(const QModelIndex &parent) const
 {
-    if (parent.isValid())
-        return static_cast<ComponentsItem*>(parent.internalPointer())->columnCount();
-    return rootItem->columnCount();
+    Q_UNUSED(parent)
+    return ColumnCount;
 }
@@ -19,7 +19,10 @@
 #ifndef COMPONENTSMODEL_H
 #define COMPONENTSMODEL_H
 #include <QAbstractItemModel>
+#include <QHash>
+#include <QHostAddress>
 #include "OTPLib.hpp"
+#include "consumerthread.h"
 
 class ComponentsItem : public QObject
 {
@@ -42,13 +45,16 @@ public:
     } itemType_t;
 
     explicit ComponentsItem(
-            std::shared_ptr<class OTP::Consumer> otpConsumer,
             OTP::cid_t CID = OTP::cid_t(),
             itemType_t type = ComponentRootItem,
             ComponentsItem *parentItem = nullptr);
 
+    // Details shared by every item of a component, as captured by the consumer's snapshots
+    typedef ConsumerSnapshot::componentDetails_t componentDetails_t;
+
     void appendChild(ComponentsItem *item);
-    void removeChild(ComponentsItem *item);
+    void removeChildren(int first, int count);
+    void resizeChildren(int count, itemType_t type);
     ComponentsItem *child(int row);
     int childCount() const;
     int columnCount() const  { return 1; }
@@ -60,15 +66,32 @@ public:
 
     OTP::cid_t getCID() const { return CID; };
 
+    ComponentsItem *detailItem(itemType_t type);
+    const componentDetails_t &getDetails() const { return *componentItem->details; }
+    void setDetails(std::shared_ptr<const componentDetails_t> value);
+
+    void notifyDataChanged(bool recursive = false);
+
 signals:
-    void dataChanged();
-    void layoutChanged();
+    // Changes are reported with the item they occurred on,
+    // and forwarded up the tree to the root item
+    void dataChanged(ComponentsItem *item);
+    void childrenDataChanged(ComponentsItem *item);
+    void childrenAboutToBeInserted(ComponentsItem *item, int first, int last);
+    void childrenInserted();
+    void childrenAboutToBeRemoved(ComponentsItem *item, int first, int last);
+    void childrenRemoved();
 
 private:
-    std::shared_ptr<class OTP::Consumer> otpConsumer;
+    void adoptChild(ComponentsItem *item);
+
     OTP::cid_t CID;
     itemType_t type;
 
+    int cachedRow = -1;
+    ComponentsItem *componentItem;
+    std::shared_ptr<const componentDetails_t> details; // Only used by the component item
+
     QVector<ComponentsItem*> childItems;
 };
 
@@ -77,9 +100,20 @@ class ComponentsModel : public QAbstractItemModel
     Q_OBJECT
 
 public:
+    // Statistics columns are only populated for the component rows
+    typedef enum column_e {
+        ComponentColumn,
+        PointUpdatesColumn,
+        PointsColumn,
+        LastSeenColumn,
+        ExpiriesColumn,
+        ColumnCount
+    } column_t;
+
     explicit ComponentsModel(
-            std::shared_ptr<class OTP::Consumer> otpConsumer,
+            std::shared_ptr<ConsumerThread> otpConsumer,
             QObject *parent = nullptr);
+    ~ComponentsModel();
 
     QVariant data(const QModelIndex &index, int role) const override;
     Qt::ItemFlags flags(const QModelIndex &index) const override;
@@ -92,11 +126,16 @@ public:
     int columnCount(const QModelIndex &parent = QModelIndex()) const override;
 
 private slots:
-    void newComponent(OTP::cid_t cid);
+    void snapshotPublished();
 
 private:
-    std::shared_ptr<class OTP::Consumer> otpConsumer;
+    QModelIndex indexOf(ComponentsItem *item) const;
+
+    std::shared_ptr<ConsumerThread> otpConsumer;
     ComponentsItem *rootItem;
+    QHash<OTP::cid_t, ComponentsItem*> componentItems;
+    class ComponentStatistics *statistics;
+    QVariant statisticsData(const ComponentsItem *item, int column, int role) const;
 
 };
 
@@ -0,0 +1,127 @@
+/*
+    OTPView
+    A QT Frontend for E1.59  (Entertainment  Technology  Object  Transform  Protocol  (OTP))
+    Copyright (C) 2026  Marcus Birkin
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "componentstatistics.h"
+#include <chrono>
+
+using namespace OTP;
+
+ComponentStatistics::ComponentStatistics(
+        std::shared_ptr<class OTP::Consumer> otpConsumer,
+        QObject *parent) : QObject(parent)
+{
+    clock.start();
+
+    // Counted on the consumer's worker thread, synthetic sources have no consumer to count
+    if (otpConsumer)
+    {
+        connect(otpConsumer.get(), &Consumer::updatedPoint, this,
+                [this](cid_t cid) {
+                    auto &counter = counters(cid);
+                    counter.pointUpdates.fetch_add(1, std::memory_order_relaxed);
+                    counter.lastSeen.store(clock.elapsed(), std::memory_order_relaxed);
+                }, Qt::DirectConnection);
+        connect(otpConsumer.get(), &Consumer::newPoint, this,
+                [this](cid_t cid) {
+                    auto &counter = counters(cid);
+                    counter.points.fetch_add(1, std::memory_order_relaxed);
+                    counter.lastSeen.store(clock.elapsed(), std::memory_order_relaxed);
+                }, Qt::DirectConnection);
+        connect(otpConsumer.get(), &Consumer::removedPoint, this,
+                [this](cid_t cid) {
+                    counters(cid).points.fetch_sub(1, std::memory_order_relaxed);
+                }, Qt::DirectConnection);
+        connect(otpConsumer.get(), &Consumer::expiredPoint, this,
+                [this](cid_t cid) {
+                    counters(cid).expiries.fetch_add(1, std::memory_order_relaxed);
+                }, Qt::DirectConnection);
+        connect(otpConsumer.get(), &Consumer::removedComponent, this,
+                [this](const cid_t &cid) { removeCounters(cid); }, Qt::DirectConnection);
+    }
+
+    sampleTimer.setInterval(std::chrono::seconds(1));
+    connect(&sampleTimer, &QTimer::timeout, this, &ComponentStatistics::sample);
+    sampleTimer.start();
+}
+
+ComponentStatistics::counters_t &ComponentStatistics::counters(const OTP::cid_t &cid)
+{
+    // Updates tend to arrive in runs from the same component
+    if (lastCounters && lastCID == cid)
+        return *lastCounters;
+
+    // Only this thread writes the map, reading it here needs no lock
+    auto it = countersMap.constFind(cid);
+    if (it == countersMap.constEnd())
+    {
+        QWriteLocker locker(&countersLock);
+        it = countersMap.insert(cid, std::make_shared<counters_t>());
+    }
+
+    lastCID = cid;
+    lastCounters = it.value().get();
+    return *lastCounters;
+}
+
+void ComponentStatistics::removeCounters(const OTP::cid_t &cid)
+{
+    if (lastCID == cid)
+        lastCounters = nullptr;
+
+    QWriteLocker locker(&countersLock);
+    countersMap.remove(cid);
+}
+
+void ComponentStatistics::sample()
+{
+    const auto now = clock.elapsed();
+    const auto elapsed = now - lastSampleTime;
+    lastSampleTime = now;
+    if (elapsed <= 0) return;
+
+    QReadLocker locker(&countersLock);
+    for (auto it = countersMap.cbegin(); it != countersMap.cend(); ++it)
+    {
+        const auto &counter = *it.value();
+        const auto pointUpdates = counter.pointUpdates.load(std::memory_order_relaxed);
+        const auto lastSeen = counter.lastSeen.load(std::memory_order_relaxed);
+
+        auto &stats = statistics[it.key()];
+        stats.pointUpdatesPerSecond =
+                static_cast<double>(pointUpdates - lastPointUpdates.value(it.key())) * 1000 / elapsed;
+        stats.points = counter.points.load(std::memory_order_relaxed);
+        stats.lastSeenAge = (lastSeen < 0) ? -1 : now - lastSeen;
+        stats.expiries = counter.expiries.load(std::memory_order_relaxed);
+        lastPointUpdates[it.key()] = pointUpdates;
+    }
+
+    // Drop components that have gone away
+    for (auto it = statistics.begin(); it != statistics.end();)
+    {
+        if (countersMap.contains(it.key()))
+        {
+            ++it;
+            continue;
+        }
+        lastPointUpdates.remove(it.key());
+        it = statistics.erase(it);
+    }
+    locker.unlock();
+
+    emit sampled();
+}
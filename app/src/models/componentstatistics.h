@@ -0,0 +1,89 @@
+/*
+    OTPView
+    A QT Frontend for E1.59  (Entertainment  Technology  Object  Transform  Protocol  (OTP))
+    Copyright (C) 2026  Marcus Birkin
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#ifndef COMPONENTSTATISTICS_H
+#define COMPONENTSTATISTICS_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QReadWriteLock>
+#include <QTimer>
+#include <atomic>
+#include <memory>
+#include "OTPLib.hpp"
+
+/*
+ * Per component traffic counters
+ *
+ * Counters are atomics updated directly from the consumer's signals, on the consumer's
+ * worker thread. That thread is the only writer of the CID map, so it looks components up
+ * without locking and only takes the write lock to add or drop one.
+ * Once a second the counters are sampled into rates and ages, which is all the GUI reads
+ */
+class ComponentStatistics : public QObject
+{
+    Q_OBJECT
+public:
+    typedef struct statistics_s
+    {
+        double pointUpdatesPerSecond = 0;
+        qint64 points = 0;
+        qint64 lastSeenAge = -1; // Milliseconds, -1 if never seen
+        quint64 expiries = 0;
+    } statistics_t;
+
+    explicit ComponentStatistics(
+            std::shared_ptr<class OTP::Consumer> otpConsumer,
+            QObject *parent = nullptr);
+
+    statistics_t getStatistics(const OTP::cid_t &cid) const { return statistics.value(cid); }
+
+signals:
+    void sampled();
+
+private slots:
+    void sample();
+
+private:
+    typedef struct counters_s
+    {
+        std::atomic<quint64> pointUpdates = 0;
+        std::atomic<qint64> points = 0;
+        std::atomic<qint64> lastSeen = -1;
+        std::atomic<quint64> expiries = 0;
+    } counters_t;
+    counters_t &counters(const OTP::cid_t &cid);
+    void removeCounters(const OTP::cid_t &cid);
+
+    QElapsedTimer clock;
+    mutable QReadWriteLock countersLock;
+    QHash<OTP::cid_t, std::shared_ptr<counters_t>> countersMap;
+
+    // Last component looked up, consumer worker thread only
+    OTP::cid_t lastCID;
+    counters_t *lastCounters = nullptr;
+
+    // Sampling, GUI thread only
+    QTimer sampleTimer;
+    qint64 lastSampleTime = 0;
+    QHash<OTP::cid_t, quint64> lastPointUpdates;
+    QHash<OTP::cid_t, statistics_t> statistics;
+};
+
+#endif // COMPONENTSTATISTICS_H
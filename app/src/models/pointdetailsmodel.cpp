@@ -0,0 +1,219 @@
+/*
+    OTPView
+    A QT Frontend for E1.59  (Entertainment  Technology  Object  Transform  Protocol  (OTP))
+    Copyright (C) 2026  Marcus Birkin
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "pointdetailsmodel.h"
+#include "producertransaction.h"
+
+using namespace OTP;
+using namespace OTP::MODULES::STANDARD;
+
+PointDetailsModel::PointDetailsModel(
+        std::shared_ptr<ProducerThread> otpProducer,
+        moduleType_t moduleType,
+        QObject *parent) : QAbstractTableModel(parent),
+    otpProducer(otpProducer),
+    moduleType(moduleType)
+{
+    // Values are applied on the producer's pacing tick, some time after setData()
+    connect(otpProducer.get(), &ProducerThread::editsApplied, this, [=]() {
+        if (!isRelative() && getAddress().isValid())
+            emit dataChanged(index(0, 0), index(rowCount() - 1, columnCount() - 1));
+    });
+}
+
+void PointDetailsModel::setAddresses(const QList<OTP::address_t> &value)
+{
+    QList<address_t> newAddresses;
+    for (const auto &address : value)
+        if (address.isValid())
+            newAddresses << address;
+
+    if (addresses == newAddresses) return;
+    const auto relativeChanged = (isRelative() != (newAddresses.count() > 1));
+    addresses = newAddresses;
+    if (relativeChanged)
+        emit headerDataChanged(Qt::Horizontal, 0, columnCount() - 1);
+    emit dataChanged(index(0, 0), index(rowCount() - 1, columnCount() - 1));
+}
+
+OTP::axis_t PointDetailsModel::getAxis(const QModelIndex &index) const
+{
+    return axis_t(index.row());
+}
+
+VALUES::moduleValue_t PointDetailsModel::getModuleValue(const QModelIndex &index) const
+{
+    switch (moduleType)
+    {
+        case Position:
+            switch (index.column())
+            {
+                case 1: return VALUES::POSITION_VELOCITY;
+                case 2: return VALUES::POSITION_ACCELERATION;
+                default: return VALUES::POSITION;
+            }
+
+        case Rotation:
+            switch (index.column())
+            {
+                case 1: return VALUES::ROTATION_VELOCITY;
+                case 2: return VALUES::ROTATION_ACCELERATION;
+                default: return VALUES::ROTATION;
+            }
+
+        case Scale:
+        default:
+            return VALUES::SCALE;
+    }
+}
+
+int PointDetailsModel::rowCount(const QModelIndex &parent) const
+{
+    if (parent.isValid()) return 0;
+    return axis_t::count;
+}
+
+int PointDetailsModel::columnCount(const QModelIndex &parent) const
+{
+    if (parent.isValid()) return 0;
+    return (moduleType == Scale) ? 1 : 3;
+}
+
+QVariant PointDetailsModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || !getAddress().isValid())
+        return QVariant();
+
+    // Relative edits always start from no offset
+    const auto value = isRelative() ? 0 : getValue(getAddress(), getAxis(index), getModuleValue(index));
+
+    switch (role)
+    {
+        case Qt::DisplayRole:
+            return getValueString(getAxis(index), getModuleValue(index), value);
+
+        case Qt::EditRole:
+            return value;
+
+        case Qt::TextAlignmentRole:
+            return QVariant(Qt::AlignRight | Qt::AlignVCenter);
+
+        default:
+            return QVariant();
+    }
+}
+
+bool PointDetailsModel::setData(const QModelIndex &index, const QVariant &value, int role)
+{
+    if (!index.isValid() || !getAddress().isValid() || role != Qt::EditRole)
+        return false;
+
+    bool ok;
+    const auto newValue = value.toLongLong(&ok);
+    if (!ok) return false;
+
+    const auto axis = getAxis(index);
+    const auto moduleValue = getModuleValue(index);
+    ProducerTransaction transaction(otpProducer);
+    if (isRelative())
+    {
+        // Offsets are committed as they're made, closing the editor leaves none
+        if (!newValue) return true;
+        for (const auto &address : qAsConst(addresses))
+            transaction.offsetValue(address, axis, moduleValue, newValue);
+    } else {
+        transaction.setValue(getAddress(), axis, moduleValue, newValue);
+    }
+
+    transaction.commit();
+    return true;
+}
+
+Qt::ItemFlags PointDetailsModel::flags(const QModelIndex &index) const
+{
+    if (!index.isValid())
+        return Qt::NoItemFlags;
+
+    auto ret = QAbstractTableModel::flags(index);
+    if (getAddress().isValid())
+        ret |= Qt::ItemIsEditable;
+    return ret;
+}
+
+QVariant PointDetailsModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (role != Qt::DisplayRole)
+        return QVariant();
+
+    if (orientation == Qt::Vertical)
+    {
+        switch (section)
+        {
+            case axis_t::X: return QString("X");
+            case axis_t::Y: return QString("Y");
+            case axis_t::Z: return QString("Z");
+            default: return QVariant();
+        }
+    }
+
+    QString header;
+    if (moduleType == Scale)
+        header = tr("Scale");
+    else
+        switch (section)
+        {
+            case 0: header = tr("Value"); break;
+            case 1: header = tr("Velocity"); break;
+            case 2: header = tr("Acceleration"); break;
+            default: return QVariant();
+        }
+
+    if (isRelative())
+        header.append(tr(" (Offset)"));
+    return header;
+}
+
+qint64 PointDetailsModel::getValue(address_t address, axis_t axis, VALUES::moduleValue_t moduleValue) const
+{
+    return ProducerTransaction::getValue(otpProducer, address, axis, moduleValue);
+}
+
+QString PointDetailsModel::getValueString(axis_t axis, VALUES::moduleValue_t moduleValue, qint64 value) const
+{
+    const auto prefix = (isRelative() && value >= 0) ? QString("+") : QString();
+    const auto producer = otpProducer->read();
+    switch (moduleValue) {
+        case VALUES::SCALE:
+            return QString("%1%2 %").arg(
+                        prefix,
+                        ScaleModule_t::toPercentString(static_cast<ScaleModule_t::scale_t>(value)));
+        case VALUES::POSITION:
+            return QString("%1%2 %3").arg(
+                        prefix,
+                        QString::number(value),
+                        producer->getUnitString(
+                            producer->getLocalPosition(getAddress(), axis).scale,
+                            moduleValue));
+        default:
+            return QString("%1%2 %3").arg(
+                        prefix,
+                        QString::number(value),
+                        producer->getUnitString(
+                            moduleValue));
+    }
+}
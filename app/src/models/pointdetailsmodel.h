@@ -0,0 +1,76 @@
+/*
+    OTPView
+    A QT Frontend for E1.59  (Entertainment  Technology  Object  Transform  Protocol  (OTP))
+    Copyright (C) 2026  Marcus Birkin
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#ifndef POINTDETAILSMODEL_H
+#define POINTDETAILSMODEL_H
+
+#include <QAbstractTableModel>
+#include "OTPLib.hpp"
+#include "producerthread.h"
+
+/*
+ * Axis values of producer points, one row per axis
+ *
+ * Reads are always taken straight from the producer, so selecting a different
+ * address never writes anything back; only setData() modifies the producer
+ *
+ * With a single address values are absolute, with several addresses
+ * the model is relative and setData() offsets every address by the given delta
+ */
+class PointDetailsModel : public QAbstractTableModel
+{
+    Q_OBJECT
+public:
+    typedef enum moduleType_e
+    {
+        Position,
+        Rotation,
+        Scale
+    } moduleType_t;
+
+    explicit PointDetailsModel(
+            std::shared_ptr<ProducerThread> otpProducer,
+            moduleType_t moduleType,
+            QObject *parent = nullptr);
+
+    void setAddress(OTP::address_t value) { setAddresses({value}); }
+    void setAddresses(const QList<OTP::address_t> &value);
+    OTP::address_t getAddress() const { return addresses.value(0); }
+    bool isRelative() const { return addresses.count() > 1; }
+
+    OTP::axis_t getAxis(const QModelIndex &index) const;
+    OTP::MODULES::STANDARD::VALUES::moduleValue_t getModuleValue(const QModelIndex &index) const;
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    bool setData(const QModelIndex &index, const QVariant &value, int role = Qt::EditRole) override;
+    Qt::ItemFlags flags(const QModelIndex &index) const override;
+
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+private:
+    qint64 getValue(OTP::address_t address, OTP::axis_t axis, OTP::MODULES::STANDARD::VALUES::moduleValue_t moduleValue) const;
+    QString getValueString(OTP::axis_t axis, OTP::MODULES::STANDARD::VALUES::moduleValue_t moduleValue, qint64 value) const;
+
+    std::shared_ptr<ProducerThread> otpProducer;
+    moduleType_t moduleType;
+    QList<OTP::address_t> addresses;
+};
+
+#endif // POINTDETAILSMODEL_H
@@ -19,11 +19,12 @@
 
 #include "pointstablemodel.h"
 #include <QDebug>
+#include <algorithm>
 
 using namespace OTP;
 
 PointsTableModel::PointsTableModel(
-        std::shared_ptr<class OTP::Producer> otpProducer,
+        std::shared_ptr<ProducerThread> otpProducer,
         OTP::system_t system,
         OTP::group_t group,
         QObject *parent) : QAbstractTableModel(parent),
@@ -31,28 +32,82 @@ PointsTableModel::PointsTableModel(
     system(system),
     group(group)
 {
-    connect(otpProducer.get(), &Producer::newPoint, this, [=](cid_t, system_t system, group_t group, point_t point)
+    // Point changes arrive one at a time, so they're collected and the
+    // sorted point list is only rebuilt once control returns to the event loop
+    connect(otpProducer.get(), &ProducerThread::newPoint, this, [=](cid_t, system_t system, group_t group, point_t)
     {
-        if (system == this->system && group == this->group) {
-            auto row = otpProducer->getLocalPoints(system, group).indexOf(point);
-            beginInsertRows(QModelIndex(), row, row);
-            endInsertRows();
-        }
+        if (system == this->system && group == this->group)
+            scheduleRefresh();
     });
-    connect(otpProducer.get(), &Producer::removedPoint, this, [=]() { emit layoutChanged(); });
+    connect(otpProducer.get(), &ProducerThread::removedPoint, this, [=]() { scheduleRefresh(); });
+
+    points = otpProducer->read()->getLocalPoints(system, group);
+    std::sort(points.begin(), points.end());
+}
+
+void PointsTableModel::setGroup(OTP::group_t value)
+{
+    beginResetModel();
+    group = value;
+    points = otpProducer->read()->getLocalPoints(system, group);
+    std::sort(points.begin(), points.end());
+    endResetModel();
+}
+
+void PointsTableModel::setSystem(OTP::system_t value)
+{
+    beginResetModel();
+    system = value;
+    points = otpProducer->read()->getLocalPoints(system, group);
+    std::sort(points.begin(), points.end());
+    endResetModel();
+}
+
+void PointsTableModel::scheduleRefresh()
+{
+    if (refreshPending) return;
+    refreshPending = true;
+    QMetaObject::invokeMethod(this, &PointsTableModel::refresh, Qt::QueuedConnection);
+}
+
+void PointsTableModel::refresh()
+{
+    refreshPending = false;
+
+    auto newPoints = otpProducer->read()->getLocalPoints(system, group);
+    std::sort(newPoints.begin(), newPoints.end());
+    if (newPoints == points) return;
+
+    // A single added or removed point is reported as such, so views can follow it
+    const auto mismatch = std::mismatch(points.cbegin(), points.cend(), newPoints.cbegin(), newPoints.cend());
+    const auto row = static_cast<int>(std::distance(points.cbegin(), mismatch.first));
+    if ((newPoints.count() == points.count() + 1)
+            && std::equal(mismatch.first, points.cend(), std::next(mismatch.second)))
+    {
+        beginInsertRows(QModelIndex(), row, row);
+        points = newPoints;
+        endInsertRows();
+    } else if ((newPoints.count() + 1 == points.count())
+               && std::equal(std::next(mismatch.first), points.cend(), mismatch.second)) {
+        beginRemoveRows(QModelIndex(), row, row);
+        points = newPoints;
+        endRemoveRows();
+    } else {
+        beginResetModel();
+        points = newPoints;
+        endResetModel();
+    }
 }
 
 OTP::address_t PointsTableModel::getAddress(const QModelIndex &index) const
 {
-    if (index.row() > rowCount(index)) return address_t();
-    auto pointList = otpProducer->getLocalPoints(system, group);
-    std::sort(pointList.begin(), pointList.end());
-    return address_t(system, group, pointList.at(index.row()));
+    if (index.row() < 0 || index.row() >= points.count()) return address_t();
+    return address_t(system, group, points.at(index.row()));
 }
 
 int PointsTableModel::rowCount(const QModelIndex & /*parent*/) const
 {
-    return otpProducer->getLocalPoints(system, group).count();
+    return points.count();
 }
 
 int PointsTableModel::columnCount(const QModelIndex & /*parent*/) const
@@ -62,7 +117,7 @@ int PointsTableModel::columnCount(const QModelIndex & /*parent*/) const
 
 QVariant PointsTableModel::data(const QModelIndex &index, int role) const
 {
-    if (index.row() > rowCount(index)) return QVariant();
+    if (!getAddress(index).isValid()) return QVariant();
     if (role == Qt::DisplayRole)
     {
         return QString("%1/%2/%3")
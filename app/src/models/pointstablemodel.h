@@ -21,18 +21,19 @@
 
 #include <QAbstractTableModel>
 #include "OTPLib.hpp"
+#include "producerthread.h"
 
 class PointsTableModel : public QAbstractTableModel
 {
     Q_OBJECT
 public:
     explicit PointsTableModel(
-            std::shared_ptr<class OTP::Producer> otpProducer,
+            std::shared_ptr<ProducerThread> otpProducer,
             OTP::system_t system,
             OTP::group_t group,
             QObject *parent);
-    void setGroup(OTP::group_t value) { group = value; }
-    void setSystem(OTP::system_t value) { system = value; }
+    void setGroup(OTP::group_t value);
+    void setSystem(OTP::system_t value);
 
     OTP::address_t getAddress(const QModelIndex &index) const;
 
@@ -42,8 +43,16 @@ public:
 
     QVariant headerData(int section, Qt::Orientation orientation, int role) const;
 
+public slots:
+    void refresh();
+
 private:
-    std::shared_ptr<class OTP::Producer> otpProducer;
+    void scheduleRefresh();
+    bool refreshPending = false;
+
+    QList<OTP::point_t> points; // Sorted
+
+    std::shared_ptr<ProducerThread> otpProducer;
     OTP::system_t system;
     OTP::group_t group;
 };
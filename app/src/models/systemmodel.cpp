@@ -17,6 +17,8 @@
     along with this program.  If not, see <https://www.gnu.org/licenses/>.
 */
 #include "systemmodel.h"
+#include "metrics.h"
+#include "profiler.h"
 #include "settings.h"
 #include <QFont>
 #include <QColor>
@@ -31,7 +33,7 @@ static QFont italic()
 }
 
 SystemItem::SystemItem(
-        std::shared_ptr<class Consumer> otpConsumer,
+        std::shared_ptr<ConsumerThread> otpConsumer,
         address_t address,
         itemType_t type,
         SystemItem *parentItem)
@@ -100,13 +102,17 @@ QString SystemItem::getValueString() const
     if (axis == -1) axis = getAxis(this->parentItem()->getType());
     if (axis == -1) return QString("???");
 
-    auto position = otpConsumer->getPosition(getAddress(), axis_t(axis));
-    auto positionVelocity = otpConsumer->getPositionVelocity(getAddress(), axis_t(axis));
-    auto positionAccel = otpConsumer->getPositionAcceleration(getAddress(), axis_t(axis));
-    auto rotation = otpConsumer->getRotation(getAddress(), axis_t(axis));
-    auto rotationVelocity = otpConsumer->getRotationVelocity(getAddress(), axis_t(axis));
-    auto rotationAccel = otpConsumer->getRotationAcceleration(getAddress(), axis_t(axis));
-    auto scale = otpConsumer->getScale(getAddress(), axis_t(axis));
+    const auto pointValues = getPointValues();
+    if (!pointValues) return QString();
+    const auto &axisValues = pointValues->axes[axis];
+    const auto &position = axisValues.position;
+    const auto &positionVelocity = axisValues.positionVelocity;
+    const auto &positionAccel = axisValues.positionAcceleration;
+    const auto &rotation = axisValues.rotation;
+    const auto &rotationVelocity = axisValues.rotationVelocity;
+    const auto &rotationAccel = axisValues.rotationAcceleration;
+    const auto &scale = axisValues.scale;
+    const auto derived = [](bool isDerived) { return isDerived ? QStringLiteral(" (derived)") : QString(); };
 
     switch (type)
     {
@@ -167,14 +173,16 @@ QString SystemItem::getValueString() const
                         .arg(position.unit);
 
                 case SystemPointPositionVelcocityItem:
-                    return QString("%1 %2")
+                    return QString("%1 %2%3")
                         .arg(positionVelocity.value)
-                        .arg(positionVelocity.unit);
+                        .arg(positionVelocity.unit)
+                        .arg(derived(axisValues.positionVelocityDerived));
 
                 case SystemPointPositionAccelItem:
-                    return QString("%1 %2")
+                    return QString("%1 %2%3")
                             .arg(positionAccel.value)
-                            .arg(positionAccel.unit);
+                            .arg(positionAccel.unit)
+                            .arg(derived(axisValues.positionAccelerationDerived));
 
                 case SystemPointRotationValueItem:
                     return QString("%1 %2")
@@ -182,14 +190,16 @@ QString SystemItem::getValueString() const
                             .arg(rotation.unit);
 
                 case SystemPointRotationVelcocityItem:
-                    return QString("%1 %2")
+                    return QString("%1 %2%3")
                             .arg(rotationVelocity.value)
-                            .arg(rotationVelocity.unit);
+                            .arg(rotationVelocity.unit)
+                            .arg(derived(axisValues.rotationVelocityDerived));
 
                 case SystemPointRotationAccelItem:
-                    return QString("%1 %2")
+                    return QString("%1 %2%3")
                             .arg(rotationAccel.value)
-                            .arg(rotationAccel.unit);
+                            .arg(rotationAccel.unit)
+                            .arg(derived(axisValues.rotationAccelerationDerived));
 
                 case SystemPointScaleItem:
                     return QString("%1 (%2)")
@@ -204,7 +214,7 @@ QString SystemItem::getValueString() const
     }
 }
 
-QString getOtherValuesStringHelper(QMap<cid_t, Consumer::Scale_t> container)
+QString getOtherValuesStringHelper(const QMap<cid_t, Consumer::Scale_t> &container)
 {
     QString ret = "Other sources";
 
@@ -222,7 +232,7 @@ QString getOtherValuesStringHelper(QMap<cid_t, Consumer::Scale_t> container)
 }
 
 template <class T>
-QString getOtherValuesStringHelper(T container)
+QString getOtherValuesStringHelper(const T &container)
 {
     QString ret = "Other sources";
 
@@ -246,6 +256,10 @@ QString SystemItem::getOtherValuesString() const
     if (axis == -1) axis = getAxis(this->parentItem()->getType());
     if (axis == -1) return QString("???");
 
+    const auto pointValues = getPointValues();
+    if (!pointValues) return QString();
+    const auto &axisValues = pointValues->axes[axis];
+
     switch (type)
     {
         case SystemPointAxis_X:
@@ -255,25 +269,25 @@ QString SystemItem::getOtherValuesString() const
             switch (this->parentItem()->getType())
             {
                 case SystemPointPositionValueItem:
-                    return getOtherValuesStringHelper(otpConsumer->getPositions(getAddress(), axis_t(axis), true, true));
+                    return getOtherValuesStringHelper(axisValues.positions);
 
                 case SystemPointPositionVelcocityItem:
-                    return getOtherValuesStringHelper(otpConsumer->getPositionVelocitys(getAddress(), axis_t(axis), true, true));
+                    return getOtherValuesStringHelper(axisValues.positionVelocitys);
 
                 case SystemPointPositionAccelItem:
-                    return getOtherValuesStringHelper(otpConsumer->getPositionAccelerations(getAddress(), axis_t(axis), true, true));
+                    return getOtherValuesStringHelper(axisValues.positionAccelerations);
 
                 case SystemPointRotationValueItem:
-                    return getOtherValuesStringHelper(otpConsumer->getRotations(getAddress(), axis_t(axis), true, true));
+                    return getOtherValuesStringHelper(axisValues.rotations);
 
                 case SystemPointRotationVelcocityItem:
-                    return getOtherValuesStringHelper(otpConsumer->getRotationVelocitys(getAddress(), axis_t(axis), true, true));
+                    return getOtherValuesStringHelper(axisValues.rotationVelocitys);
 
                 case SystemPointRotationAccelItem:
-                    return getOtherValuesStringHelper(otpConsumer->getRotationAccelerations(getAddress(), axis_t(axis), true, true));
+                    return getOtherValuesStringHelper(axisValues.rotationAccelerations);
 
                 case SystemPointScaleItem:
-                    return getOtherValuesStringHelper(otpConsumer->getScales(getAddress(), axis_t(axis), true));
+                    return getOtherValuesStringHelper(axisValues.scales);
 
                 default: return QString("");
             }
@@ -302,7 +316,7 @@ QVariant SystemItem::data(int column, int role) const
         // Group
         case SystemGroupItem:
             if (role == Qt::DisplayRole && column == columnFirst) return QString("Group %1").arg(getGroup());
-            if (otpConsumer->isGroupExpired(getSystem(), getGroup()))
+            if (otpConsumer->snapshot()->isGroupExpired(getSystem(), getGroup()))
             {
                 if (role == Qt::DisplayRole && column == columnDetails) return QString("(Expired)");
                 if (role == Qt::FontRole) return italic();
@@ -312,7 +326,7 @@ QVariant SystemItem::data(int column, int role) const
         // Point
         case SystemPointItem:
             if (role == Qt::DisplayRole && column == columnFirst) return QString("Point %1").arg(getPoint());
-            if (otpConsumer->isPointExpired(getSystem(), getGroup(), getPoint()))
+            if (isPointExpired())
             {
                 if (role == Qt::DisplayRole && column == columnDetails) return QString("(Expired)");
                 if (role == Qt::FontRole) return italic();
@@ -322,7 +336,7 @@ QVariant SystemItem::data(int column, int role) const
         // Point Details
         case SystemPointDetailsItem:
             if (role == Qt::DisplayRole && column == columnFirst) return QString("Details");
-            if (otpConsumer->isPointExpired(getSystem(), getGroup(), getPoint()))
+            if (isPointExpired())
             {
                 if (role == Qt::DisplayRole && column == columnDetails) return QString("(Expired)");
                 if (role == Qt::FontRole) return italic();
@@ -333,10 +347,10 @@ QVariant SystemItem::data(int column, int role) const
                 switch (column)
                 {
                     case columnFirst: return QString("Name");
-                    case columnDetails: return otpConsumer->getPointName(getAddress());
+                    case columnDetails: return getPointValues() ? getPointValues()->name : QString();
                     default: return QString("???");
                 }
-            if (otpConsumer->isPointExpired(getSystem(), getGroup(), getPoint()))
+            if (isPointExpired())
             {
                 if (role == Qt::FontRole) return italic();
             }
@@ -346,10 +360,10 @@ QVariant SystemItem::data(int column, int role) const
                 switch (column)
                 {
                     case columnFirst: return QString("Last Seen");
-                    case columnDetails: return otpConsumer->getPointLastSeen(getAddress()).toString(Qt::DateFormat::ISODateWithMs);
+                    case columnDetails: return getPointValues() ? getPointValues()->lastSeen.toString(Qt::DateFormat::ISODateWithMs) : QString();
                     default: return QString("???");
                 }
-            if (otpConsumer->isPointExpired(getSystem(), getGroup(), getPoint()))
+            if (isPointExpired())
             {
                 if (role == Qt::FontRole) return italic();
                 if (role == Qt::BackgroundRole) return QColor(Qt::red);
@@ -360,10 +374,10 @@ QVariant SystemItem::data(int column, int role) const
                 switch (column)
                 {
                     case columnFirst: return QString("Reference Frame");
-                    case columnDetails: return otpConsumer->getReferenceFrame(getAddress()).value.toString();
+                    case columnDetails: return getPointValues() ? getPointValues()->referenceFrame : QString();
                     default: return QString("???");
                 }
-            if (otpConsumer->isPointExpired(getSystem(), getGroup(), getPoint()))
+            if (isPointExpired())
             {
                 if (role == Qt::FontRole) return italic();
             }
@@ -449,6 +463,17 @@ QVariant SystemItem::data(int column, int role) const
     return QVariant();
 }
 
+std::shared_ptr<const ConsumerSnapshot::pointValues_t> SystemItem::getPointValues() const
+{
+    return otpConsumer->snapshot()->point(getAddress());
+}
+
+bool SystemItem::isPointExpired() const
+{
+    const auto pointValues = getPointValues();
+    return !pointValues || pointValues->expired;
+}
+
 SystemItem *SystemItem::parentItem() const
 {
     return qobject_cast<SystemItem*>(parent());
@@ -465,7 +490,7 @@ int SystemItem::row() const
 }
 
 SystemModel::SystemModel(
-        std::shared_ptr<class Consumer> otpConsumer,
+        std::shared_ptr<ConsumerThread> otpConsumer,
         system_t system,
         QObject *parent)
     : QAbstractItemModel(parent),
@@ -473,26 +498,8 @@ SystemModel::SystemModel(
 {
     rootItem = new SystemItem(otpConsumer, address_t(system, group_t(), point_t()));
 
-    /* Groups */
-    // On new/removed groups
-    connect(otpConsumer.get(), &Consumer::newGroup, this, &SystemModel::newGroup);
-    connect(otpConsumer.get(), &Consumer::removedGroup, this, &SystemModel::removedGroup);
-
-    // Add existing
-    for (const auto &group : otpConsumer->getGroups(system))
-        newGroup(cid_t(), system, group);
-
-    /* Points */
-    // On new/removed/updated points
-    connect(otpConsumer.get(), &Consumer::newPoint, this, &SystemModel::newPoint);
-    connect(otpConsumer.get(), &Consumer::removedPoint, this, &SystemModel::removedPoint);
-    connect(otpConsumer.get(), &Consumer::updatedPoint, this, &SystemModel::updatedPoint);
-    connect(otpConsumer.get(), &Consumer::expiredPoint, this, &SystemModel::updatedPoint);
-
-    // Add existing
-    for (const auto &group : otpConsumer->getGroups(system))
-        for (const auto &point : otpConsumer->getPoints(system, group))
-            newPoint(cid_t(), system, group, point);
+    connect(otpConsumer.get(), &ConsumerThread::snapshotPublished, this, &SystemModel::snapshotPublished);
+    snapshotPublished();
 }
 
 SystemModel::~SystemModel()
@@ -652,13 +659,60 @@ SystemItem *SystemModel::item(address_t address, SystemItem::itemType_t type) co
     return nullptr;
 }
 
-void SystemModel::newGroup(cid_t cid, system_t system, group_t group)
+void SystemModel::snapshotPublished()
+{
+    const ProfileScope profile("SystemModel::snapshotPublished");
+    const auto snapshot = otpConsumer->snapshot();
+    const auto system = rootItem->getSystem();
+    const auto current = snapshot->systems.value(system);
+
+    // Removed groups and points
+    for (auto group = systemValues.cbegin(); group != systemValues.cend(); ++group)
+    {
+        const auto currentGroup = current.constFind(group.key());
+        if (currentGroup == current.cend())
+        {
+            removedGroup(system, group.key());
+            continue;
+        }
+        for (auto point = group->points.cbegin(); point != group->points.cend(); ++point)
+            if (!currentGroup->points.contains(point.key()))
+                removedPoint(system, group.key(), point.key());
+    }
+
+    // New and updated groups and points, unchanged points share their values with the previous snapshot
+    for (auto group = current.cbegin(); group != current.cend(); ++group)
+    {
+        const auto previousGroup = systemValues.constFind(group.key());
+        const auto isNewGroup = (previousGroup == systemValues.cend());
+        if (isNewGroup)
+            newGroup(system, group.key());
+        else if (previousGroup->expired != group->expired)
+            updatedGroup(system, group.key());
+
+        for (auto point = group->points.cbegin(); point != group->points.cend(); ++point)
+        {
+            const auto previousPoint = isNewGroup
+                    ? std::shared_ptr<const ConsumerSnapshot::pointValues_t>()
+                    : previousGroup->points.value(point.key());
+            if (!previousPoint)
+                newPoint(system, group.key(), point.key());
+            else if (previousPoint != point.value())
+                updatedPoint(system, group.key(), point.key());
+        }
+    }
+
+    systemValues = current;
+
+    static auto &updateLatency = Metrics::getInstance().histogram(QStringLiteral("GUI system model update latency"));
+    updateLatency.record(Metrics::microsecondsSince(snapshot->publishedAt));
+}
+
+void SystemModel::newGroup(system_t system, group_t group)
 {
-    Q_UNUSED(cid)
     auto address = address_t(system, group, point_t());
     auto rootItem = item(address, SystemItem::SystemRootItem);
     if (!rootItem) return;
-    if (system != rootItem->getSystem()) return;
     auto rootIndex = index(address, SystemItem::SystemRootItem);
 
     if (rootItem->containsChildKey(group)) return;
@@ -672,30 +726,32 @@ void SystemModel::newGroup(cid_t cid, system_t system, group_t group)
     endInsertRows();
 }
 
-void SystemModel::removedGroup(cid_t cid, system_t system, group_t group)
+void SystemModel::removedGroup(system_t system, group_t group)
 {
-    Q_UNUSED(cid)
     auto address = address_t(system, group, point_t());
     auto rootItem = item(address, SystemItem::SystemRootItem);
     if (!rootItem) return;
-    if (system != rootItem->getSystem()) return;
+    auto groupItem = item(address, SystemItem::SystemGroupItem);
+    if (!groupItem) return;
     auto rootIndex = index(address, SystemItem::SystemRootItem);
 
-    auto oldRow = 0;
-    for (; oldRow < rowCount(rootIndex); ++oldRow)
-        if (item(address, SystemItem::SystemRootItem)->child(oldRow - 1)->getGroup() == group) break;
+    const auto oldRow = groupItem->row();
     beginRemoveRows(rootIndex, oldRow, oldRow);
     rootItem->removeChild(group);
     endRemoveRows();
+    groupItem->deleteLater();
 }
 
-void SystemModel::newPoint(cid_t cid, system_t system, group_t group, point_t point)
+void SystemModel::updatedGroup(system_t system, group_t group)
+{
+    auto groupIndex = index(address_t(system, group, point_t()), SystemItem::SystemGroupItem);
+    if (!groupIndex.isValid()) return;
+    emit dataChanged(groupIndex.siblingAtColumn(0), groupIndex.siblingAtColumn(columnCount(groupIndex.parent()) - 1));
+}
+
+void SystemModel::newPoint(system_t system, group_t group, point_t point)
 {
-    Q_UNUSED(cid)
     auto address = address_t(system, group, point);
-    auto rootItem = item(address, SystemItem::SystemRootItem);
-    if (!rootItem) return;
-    if (system != rootItem->getSystem()) return;
     auto groupItem = item(address, SystemItem::SystemGroupItem);
     if (!groupItem) return;
     auto groupIndex = index(address, SystemItem::SystemGroupItem);
@@ -716,39 +772,29 @@ void SystemModel::newPoint(cid_t cid, system_t system, group_t group, point_t po
     endInsertRows();
 }
 
-void SystemModel::removedPoint(cid_t cid, system_t system, group_t group, point_t point)
+void SystemModel::removedPoint(system_t system, group_t group, point_t point)
 {
-    Q_UNUSED(cid)
     auto address = address_t(system, group, point);
-    auto rootItem = item(address, SystemItem::SystemRootItem);
-    if (!rootItem) return;
-    if (system != rootItem->getSystem()) return;
     auto groupItem = item(address, SystemItem::SystemGroupItem);
     if (!groupItem) return;
+    auto pointItem = item(address, SystemItem::SystemPointItem);
+    if (!pointItem) return;
     auto groupIndex = index(address, SystemItem::SystemGroupItem);
     if (!groupIndex.isValid()) return;
 
-    auto oldRow = 0;
-    for (; oldRow < rowCount(groupIndex); ++oldRow)
-        if (groupItem->child(oldRow - 1)->getPoint() == point) break;
+    const auto oldRow = pointItem->row();
     beginRemoveRows(groupIndex, oldRow, oldRow);
     groupItem->removeChild(static_cast<SystemItem::key_t>(point));
     endRemoveRows();
+    pointItem->deleteLater();
 }
 
-void SystemModel::updatedPoint(cid_t cid, system_t system, group_t group, point_t point)
+void SystemModel::updatedPoint(system_t system, group_t group, point_t point)
 {
-    Q_UNUSED(cid)
-    auto address = address_t(system, group, point);
-    auto rootItem = item(address, SystemItem::SystemRootItem);
-    if (!rootItem) return;
-    if (system != rootItem->getSystem()) return;
-    auto startIndex = index(address, SystemItem::SystemPointItem);
-    if (!startIndex.isValid()) return;
-    auto startItem = item(address, SystemItem::SystemPointItem);
-    if (!startItem) return;
-    auto endIndex = startIndex.siblingAtRow(startItem->childCount() - 1);
-    emit dataChanged(startIndex, endIndex);
+    auto pointIndex = index(address_t(system, group, point), SystemItem::SystemPointItem);
+    if (!pointIndex.isValid()) return;
+    // Spans the whole row, so views repaint the point's expanded details as well
+    emit dataChanged(pointIndex.siblingAtColumn(0), pointIndex.siblingAtColumn(columnCount(pointIndex.parent()) - 1));
 }
 
 void SystemModel::newPointDetails(SystemItem *parent)
@@ -20,6 +20,7 @@
 #define SYSTEMMODEL_H
 #include <QAbstractItemModel>
 #include "OTPLib.hpp"
+#include "consumerthread.h"
 
 class SystemItem : public QObject
 {
@@ -78,7 +79,7 @@ public:
         SystemPointAxisDetails_Last = SystemPointAxisDetails_Timestamp,
     } itemType_t;
 
-    explicit SystemItem(std::shared_ptr<class OTP::Consumer> otpConsumer,
+    explicit SystemItem(std::shared_ptr<ConsumerThread> otpConsumer,
             OTP::address_t address = OTP::address_t(),
             itemType_t type = SystemRootItem,
             SystemItem *parentItem = nullptr);
@@ -110,8 +111,10 @@ public:
 private:
     QString getValueString() const;
     QString getOtherValuesString() const;
+    std::shared_ptr<const ConsumerSnapshot::pointValues_t> getPointValues() const;
+    bool isPointExpired() const;
 
-    std::shared_ptr<class OTP::Consumer> otpConsumer;
+    std::shared_ptr<ConsumerThread> otpConsumer;
     OTP::address_t address;
     itemType_t type;
 
@@ -131,7 +134,7 @@ class SystemModel : public QAbstractItemModel
 
 public:
     explicit SystemModel(
-            std::shared_ptr<class OTP::Consumer> otpConsumer,
+            std::shared_ptr<ConsumerThread> otpConsumer,
             OTP::system_t system,
             QObject *parent = nullptr);
      ~SystemModel() override;
@@ -147,24 +150,28 @@ public:
     int columnCount(const QModelIndex &parent = QModelIndex()) const override;
 
 private slots:
-    void newGroup(OTP::cid_t, OTP::system_t, OTP::group_t);
-    void removedGroup(OTP::cid_t, OTP::system_t, OTP::group_t);
+    void snapshotPublished();
 
-    void newPoint(OTP::cid_t, OTP::system_t, OTP::group_t, OTP::point_t);
-    void removedPoint(OTP::cid_t, OTP::system_t, OTP::group_t, OTP::point_t);
-    void updatedPoint(OTP::cid_t, OTP::system_t, OTP::group_t, OTP::point_t);
+private:
+    void newGroup(OTP::system_t, OTP::group_t);
+    void removedGroup(OTP::system_t, OTP::group_t);
+    void updatedGroup(OTP::system_t, OTP::group_t);
+
+    void newPoint(OTP::system_t, OTP::group_t, OTP::point_t);
+    void removedPoint(OTP::system_t, OTP::group_t, OTP::point_t);
+    void updatedPoint(OTP::system_t, OTP::group_t, OTP::point_t);
 
     void newPointDetails(SystemItem *parent);
     void newPointPosition(SystemItem *parent);
     void newPointRotation(SystemItem *parent);
     void newPointScale(SystemItem *parent);
 
-private:
     QModelIndex index(OTP::address_t, SystemItem::itemType_t) const;
     SystemItem *item(OTP::address_t, SystemItem::itemType_t) const;
 
-    std::shared_ptr<class OTP::Consumer> otpConsumer;
+    std::shared_ptr<ConsumerThread> otpConsumer;
     SystemItem *rootItem;
+    ConsumerSnapshot::systemValues_t systemValues; // As last shown
 };
 
 #endif // SYSTEMMODEL_H
@@ -0,0 +1,195 @@
+/*
+    OTPView
+    A QT Frontend for E1.59  (Entertainment  Technology  Object  Transform  Protocol  (OTP))
+    Copyright (C) 2026  Marcus Birkin
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "motionfilter.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+    constexpr double Pi = 3.14159265358979323846;
+    constexpr double NanosecondsPerSecond = 1e9;
+
+    // Time constant of a first order low pass
+    inline double timeConstant(double cutoff) { return 1.0 / (2.0 * Pi * cutoff); }
+}
+
+MotionFilter::MotionFilter(mode_t mode, const std::vector<channel_t> &channels) :
+    mode(mode),
+    channels(channels),
+    measurement(channels.size()),
+    estimate(channels.size()),
+    rate(channels.size()),
+    p00(channels.size()),
+    p01(channels.size()),
+    p11(channels.size())
+{}
+
+int MotionFilter::addPoint(const parameters_t &parameters)
+{
+    int slot;
+    if (!freeSlots.empty())
+    {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+    } else {
+        for (auto *perChannel : {&measurement, &estimate, &rate, &p00, &p01, &p11})
+            for (auto &values : *perChannel)
+                values.push_back(0);
+        for (auto *perSlot : {&minCutoff, &beta, &derivativeCutoff, &measurementNoise, &processNoise,
+                              &interval, &sampled})
+            perSlot->push_back(0);
+        lastTime.push_back(0);
+        started.push_back(0);
+        slot = getSlotCount() - 1;
+    }
+
+    setParameters(slot, parameters);
+    return slot;
+}
+
+void MotionFilter::removePoint(int slot)
+{
+    started[slot] = 0;
+    interval[slot] = 0;
+    sampled[slot] = 0;
+    starting.erase(std::remove(starting.begin(), starting.end(), slot), starting.end());
+    freeSlots.push_back(slot);
+}
+
+void MotionFilter::setParameters(int slot, const parameters_t &parameters)
+{
+    minCutoff[slot] = parameters.minCutoff;
+    beta[slot] = parameters.beta;
+    derivativeCutoff[slot] = parameters.derivativeCutoff;
+    measurementNoise[slot] = parameters.measurementNoise;
+    processNoise[slot] = parameters.processNoise;
+}
+
+void MotionFilter::beginSample(int slot, qint64 time)
+{
+    if (!started[slot])
+    {
+        // Nothing to filter against yet, filter() starts from the measurement
+        if (std::find(starting.cbegin(), starting.cend(), slot) == starting.cend())
+            starting.push_back(slot);
+    } else {
+        interval[slot] = static_cast<double>(std::max<qint64>(time - lastTime[slot], 0)) / NanosecondsPerSecond;
+        sampled[slot] = 1;
+    }
+    lastTime[slot] = time;
+}
+
+void MotionFilter::filter()
+{
+    const auto count = lastTime.size();
+
+    // Per slot terms shared by every channel, unsampled slots have no interval so nothing moves
+    speedFactor.resize(count);
+    derivativeAlpha.resize(count);
+    for (size_t slot = 0; slot < count; ++slot)
+    {
+        speedFactor[slot] = sampled[slot] / std::max(interval[slot], 1e-9);
+        derivativeAlpha[slot] = interval[slot] / (interval[slot] + timeConstant(derivativeCutoff[slot]));
+    }
+
+    // Plain loops over contiguous arrays, left for the compiler to vectorise.
+    // Estimates and measurements are both within the wrap, so one step corrects a difference
+    for (size_t channel = 0; channel < channels.size(); ++channel)
+    {
+        const auto unit = channels[channel].unit;
+        const auto inverseUnit = 1.0 / unit;
+        const auto span = channels[channel].wrapSpan;
+        const auto half = span > 0 ? span / 2 : std::numeric_limits<double>::infinity();
+        const auto minimum = channels[channel].minimum;
+        const auto *m = measurement[channel].data();
+        auto *x = estimate[channel].data();
+        auto *v = rate[channel].data();
+        const auto *dt = interval.data();
+
+        if (mode == OneEuro)
+        {
+            const auto *speedScale = speedFactor.data();
+            const auto *dAlpha = derivativeAlpha.data();
+            for (size_t slot = 0; slot < count; ++slot)
+            {
+                const auto difference = m[slot] - x[slot];
+                const auto innovation = difference
+                        - span * (static_cast<double>(difference > half) - static_cast<double>(difference < -half));
+                v[slot] += dAlpha[slot] * (innovation * speedScale[slot] - v[slot]);
+                const auto cutoff = minCutoff[slot] + beta[slot] * std::abs(v[slot]) * inverseUnit;
+                const auto k = 2.0 * Pi * cutoff * dt[slot];
+                x[slot] += k / (k + 1.0) * innovation;
+            }
+        } else {
+            const auto unitSquared = unit * unit;
+            const auto *mask = sampled.data();
+            auto *c00 = p00[channel].data();
+            auto *c01 = p01[channel].data();
+            auto *c11 = p11[channel].data();
+            for (size_t slot = 0; slot < count; ++slot)
+            {
+                // Predict, with white noise acceleration
+                const auto t = dt[slot];
+                const auto q = processNoise[slot] * processNoise[slot] * unitSquared;
+                x[slot] += v[slot] * t;
+                c00[slot] += t * (2.0 * c01[slot] + t * c11[slot]) + q * t * t * t * t * 0.25;
+                c01[slot] += t * c11[slot] + q * t * t * t * 0.5;
+                c11[slot] += q * t * t;
+
+                // Update, unsampled slots have no gain
+                const auto r = measurementNoise[slot] * measurementNoise[slot] * unitSquared;
+                const auto difference = m[slot] - x[slot];
+                const auto innovation = difference
+                        - span * (static_cast<double>(difference > half) - static_cast<double>(difference < -half));
+                const auto inverse = mask[slot] / (c00[slot] + r);
+                const auto gain0 = c00[slot] * inverse;
+                const auto gain1 = c01[slot] * inverse;
+                x[slot] += gain0 * innovation;
+                v[slot] += gain1 * innovation;
+                c11[slot] -= gain1 * c01[slot];
+                c01[slot] -= gain0 * c01[slot];
+                c00[slot] -= gain0 * c00[slot];
+            }
+        }
+
+        // Back within the wrap, never more than a span out
+        if (span > 0)
+            for (size_t slot = 0; slot < count; ++slot)
+                x[slot] -= span * (static_cast<double>(x[slot] >= minimum + span) - static_cast<double>(x[slot] < minimum));
+    }
+
+    // Started from their first measurement, at rest
+    for (const auto slot : starting)
+    {
+        for (size_t channel = 0; channel < channels.size(); ++channel)
+        {
+            const auto unit = channels[channel].unit;
+            estimate[channel][slot] = measurement[channel][slot];
+            rate[channel][slot] = 0;
+            p00[channel][slot] = measurementNoise[slot] * unit * measurementNoise[slot] * unit;
+            p01[channel][slot] = 0;
+            p11[channel][slot] = processNoise[slot] * unit * processNoise[slot] * unit; // Over a second
+        }
+        started[slot] = 1;
+    }
+    starting.clear();
+
+    std::fill(interval.begin(), interval.end(), 0.0);
+    std::fill(sampled.begin(), sampled.end(), 0.0);
+}
@@ -0,0 +1,105 @@
+/*
+    OTPView
+    A QT Frontend for E1.59  (Entertainment  Technology  Object  Transform  Protocol  (OTP))
+    Copyright (C) 2026  Marcus Birkin
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#ifndef MOTIONFILTER_H
+#define MOTIONFILTER_H
+
+#include <QtGlobal>
+#include <vector>
+
+/*
+ * Smooths noisy point streams, a One-Euro filter or a constant velocity Kalman filter per channel
+ *
+ * As Resampler, every point is a slot and the state of every slot is held as one contiguous array
+ * per channel, so a whole frame of points is filtered by a handful of plain loops.
+ * Slots not given a sample since the last filter() keep their state, they are masked rather than skipped.
+ *
+ * Parameters are per slot, in millimetres and degrees whatever the channel's units,
+ * each channel gives how many of its units make one. Channels with a wrap span (rotations)
+ * are filtered the short way around and kept within [minimum, minimum + span).
+ * Times are in nanoseconds, as Metrics::now()
+ */
+class MotionFilter
+{
+public:
+    typedef enum mode_e
+    {
+        OneEuro,
+        Kalman
+    } mode_t;
+
+    typedef struct parameters_s
+    {
+        // One-Euro
+        double minCutoff = 1.0; // Hz
+        double beta = 0.01; // Cutoff Hz per mm/s or degree/s
+        double derivativeCutoff = 1.0; // Hz
+
+        // Kalman
+        double measurementNoise = 1.0; // Standard deviation, mm or degrees
+        double processNoise = 1000.0; // Acceleration standard deviation, mm/s² or degrees/s²
+    } parameters_t;
+
+    typedef struct channel_s
+    {
+        double unit = 1.0; // Channel units per mm or degree
+        double wrapSpan = 0.0; // 0 for none
+        double minimum = 0.0; // Of the wrap
+    } channel_t;
+
+    MotionFilter(mode_t mode, const std::vector<channel_t> &channels);
+
+    mode_t getMode() const { return mode; }
+    int getChannelCount() const { return static_cast<int>(channels.size()); }
+    int getSlotCount() const { return static_cast<int>(lastTime.size()); }
+
+    int addPoint(const parameters_t &parameters);
+    void removePoint(int slot);
+    void setParameters(int slot, const parameters_t &parameters);
+
+    // Measurements for the next filter(), the first one of a slot starts it
+    void beginSample(int slot, qint64 time);
+    void setValue(int channel, int slot, double value) { measurement[channel][slot] = value; }
+
+    // Every slot given a sample since the last call
+    void filter();
+    double getValue(int channel, int slot) const { return estimate[channel][slot]; }
+
+private:
+    mode_t mode;
+    std::vector<channel_t> channels;
+
+    // Per channel
+    std::vector<std::vector<double>> measurement;
+    std::vector<std::vector<double>> estimate;
+    std::vector<std::vector<double>> rate; // Derivative, or velocity for Kalman
+    std::vector<std::vector<double>> p00, p01, p11; // Kalman covariance
+
+    // Per slot
+    std::vector<double> minCutoff, beta, derivativeCutoff;
+    std::vector<double> measurementNoise, processNoise;
+    std::vector<qint64> lastTime;
+    std::vector<double> interval; // Seconds, 0 when not sampled
+    std::vector<double> sampled; // 1 when sampled, for masking
+    std::vector<int> started; // 0 when free or waiting for a first sample
+    std::vector<int> freeSlots;
+    std::vector<int> starting;
+    std::vector<double> speedFactor, derivativeAlpha; // Reused by filter()
+};
+
+#endif // MOTIONFILTER_H
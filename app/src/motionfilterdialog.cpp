@@ -0,0 +1,81 @@
+/*
+    OTPView
+    A QT Frontend for E1.59  (Entertainment  Technology  Object  Transform  Protocol  (OTP))
+    Copyright (C) 2026  Marcus Birkin
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "motionfilterdialog.h"
+#include "ui_motionfilterdialog.h"
+#include "settings.h"
+
+using namespace OTP;
+
+namespace {
+    // Listed as off, then each MotionFilter::mode_t
+    constexpr int ModeOff = 0;
+}
+
+MotionFilterDialog::MotionFilterDialog(system_t system, group_t group, QWidget *parent) :
+    QDialog(parent),
+    ui(new Ui::MotionFilterDialog),
+    system(system),
+    group(group)
+{
+    ui->setupUi(this);
+    setWindowFlag(Qt::WindowContextHelpButtonHint, false);
+    setWindowTitle(tr("Motion Filter, System %1 Group %2").arg(system).arg(group));
+
+    Settings::groupFilter_t filter;
+    const auto filtered = Settings::getInstance().getGroupFilter(system, group, filter);
+    ui->dsbMinCutoff->setValue(filter.parameters.minCutoff);
+    ui->dsbBeta->setValue(filter.parameters.beta);
+    ui->dsbDerivativeCutoff->setValue(filter.parameters.derivativeCutoff);
+    ui->dsbMeasurementNoise->setValue(filter.parameters.measurementNoise);
+    ui->dsbProcessNoise->setValue(filter.parameters.processNoise);
+    ui->cbMode->setCurrentIndex(filtered ? filter.mode + 1 : ModeOff);
+    on_cbMode_currentIndexChanged(ui->cbMode->currentIndex());
+}
+
+MotionFilterDialog::~MotionFilterDialog()
+{
+    delete ui;
+}
+
+void MotionFilterDialog::on_cbMode_currentIndexChanged(int index)
+{
+    ui->gbOneEuro->setEnabled(index == MotionFilter::OneEuro + 1);
+    ui->gbKalman->setEnabled(index == MotionFilter::Kalman + 1);
+}
+
+void MotionFilterDialog::on_buttonBox_accepted()
+{
+    const auto index = ui->cbMode->currentIndex();
+    if (index == ModeOff)
+    {
+        Settings::getInstance().clearGroupFilter(system, group);
+    } else {
+        Settings::groupFilter_t filter;
+        filter.system = system;
+        filter.group = group;
+        filter.mode = static_cast<MotionFilter::mode_t>(index - 1);
+        filter.parameters.minCutoff = ui->dsbMinCutoff->value();
+        filter.parameters.beta = ui->dsbBeta->value();
+        filter.parameters.derivativeCutoff = ui->dsbDerivativeCutoff->value();
+        filter.parameters.measurementNoise = ui->dsbMeasurementNoise->value();
+        filter.parameters.processNoise = ui->dsbProcessNoise->value();
+        Settings::getInstance().setGroupFilter(filter);
+    }
+    accept();
+}
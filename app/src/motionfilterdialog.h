@@ -0,0 +1,50 @@
+/*
+    OTPView
+    A QT Frontend for E1.59  (Entertainment  Technology  Object  Transform  Protocol  (OTP))
+    Copyright (C) 2026  Marcus Birkin
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#ifndef MOTIONFILTERDIALOG_H
+#define MOTIONFILTERDIALOG_H
+
+#include <QDialog>
+#include "OTPLib.hpp"
+
+namespace Ui {
+class MotionFilterDialog;
+}
+
+/*
+ * Chooses the motion filter of one consumed group, saved in Settings
+ */
+class MotionFilterDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    explicit MotionFilterDialog(OTP::system_t system, OTP::group_t group, QWidget *parent = nullptr);
+    ~MotionFilterDialog();
+
+private slots:
+    void on_cbMode_currentIndexChanged(int index);
+    void on_buttonBox_accepted();
+
+private:
+    Ui::MotionFilterDialog *ui;
+    OTP::system_t system;
+    OTP::group_t group;
+};
+
+#endif // MOTIONFILTERDIALOG_H
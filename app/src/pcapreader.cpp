@@ -0,0 +1,432 @@
+/*
+    OTPView
+    A QT Frontend for E1.59  (Entertainment  Technology  Object  Transform  Protocol  (OTP))
+    Copyright (C) 2026  Marcus Birkin
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "pcapreader.h"
+#include <QObject>
+#include <QtEndian>
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+    constexpr quint32 PcapMagic = 0xa1b2c3d4; // Microsecond timestamps
+    constexpr quint32 PcapMagicNs = 0xa1b23c4d; // Nanosecond timestamps
+    constexpr quint32 PcapNgSectionHeader = 0x0a0d0d0a;
+    constexpr quint32 PcapNgByteOrderMagic = 0x1a2b3c4d;
+
+    // pcapng block types
+    constexpr quint32 InterfaceDescriptionBlock = 0x00000001;
+    constexpr quint32 PacketBlock = 0x00000002; // Obsolete
+    constexpr quint32 SimplePacketBlock = 0x00000003;
+    constexpr quint32 EnhancedPacketBlock = 0x00000006;
+    constexpr quint16 OptionEnd = 0;
+    constexpr quint16 OptionTsResol = 9;
+
+    // Link types
+    constexpr quint16 LinkNull = 0;
+    constexpr quint16 LinkEthernet = 1;
+    constexpr quint16 LinkRaw = 101;
+    constexpr quint16 LinkRawAlternative = 12;
+    constexpr quint16 LinkLoop = 108;
+    constexpr quint16 LinkLinuxSll = 113;
+    constexpr quint16 LinkIPv4 = 228;
+    constexpr quint16 LinkIPv6 = 229;
+    constexpr quint16 LinkLinuxSll2 = 276;
+
+    constexpr quint16 EtherTypeIPv4 = 0x0800;
+    constexpr quint16 EtherTypeIPv6 = 0x86dd;
+    constexpr quint16 EtherTypeVlan = 0x8100;
+    constexpr quint16 EtherTypeQinQ = 0x88a8;
+
+    constexpr quint8 ProtocolUdp = 17;
+
+    const char OtpPacketIdent[] = {'O', 'T', 'P', '-', 'E', '1', '.', '5', '9', 0, 0, 0};
+}
+
+bool PcapReader::open(const QString &fileName)
+{
+    close();
+    file.setFileName(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return fail(file.errorString());
+
+    char header[4];
+    if (!readExactly(header, sizeof(header)))
+        return fail(error.isEmpty() ? QObject::tr("Not a pcap or pcapng file") : error);
+
+    // In the capturing machine's byte order, the pcapng section header reads the same either way
+    quint32 magic;
+    std::memcpy(&magic, header, sizeof(magic));
+    if (magic == PcapNgSectionHeader)
+    {
+        format = FormatPcapNg;
+        char length[4];
+        return readExactly(length, sizeof(length)) && readSectionHeader(length);
+    }
+
+    format = FormatPcap;
+    if (magic == PcapMagic || magic == PcapMagicNs) swapped = false;
+    else if (qbswap(magic) == PcapMagic || qbswap(magic) == PcapMagicNs) swapped = true;
+    else return fail(QObject::tr("Not a pcap or pcapng file"));
+    pcapUnitsPerSecond = (magic == PcapMagicNs || qbswap(magic) == PcapMagicNs) ? 1000000000 : 1000000;
+
+    // Version, time zone, accuracy, snap length, link type
+    char rest[20];
+    if (!readExactly(rest, sizeof(rest)))
+        return false;
+    pcapLinkType = static_cast<quint16>(toUInt32(rest + 16));
+    return true;
+}
+
+void PcapReader::close()
+{
+    file.close();
+    error.clear();
+    swapped = false;
+    interfaces.clear();
+    lastTimestamp = 0;
+    statistics = statistics_t();
+}
+
+bool PcapReader::next(packet_t &packet)
+{
+    if (!file.isOpen()) return false;
+    return (format == FormatPcap) ? nextPcap(packet) : nextPcapNg(packet);
+}
+
+bool PcapReader::readExactly(char *data, qint64 size)
+{
+    if (file.read(data, size) == size)
+        return true;
+    if (file.atEnd())
+        return fail(QString()); // Clean end, or a truncated final record
+    return fail(file.errorString());
+}
+
+bool PcapReader::readBlock(QByteArray &buffer, qint64 size)
+{
+    if (size < 0 || size > MaxBlockSize)
+        return fail(QObject::tr("Corrupt capture at offset %1").arg(file.pos()));
+    buffer.resize(static_cast<int>(size));
+    return readExactly(buffer.data(), size);
+}
+
+bool PcapReader::fail(const QString &message)
+{
+    error = message;
+    file.close();
+    return false;
+}
+
+bool PcapReader::nextPcap(packet_t &packet)
+{
+    char header[16];
+    while (readExactly(header, sizeof(header)))
+    {
+        const auto seconds = toUInt32(header);
+        const auto fraction = toUInt32(header + 4);
+        const auto capturedLength = toUInt32(header + 8);
+        if (!readBlock(buffer, capturedLength))
+            return false;
+
+        ++statistics.packets;
+        if (!decode(pcapLinkType, buffer.constData(), buffer.size(), packet))
+            continue;
+
+        packet.timestamp = qint64(seconds) * 1000000 + toMicroseconds(fraction, pcapUnitsPerSecond);
+        ++statistics.otpPackets;
+        return true;
+    }
+    return false;
+}
+
+bool PcapReader::nextPcapNg(packet_t &packet)
+{
+    char header[8];
+    while (readExactly(header, sizeof(header)))
+    {
+        // A new section may change the byte order, its type reads the same either way
+        if (qFromLittleEndian<quint32>(header) == PcapNgSectionHeader)
+        {
+            if (!readSectionHeader(header + 4)) return false;
+            continue;
+        }
+        const auto type = toUInt32(header);
+
+        // Body and trailing length, blocks are padded to 32 bits
+        const auto length = toUInt32(header + 4);
+        if (length < 12 || length % 4)
+            return fail(QObject::tr("Corrupt capture at offset %1").arg(file.pos()));
+        if (!readBlock(buffer, length - 8))
+            return false;
+        const auto body = buffer.constData();
+        const auto bodyLength = static_cast<int>(length - 12);
+
+        switch (type)
+        {
+            case InterfaceDescriptionBlock:
+            {
+                if (bodyLength < 8) break;
+                interface_t iface;
+                iface.linkType = toUInt16(body);
+                for (int offset = 8; offset + 4 <= bodyLength;)
+                {
+                    const auto code = toUInt16(body + offset);
+                    const auto optionLength = toUInt16(body + offset + 2);
+                    if (code == OptionEnd || offset + 4 + optionLength > bodyLength) break;
+                    if (code == OptionTsResol && optionLength >= 1)
+                    {
+                        const auto resolution = static_cast<quint8>(body[offset + 4]);
+                        const auto exponent = std::min(resolution & 0x7f, (resolution & 0x80) ? 63 : 19);
+                        quint64 units = 1;
+                        for (int n = 0; n < exponent; ++n)
+                            units *= (resolution & 0x80) ? 2 : 10;
+                        iface.unitsPerSecond = units;
+                    }
+                    offset += 4 + ((optionLength + 3) & ~3);
+                }
+                interfaces.append(iface);
+                break;
+            }
+
+            case EnhancedPacketBlock:
+            case PacketBlock:
+            {
+                if (bodyLength < 20) break;
+                ++statistics.packets;
+                const auto interfaceId = (type == EnhancedPacketBlock) ? toUInt32(body) : toUInt16(body);
+                if (interfaceId >= static_cast<quint32>(interfaces.count())) break;
+                const auto &iface = interfaces.at(static_cast<int>(interfaceId));
+                const auto units = (quint64(toUInt32(body + 4)) << 32) | toUInt32(body + 8);
+                const auto capturedLength = toUInt32(body + 12);
+                if (capturedLength > static_cast<quint32>(bodyLength - 20)) break;
+                if (!decode(iface.linkType, body + 20, static_cast<int>(capturedLength), packet))
+                    break;
+                packet.timestamp = lastTimestamp = toMicroseconds(units, iface.unitsPerSecond);
+                ++statistics.otpPackets;
+                return true;
+            }
+
+            case SimplePacketBlock:
+            {
+                // No timestamp, nor interface, taken as the first interface at the last time seen
+                if (bodyLength < 4 || interfaces.isEmpty()) break;
+                ++statistics.packets;
+                const auto capturedLength = std::min<quint32>(toUInt32(body), static_cast<quint32>(bodyLength - 4));
+                if (!decode(interfaces.first().linkType, body + 4, static_cast<int>(capturedLength), packet))
+                    break;
+                packet.timestamp = lastTimestamp;
+                ++statistics.otpPackets;
+                return true;
+            }
+
+            default: break; // Statistics, name resolution, custom...
+        }
+    }
+    return false;
+}
+
+bool PcapReader::readSectionHeader(const char *length)
+{
+    // The byte order magic tells how to read everything in the section, the length included
+    char magic[4];
+    if (!readExactly(magic, sizeof(magic)))
+        return false;
+    quint32 byteOrder;
+    std::memcpy(&byteOrder, magic, sizeof(byteOrder));
+    if (byteOrder == PcapNgByteOrderMagic) swapped = false;
+    else if (qbswap(byteOrder) == PcapNgByteOrderMagic) swapped = true;
+    else return fail(QObject::tr("Not a pcap or pcapng file"));
+
+    const auto blockLength = toUInt32(length);
+    if (blockLength < 28 || blockLength % 4)
+        return fail(QObject::tr("Corrupt capture at offset %1").arg(file.pos()));
+    if (!readBlock(buffer, blockLength - 12)) // Type, length and magic already read
+        return false;
+
+    interfaces.clear();
+    return true;
+}
+
+quint16 PcapReader::toUInt16(const char *data) const
+{
+    quint16 value;
+    std::memcpy(&value, data, sizeof(value));
+    return swapped ? qbswap(value) : value;
+}
+
+quint32 PcapReader::toUInt32(const char *data) const
+{
+    quint32 value;
+    std::memcpy(&value, data, sizeof(value));
+    return swapped ? qbswap(value) : value;
+}
+
+qint64 PcapReader::toMicroseconds(quint64 units, quint64 unitsPerSecond)
+{
+    const auto seconds = units / unitsPerSecond;
+    const auto fraction = units % unitsPerSecond;
+    return static_cast<qint64>(seconds * 1000000
+                               + static_cast<quint64>(static_cast<double>(fraction) * 1000000 / unitsPerSecond));
+}
+
+bool PcapReader::decode(quint16 linkType, const char *data, int size, packet_t &packet)
+{
+    const auto bytes = reinterpret_cast<const uchar*>(data);
+    switch (linkType)
+    {
+        case LinkEthernet:
+        {
+            int offset = 12;
+            while (offset + 2 <= size)
+            {
+                const auto etherType = qFromBigEndian<quint16>(bytes + offset);
+                if (etherType == EtherTypeVlan || etherType == EtherTypeQinQ)
+                {
+                    offset += 4;
+                    continue;
+                }
+                if (etherType != EtherTypeIPv4 && etherType != EtherTypeIPv6) return false;
+                return decodeIp(data + offset + 2, size - offset - 2, packet);
+            }
+            return false;
+        }
+
+        case LinkNull:
+        case LinkLoop:
+        {
+            // Address family, in whichever byte order it was captured
+            if (size < 4) return false;
+            auto family = qFromLittleEndian<quint32>(bytes);
+            if (family > 0xffff) family = qbswap(family);
+            if (family != 2 && family != 24 && family != 28 && family != 30) return false;
+            return decodeIp(data + 4, size - 4, packet);
+        }
+
+        case LinkLinuxSll:
+        {
+            if (size < 16) return false;
+            const auto protocol = qFromBigEndian<quint16>(bytes + 14);
+            if (protocol != EtherTypeIPv4 && protocol != EtherTypeIPv6) return false;
+            return decodeIp(data + 16, size - 16, packet);
+        }
+
+        case LinkLinuxSll2:
+        {
+            if (size < 20) return false;
+            const auto protocol = qFromBigEndian<quint16>(bytes);
+            if (protocol != EtherTypeIPv4 && protocol != EtherTypeIPv6) return false;
+            return decodeIp(data + 20, size - 20, packet);
+        }
+
+        case LinkRaw:
+        case LinkRawAlternative:
+        case LinkIPv4:
+        case LinkIPv6:
+            return decodeIp(data, size, packet);
+
+        default: return false;
+    }
+}
+
+bool PcapReader::decodeIp(const char *data, int size, packet_t &packet)
+{
+    const auto bytes = reinterpret_cast<const uchar*>(data);
+    if (size < 1) return false;
+
+    int offset = 0;
+    int end = size;
+    switch (bytes[0] >> 4)
+    {
+        case 4:
+        {
+            if (size < 20) return false;
+            const auto headerLength = (bytes[0] & 0x0f) * 4;
+            const auto totalLength = qFromBigEndian<quint16>(bytes + 2);
+            const auto fragment = qFromBigEndian<quint16>(bytes + 6);
+            if (headerLength < 20 || bytes[9] != ProtocolUdp) return false;
+            if (fragment & 0x3fff) // More fragments, or an offset
+            {
+                ++statistics.fragments;
+                return false;
+            }
+            packet.source = QHostAddress(qFromBigEndian<quint32>(bytes + 12));
+            packet.destination = QHostAddress(qFromBigEndian<quint32>(bytes + 16));
+            offset = headerLength;
+            end = std::min<int>(size, totalLength);
+            break;
+        }
+
+        case 6:
+        {
+            if (size < 40) return false;
+            auto nextHeader = bytes[6];
+            end = std::min<int>(size, 40 + qFromBigEndian<quint16>(bytes + 4));
+            packet.source = QHostAddress(bytes + 8);
+            packet.destination = QHostAddress(bytes + 24);
+            offset = 40;
+
+            // Extension headers
+            while (nextHeader != ProtocolUdp)
+            {
+                if (offset + 8 > end) return false;
+                switch (nextHeader)
+                {
+                    case 0: // Hop by hop
+                    case 43: // Routing
+                    case 60: // Destination options
+                        nextHeader = bytes[offset];
+                        offset += (bytes[offset + 1] + 1) * 8;
+                        break;
+                    case 51: // Authentication
+                        nextHeader = bytes[offset];
+                        offset += (bytes[offset + 1] + 2) * 4;
+                        break;
+                    case 44: // Fragment
+                        ++statistics.fragments;
+                        return false;
+                    default: return false;
+                }
+            }
+            break;
+        }
+
+        default: return false;
+    }
+
+    // UDP
+    if (offset + 8 > end) return false;
+    packet.sourcePort = qFromBigEndian<quint16>(bytes + offset);
+    packet.destinationPort = qFromBigEndian<quint16>(bytes + offset + 2);
+    const auto udpLength = qFromBigEndian<quint16>(bytes + offset + 4);
+    if (packet.destinationPort != OtpPort || udpLength < 8) return false;
+    const auto payloadLength = udpLength - 8;
+    if (payloadLength < static_cast<int>(sizeof(OtpPacketIdent))
+            || end - offset - 8 < static_cast<int>(sizeof(OtpPacketIdent))
+            || std::memcmp(data + offset + 8, OtpPacketIdent, sizeof(OtpPacketIdent)) != 0)
+        return false;
+    if (end - offset - 8 < payloadLength)
+    {
+        ++statistics.truncated;
+        return false;
+    }
+
+    packet.payload.resize(payloadLength);
+    std::memcpy(packet.payload.data(), data + offset + 8, static_cast<size_t>(payloadLength));
+    return true;
+}
@@ -0,0 +1,118 @@
+/*
+    OTPView
+    A QT Frontend for E1.59  (Entertainment  Technology  Object  Transform  Protocol  (OTP))
+    Copyright (C) 2026  Marcus Birkin
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#ifndef PCAPREADER_H
+#define PCAPREADER_H
+
+#include <QByteArray>
+#include <QFile>
+#include <QHostAddress>
+#include <QString>
+#include <QVector>
+
+/*
+ * Streaming reader of OTP messages from packet captures, pcap or pcapng
+ *
+ * Packets are read one at a time into a reused buffer, so memory stays bounded
+ * however large the capture. Ethernet (with VLAN tags), Linux cooked, loopback
+ * and raw IP captures are understood; every UDP datagram to the OTP port
+ * that starts with the OTP packet identifier is returned, over IPv4 (OTP-4) or IPv6 (OTP-6).
+ * Fragmented datagrams aren't reassembled, OTP messages fit in a single datagram
+ */
+class PcapReader
+{
+public:
+    static constexpr quint16 OtpPort = 5568;
+    static constexpr qint64 MaxBlockSize = 16 * 1024 * 1024; // Larger is taken as corruption
+
+    typedef struct packet_s
+    {
+        qint64 timestamp = 0; // Microseconds since the epoch
+        QHostAddress source;
+        quint16 sourcePort = 0;
+        QHostAddress destination;
+        quint16 destinationPort = 0;
+        QByteArray payload; // OTP message
+    } packet_t;
+
+    typedef struct statistics_s
+    {
+        quint64 packets = 0; // Every captured packet
+        quint64 otpPackets = 0;
+        quint64 fragments = 0; // Skipped
+        quint64 truncated = 0; // OTP messages skipped, captured with too small a snap length
+    } statistics_t;
+
+    bool open(const QString &fileName);
+    void close();
+
+    // False at the end of the file, or on error
+    bool next(packet_t &packet);
+
+    QString errorString() const { return error; }
+    qint64 position() const { return file.pos(); }
+    qint64 size() const { return file.size(); }
+    const statistics_t &getStatistics() const { return statistics; }
+
+private:
+    typedef enum format_e
+    {
+        FormatPcap,
+        FormatPcapNg
+    } format_t;
+
+    typedef struct interface_s
+    {
+        quint16 linkType = 0;
+        quint64 unitsPerSecond = 1000000;
+    } interface_t;
+
+    bool readExactly(char *data, qint64 size);
+    bool readBlock(QByteArray &buffer, qint64 size);
+    bool fail(const QString &message);
+
+    bool nextPcap(packet_t &packet);
+    bool nextPcapNg(packet_t &packet);
+    bool readSectionHeader(const char *length);
+
+    quint16 toUInt16(const char *data) const;
+    quint32 toUInt32(const char *data) const;
+    static qint64 toMicroseconds(quint64 units, quint64 unitsPerSecond);
+
+    // Parses one captured frame, true if it carries an OTP message
+    bool decode(quint16 linkType, const char *data, int size, packet_t &packet);
+    bool decodeIp(const char *data, int size, packet_t &packet);
+
+    QFile file;
+    QString error;
+    format_t format = FormatPcap;
+    bool swapped = false;
+
+    // pcap
+    quint16 pcapLinkType = 0;
+    quint64 pcapUnitsPerSecond = 1000000;
+
+    // pcapng, for the current section
+    QVector<interface_t> interfaces;
+    qint64 lastTimestamp = 0;
+
+    QByteArray buffer;
+    statistics_t statistics;
+};
+
+#endif // PCAPREADER_H
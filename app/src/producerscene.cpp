@@ -0,0 +1,313 @@
+/*
+    OTPView
+    A QT Frontend for E1.59  (Entertainment  Technology  Object  Transform  Protocol  (OTP))
+    Copyright (C) 2026  Marcus Birkin
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "producerscene.h"
+#include "producertransaction.h"
+#include <QCborValue>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <algorithm>
+
+using namespace OTP;
+using namespace OTP::MODULES::STANDARD;
+
+namespace {
+    const QString FormatName = QStringLiteral("OTPView Scene");
+    constexpr int FormatVersion = 1;
+
+    void setError(QString *errorString, const QString &message)
+    {
+        if (errorString) *errorString = message;
+    }
+}
+
+ProducerScene ProducerScene::capture(const std::shared_ptr<ProducerThread> &otpProducer, OTP::system_t system)
+{
+    ProducerScene scene;
+    scene.system = system;
+
+    // Locked throughout, so the scene is consistent
+    const auto producer = otpProducer->read();
+    auto groups = producer->getLocalGroups(system);
+    std::sort(groups.begin(), groups.end());
+    for (const auto &group : qAsConst(groups))
+    {
+        auto pointList = producer->getLocalPoints(system, group);
+        std::sort(pointList.begin(), pointList.end());
+        for (const auto &point : qAsConst(pointList))
+        {
+            const address_t address(system, group, point);
+
+            scenePoint_t scenePoint;
+            scenePoint.group = group;
+            scenePoint.point = point;
+            scenePoint.name = producer->getLocalPointName(address);
+            scenePoint.priority = producer->getLocalPointPriority(address);
+
+            const auto referenceFrame = producer->getLocalReferenceFrame(address);
+            if (referenceFrame.timestamp && referenceFrame.value.isValid() && !(referenceFrame.value == address))
+                scenePoint.referenceFrame = referenceFrame.value;
+
+            for (size_t module = 0; module < modules.size(); ++module)
+                for (auto axis = axis_t::first; axis < axis_t::count; ++axis)
+                    scenePoint.values[module][axis] = ProducerTransaction::getValue(*producer, address, axis, modules[module]);
+
+            scene.points << scenePoint;
+        }
+    }
+
+    return scene;
+}
+
+int ProducerScene::recall(const std::shared_ptr<ProducerThread> &otpProducer, OTP::system_t system) const
+{
+    const auto groups = getGroups();
+
+    // Everything else in one batch
+    ProducerTransaction transaction(otpProducer);
+    for (const auto &scenePoint : points)
+    {
+        const address_t address(system, scenePoint.group, scenePoint.point);
+        transaction.setName(address, scenePoint.name);
+        transaction.setPriority(address, scenePoint.priority);
+
+        // References within the scene's own system follow it to the recalled system
+        auto referenceFrame = scenePoint.referenceFrame;
+        if (referenceFrame.isValid() && referenceFrame.system == this->system)
+            referenceFrame.system = system;
+        transaction.setReferenceFrame(address, referenceFrame.isValid() ? referenceFrame : address);
+
+        for (size_t module = 0; module < modules.size(); ++module)
+            for (auto axis = axis_t::first; axis < axis_t::count; ++axis)
+                transaction.setValue(address, axis, modules[module], scenePoint.values[module][axis]);
+    }
+
+    // One call, the producer can't transmit until the whole scene is in place
+    int ret = 0;
+    otpProducer->call([&](Producer &producer) {
+        // Structural changes first, the producer only adds and removes whole points
+        for (const auto &group : groups)
+        {
+            producer.addLocalGroup(system, group);
+
+            QList<point_t> scenePoints;
+            for (const auto &scenePoint : points)
+                if (scenePoint.group == group)
+                    scenePoints << scenePoint.point;
+
+            auto existingPoints = producer.getLocalPoints(system, group);
+            std::sort(existingPoints.begin(), existingPoints.end());
+            for (const auto &point : qAsConst(existingPoints))
+                if (!std::binary_search(scenePoints.cbegin(), scenePoints.cend(), point))
+                    producer.removeLocalPoint(address_t(system, group, point));
+            for (const auto &point : qAsConst(scenePoints))
+                if (!std::binary_search(existingPoints.cbegin(), existingPoints.cend(), point))
+                    producer.addLocalPoint(system, group, point, priority_t());
+        }
+
+        ret = transaction.apply(producer);
+    });
+    return ret;
+}
+
+QList<OTP::group_t> ProducerScene::getGroups() const
+{
+    QList<group_t> ret;
+    for (const auto &scenePoint : points)
+        if (ret.isEmpty() || !(ret.last() == scenePoint.group))
+            ret << scenePoint.group;
+    return ret;
+}
+
+bool ProducerScene::save(const QString &fileName, QString *errorString) const
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        setError(errorString, file.errorString());
+        return false;
+    }
+
+    const auto object = toJson();
+    const auto data = (QFileInfo(fileName).suffix().compare("json", Qt::CaseInsensitive) == 0)
+            ? QJsonDocument(object).toJson(QJsonDocument::Compact)
+            : QCborValue::fromJsonValue(object).toCbor();
+
+    if (file.write(data) != data.size())
+    {
+        setError(errorString, file.errorString());
+        return false;
+    }
+    return true;
+}
+
+bool ProducerScene::load(const QString &fileName, QString *errorString)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        setError(errorString, file.errorString());
+        return false;
+    }
+    const auto data = file.readAll();
+
+    // JSON scenes always start with an object, CBOR ones with a map
+    QJsonObject object;
+    if (data.trimmed().startsWith('{'))
+    {
+        QJsonParseError error;
+        const auto document = QJsonDocument::fromJson(data, &error);
+        if (error.error != QJsonParseError::NoError)
+        {
+            setError(errorString, error.errorString());
+            return false;
+        }
+        object = document.object();
+    } else {
+        QCborParserError error;
+        const auto value = QCborValue::fromCbor(data, &error);
+        if (error.error != QCborError::NoError)
+        {
+            setError(errorString, error.errorString());
+            return false;
+        }
+        object = value.toJsonValue().toObject();
+    }
+
+    return fromJson(object, errorString);
+}
+
+QString ProducerScene::moduleKey(moduleValue_t moduleValue)
+{
+    switch (moduleValue) {
+        case VALUES::POSITION: return QStringLiteral("position");
+        case VALUES::POSITION_VELOCITY: return QStringLiteral("positionVelocity");
+        case VALUES::POSITION_ACCELERATION: return QStringLiteral("positionAcceleration");
+        case VALUES::ROTATION: return QStringLiteral("rotation");
+        case VALUES::ROTATION_VELOCITY: return QStringLiteral("rotationVelocity");
+        case VALUES::ROTATION_ACCELERATION: return QStringLiteral("rotationAcceleration");
+        case VALUES::SCALE: return QStringLiteral("scale");
+        case VALUES::REFERENCE_FRAME: break;
+    }
+    return QString();
+}
+
+QJsonObject ProducerScene::toJson() const
+{
+    QJsonArray pointsArray;
+    for (const auto &scenePoint : points)
+    {
+        QJsonObject pointObject;
+        pointObject.insert("group", static_cast<qint64>(scenePoint.group));
+        pointObject.insert("point", static_cast<qint64>(scenePoint.point));
+        pointObject.insert("name", scenePoint.name);
+        pointObject.insert("priority", static_cast<int>(scenePoint.priority));
+        if (scenePoint.referenceFrame.isValid())
+            pointObject.insert("referenceFrame", QJsonArray({
+                static_cast<qint64>(scenePoint.referenceFrame.system),
+                static_cast<qint64>(scenePoint.referenceFrame.group),
+                static_cast<qint64>(scenePoint.referenceFrame.point)}));
+
+        for (size_t module = 0; module < modules.size(); ++module)
+        {
+            QJsonArray axisArray;
+            for (const auto &value : scenePoint.values[module])
+                axisArray.append(value);
+            pointObject.insert(moduleKey(modules[module]), axisArray);
+        }
+
+        pointsArray.append(pointObject);
+    }
+
+    QJsonObject object;
+    object.insert("format", FormatName);
+    object.insert("version", FormatVersion);
+    object.insert("system", static_cast<qint64>(system));
+    object.insert("points", pointsArray);
+    return object;
+}
+
+bool ProducerScene::fromJson(const QJsonObject &object, QString *errorString)
+{
+    if (object.value("format").toString() != FormatName)
+    {
+        setError(errorString, QObject::tr("Not a scene file"));
+        return false;
+    }
+    if (object.value("version").toInt() > FormatVersion)
+    {
+        setError(errorString, QObject::tr("Scene file version %1 is not supported").arg(object.value("version").toInt()));
+        return false;
+    }
+
+    QVector<scenePoint_t> newPoints;
+    const auto pointsArray = object.value("points").toArray();
+    newPoints.reserve(pointsArray.count());
+    for (const auto &pointValue : pointsArray)
+    {
+        const auto pointObject = pointValue.toObject();
+
+        scenePoint_t scenePoint;
+        scenePoint.group = group_t(static_cast<quint32>(pointObject.value("group").toDouble()));
+        scenePoint.point = point_t(static_cast<quint32>(pointObject.value("point").toDouble()));
+        if (!address_t(system_t(1), scenePoint.group, scenePoint.point).isValid())
+        {
+            setError(errorString, QObject::tr("Invalid address %1/%2")
+                     .arg(scenePoint.group).arg(scenePoint.point));
+            return false;
+        }
+        scenePoint.name = pointObject.value("name").toString();
+        scenePoint.priority = static_cast<priority_t>(pointObject.value("priority").toInt(priority_t()));
+
+        const auto referenceFrame = pointObject.value("referenceFrame").toArray();
+        if (referenceFrame.count() == 3)
+            scenePoint.referenceFrame = address_t(
+                        system_t(static_cast<quint32>(referenceFrame.at(0).toDouble())),
+                        group_t(static_cast<quint32>(referenceFrame.at(1).toDouble())),
+                        point_t(static_cast<quint32>(referenceFrame.at(2).toDouble())));
+
+        for (size_t module = 0; module < modules.size(); ++module)
+        {
+            const auto key = moduleKey(modules[module]);
+            const auto axisArray = pointObject.value(key).toArray();
+            const auto numeric = std::all_of(axisArray.cbegin(), axisArray.cend(), [](const QJsonValue &value) {
+                return value.isDouble();
+            });
+            if (axisArray.count() != 3 || !numeric)
+            {
+                setError(errorString, QObject::tr("Invalid %1 for address %2/%3")
+                         .arg(key).arg(scenePoint.group).arg(scenePoint.point));
+                return false;
+            }
+            for (auto axis = axis_t::first; axis < axis_t::count; ++axis)
+                scenePoint.values[module][axis] = static_cast<qint64>(axisArray.at(axis).toDouble());
+        }
+
+        newPoints << scenePoint;
+    }
+
+    std::sort(newPoints.begin(), newPoints.end(), [](const scenePoint_t &a, const scenePoint_t &b) {
+        return std::make_pair(a.group, a.point) < std::make_pair(b.group, b.point);
+    });
+
+    system = system_t(static_cast<quint32>(object.value("system").toDouble()));
+    points = newPoints;
+    return true;
+}
@@ -0,0 +1,88 @@
+/*
+    OTPView
+    A QT Frontend for E1.59  (Entertainment  Technology  Object  Transform  Protocol  (OTP))
+    Copyright (C) 2026  Marcus Birkin
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#ifndef PRODUCERSCENE_H
+#define PRODUCERSCENE_H
+
+#include <QJsonObject>
+#include <QList>
+#include <QString>
+#include <QVector>
+#include <array>
+#include <memory>
+#include "OTPLib.hpp"
+#include "producerthread.h"
+
+/*
+ * Snapshot of every local point of a producer system
+ *
+ * Scenes are saved as JSON when the file name ends in .json,
+ * otherwise as the equivalent CBOR which is considerably smaller
+ *
+ * Recalling a scene adds and removes points and applies a single ProducerTransaction
+ * in one call on the producer thread, so consumers only ever see the system
+ * from before or after the recall, never new points without their values
+ */
+class ProducerScene
+{
+public:
+    typedef OTP::MODULES::STANDARD::VALUES::moduleValue_t moduleValue_t;
+    static constexpr std::array<moduleValue_t, 7> modules = {
+        OTP::MODULES::STANDARD::VALUES::POSITION,
+        OTP::MODULES::STANDARD::VALUES::POSITION_VELOCITY,
+        OTP::MODULES::STANDARD::VALUES::POSITION_ACCELERATION,
+        OTP::MODULES::STANDARD::VALUES::ROTATION,
+        OTP::MODULES::STANDARD::VALUES::ROTATION_VELOCITY,
+        OTP::MODULES::STANDARD::VALUES::ROTATION_ACCELERATION,
+        OTP::MODULES::STANDARD::VALUES::SCALE};
+
+    typedef std::array<qint64, OTP::axis_t::count> axisValues_t;
+    typedef struct scenePoint_s
+    {
+        OTP::group_t group;
+        OTP::point_t point;
+        QString name;
+        OTP::priority_t priority;
+        OTP::address_t referenceFrame; // Invalid when disabled
+        std::array<axisValues_t, modules.size()> values = {};
+    } scenePoint_t;
+
+    ProducerScene() = default;
+
+    static ProducerScene capture(const std::shared_ptr<ProducerThread> &otpProducer, OTP::system_t system);
+    int recall(const std::shared_ptr<ProducerThread> &otpProducer, OTP::system_t system) const;
+
+    bool save(const QString &fileName, QString *errorString = nullptr) const;
+    bool load(const QString &fileName, QString *errorString = nullptr);
+
+    bool isEmpty() const { return points.isEmpty(); }
+    OTP::system_t getSystem() const { return system; }
+    QList<OTP::group_t> getGroups() const;
+    const QVector<scenePoint_t> &getPoints() const { return points; }
+
+private:
+    static QString moduleKey(moduleValue_t moduleValue);
+
+    QJsonObject toJson() const;
+    bool fromJson(const QJsonObject &object, QString *errorString);
+
+    OTP::system_t system;
+    QVector<scenePoint_t> points; // Sorted by group then point
+};
+
+#endif // PRODUCERSCENE_H
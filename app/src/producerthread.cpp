@@ -0,0 +1,294 @@
+/*
+    OTPView
+    A QT Frontend for E1.59  (Entertainment  Technology  Object  Transform  Protocol  (OTP))
+    Copyright (C) 2026  Marcus Birkin
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "producerthread.h"
+#include <QAbstractEventDispatcher>
+#include <algorithm>
+#include <cstdlib>
+
+using namespace OTP;
+
+ProducerThread::ProducerThread(
+        QNetworkInterface iface,
+        QAbstractSocket::NetworkLayerProtocol transport,
+        cid_t CID,
+        QString name,
+        std::chrono::milliseconds transformRate,
+        QObject *parent) : QObject(parent),
+    context(new QObject),
+    pacingInterval(transformRate),
+    // The pacing tick, OTPLib transmits on its own timer; what reaches the wire
+    // shows up as this CID's inter-arrival on any consumer receiving it
+    tickInterval(Metrics::getInstance().histogram(
+                     QString("Producer %1 pacing tick interval").arg(CID.toString())))
+{
+    thread.setObjectName(QStringLiteral("OTP Producer"));
+    context->moveToThread(&thread);
+    thread.start(QThread::TimeCriticalPriority);
+
+    // Created on the worker thread, so its sockets and transmit timer are serviced there
+    QMetaObject::invokeMethod(context, [=]() {
+        // Already awake, so the first lock is taken here
+        lockWorker();
+        const auto dispatcher = QAbstractEventDispatcher::instance();
+        connect(dispatcher, &QAbstractEventDispatcher::awake,
+                context, [this]() { lockWorker(); }, Qt::DirectConnection);
+        connect(dispatcher, &QAbstractEventDispatcher::aboutToBlock,
+                context, [this]() {
+                    flushRelays();
+                    unlockWorker();
+                }, Qt::DirectConnection);
+
+        otpProducer.reset(new class Producer(iface, transport, CID, name, transformRate));
+        connectProducer();
+
+        pacingClock.start();
+        pacingTimer = new QTimer(context);
+        pacingTimer->setTimerType(Qt::PreciseTimer);
+        pacingTimer->setInterval(pacingInterval);
+        connect(pacingTimer, &QTimer::timeout, context, [this]() { tick(); });
+        pacingTimer->start();
+    }, Qt::BlockingQueuedConnection);
+}
+
+ProducerThread::~ProducerThread()
+{
+    stop();
+    delete context;
+}
+
+void ProducerThread::stop()
+{
+    if (!thread.isRunning()) return;
+
+    QMetaObject::invokeMethod(context, [this]() {
+        delete pacingTimer;
+        pacingTimer = nullptr;
+        QAbstractEventDispatcher::instance()->disconnect(context);
+        otpProducer->disconnect();
+        otpProducer.reset();
+        unlockWorker();
+    }, Qt::BlockingQueuedConnection);
+
+    thread.quit();
+    thread.wait();
+}
+
+void ProducerThread::call(const edit_t &command)
+{
+    QMetaObject::invokeMethod(context, [this, &command]() {
+        // Anything already queued goes first, keeping every change in order
+        applyEdits();
+        command(*otpProducer);
+    }, Qt::BlockingQueuedConnection);
+}
+
+void ProducerThread::enqueue(edit_t edit)
+{
+    Q_ASSERT(QThread::currentThread() != &thread);
+#ifndef QT_NO_DEBUG
+    QThread *expected = nullptr;
+    if (!editor.compare_exchange_strong(expected, QThread::currentThread()))
+        Q_ASSERT_X(expected == QThread::currentThread(), "ProducerThread::enqueue", "Enqueued from a second thread");
+#endif
+
+    // Only full when the worker is a whole queue behind, waiting for it is then the lesser evil
+    if (!edits.push(edit))
+        call(edit);
+}
+
+void ProducerThread::setNetworkInterface(QNetworkInterface value)
+{
+    call([=](Producer &producer) { producer.setNetworkInterface(value); });
+}
+
+void ProducerThread::setNetworkTransport(QAbstractSocket::NetworkLayerProtocol value)
+{
+    call([=](Producer &producer) { producer.setNetworkTransport(value); });
+}
+
+void ProducerThread::setLocalName(QString value)
+{
+    call([=](Producer &producer) { producer.setLocalName(value); });
+}
+
+void ProducerThread::setLocalCID(cid_t value)
+{
+    call([=](Producer &producer) { producer.setLocalCID(value); });
+}
+
+void ProducerThread::setTransformMsgRate(std::chrono::milliseconds value)
+{
+    call([=](Producer &producer) {
+        producer.setTransformMsgRate(value);
+        pacingInterval = value;
+        pacingTimer->setInterval(pacingInterval);
+        lastTick = -1; // The change itself isn't jitter
+    });
+}
+
+void ProducerThread::addLocalSystem(system_t system)
+{
+    call([=](Producer &producer) { producer.addLocalSystem(system); });
+}
+
+void ProducerThread::removeLocalSystem(system_t system)
+{
+    call([=](Producer &producer) { producer.removeLocalSystem(system); });
+}
+
+void ProducerThread::addLocalGroup(system_t system, group_t group)
+{
+    call([=](Producer &producer) { producer.addLocalGroup(system, group); });
+}
+
+void ProducerThread::removeLocalGroup(system_t system, group_t group)
+{
+    call([=](Producer &producer) { producer.removeLocalGroup(system, group); });
+}
+
+void ProducerThread::addLocalPoint(system_t system, group_t group, point_t point, priority_t priority)
+{
+    call([=](Producer &producer) { producer.addLocalPoint(system, group, point, priority); });
+}
+
+void ProducerThread::removeLocalPoint(address_t address)
+{
+    call([=](Producer &producer) { producer.removeLocalPoint(address); });
+}
+
+void ProducerThread::moveLocalPoint(address_t oldAddress, address_t newAddress)
+{
+    call([=](Producer &producer) { producer.moveLocalPoint(oldAddress, newAddress); });
+}
+
+void ProducerThread::setLocalPointName(address_t address, QString name)
+{
+    call([=](Producer &producer) { producer.setLocalPointName(address, name); });
+}
+
+ProducerThread::jitter_t ProducerThread::getJitter() const
+{
+    jitter_t ret;
+    ret.mean = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::nanoseconds(jitterMean.load()));
+    ret.max = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::nanoseconds(jitterPeak.load()));
+    return ret;
+}
+
+template <typename Signal, typename... Args>
+void ProducerThread::relay(Signal signal, Args... args)
+{
+    pendingRelays.push_back([=]() { emit (this->*signal)(args...); });
+}
+
+void ProducerThread::flushRelays()
+{
+    if (pendingRelays.empty()) return;
+    QMetaObject::invokeMethod(this, [this, relays = std::move(pendingRelays)]() {
+        for (const auto &relay : relays)
+            relay();
+    }, Qt::QueuedConnection);
+    pendingRelays.clear();
+}
+
+void ProducerThread::connectProducer()
+{
+    auto producer = otpProducer.get();
+
+    connect(producer, &Producer::newLocalCID, context, [this](const cid_t CID) {
+        relay(&ProducerThread::newLocalCID, CID);
+    }, Qt::DirectConnection);
+    connect(producer, &Producer::newPoint, context, [this](cid_t cid, system_t system, group_t group, point_t point) {
+        relay(&ProducerThread::newPoint, cid, system, group, point);
+    }, Qt::DirectConnection);
+    connect(producer, &Producer::removedPoint, context, [this](cid_t cid, system_t system, group_t group, point_t point) {
+        relay(&ProducerThread::removedPoint, cid, system, group, point);
+    }, Qt::DirectConnection);
+    connect(producer, &Producer::updatedScale, context, [this](address_t address, axis_t axis) {
+        relay(&ProducerThread::updatedScale, address, axis);
+    }, Qt::DirectConnection);
+    connect(producer, &Producer::updatedReferenceFrame, context, [this](address_t address) {
+        relay(&ProducerThread::updatedReferenceFrame, address);
+    }, Qt::DirectConnection);
+    connect(producer, &Producer::updatedLocalPointPriority, context, [this](address_t address) {
+        relay(&ProducerThread::updatedLocalPointPriority, address);
+    }, Qt::DirectConnection);
+    connect(producer, &Producer::updatedLocalPointName, context, [this](address_t address) {
+        relay(&ProducerThread::updatedLocalPointName, address);
+    }, Qt::DirectConnection);
+}
+
+void ProducerThread::lockWorker()
+{
+    if (workerLocked) return;
+    producerLock.lock();
+    workerLocked = true;
+}
+
+void ProducerThread::unlockWorker()
+{
+    if (!workerLocked) return;
+    workerLocked = false;
+    producerLock.unlock();
+}
+
+void ProducerThread::tick()
+{
+    const auto now = pacingClock.nsecsElapsed();
+    if (lastTick >= 0)
+    {
+        const auto interval = std::chrono::nanoseconds(pacingInterval).count();
+        const auto jitter = std::abs((now - lastTick) - interval);
+        tickInterval.record((now - lastTick) / 1000);
+        jitterSum += jitter;
+        jitterMax = std::max(jitterMax, jitter);
+        ++jitterTicks;
+    }
+    lastTick = now;
+
+    applyEdits();
+
+    if (now - windowStart >= std::chrono::nanoseconds(JitterWindow).count())
+    {
+        jitterMean = jitterTicks ? jitterSum / jitterTicks : 0;
+        jitterPeak = jitterMax;
+        jitterSum = 0;
+        jitterMax = 0;
+        jitterTicks = 0;
+        windowStart = now;
+        relay(&ProducerThread::jitterMeasured);
+    }
+}
+
+void ProducerThread::applyEdits()
+{
+    bool applied = false;
+    edit_t edit;
+    while (edits.pop(edit))
+    {
+        edit(*otpProducer);
+        applied = true;
+    }
+
+    // One pending notification is enough, the GUI reads whatever the producer holds by then
+    if (applied && !editsPending.exchange(true))
+        QMetaObject::invokeMethod(this, [this]() {
+            editsPending = false;
+            emit editsApplied();
+        }, Qt::QueuedConnection);
+}
@@ -0,0 +1,165 @@
+/*
+    OTPView
+    A QT Frontend for E1.59  (Entertainment  Technology  Object  Transform  Protocol  (OTP))
+    Copyright (C) 2026  Marcus Birkin
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#ifndef PRODUCERTHREAD_H
+#define PRODUCERTHREAD_H
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QThread>
+#include <QTimer>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "OTPLib.hpp"
+#include "metrics.h"
+#include "spscqueue.h"
+
+/*
+ * OTP producer running on its own thread
+ *
+ * The producer's sockets and transmit timer live on the worker thread,
+ * so its transmit cadence no longer depends on how busy the GUI is.
+ *
+ * Value edits are passed through a lock free queue and applied by a precise pacing tick,
+ * running at the transform message rate, which also measures its own jitter.
+ * Anything else that changes the producer runs on the worker thread while the caller waits,
+ * reads lock the producer instead. The producer is locked by the worker thread for as long
+ * as its event loop is awake, so reads never see it part way through transmitting.
+ *
+ * The producer's signals are re-emitted by this object on the GUI thread,
+ * batched into one queued call each time the worker goes idle,
+ * so a large edit reaches the GUI as a single event rather than one per change
+ */
+class ProducerThread : public QObject
+{
+    Q_OBJECT
+public:
+    typedef std::function<void(OTP::Producer &producer)> edit_t;
+    static constexpr std::size_t QueueCapacity = 256;
+    static constexpr std::chrono::seconds JitterWindow{1};
+
+    typedef struct jitter_s
+    {
+        std::chrono::microseconds mean{0};
+        std::chrono::microseconds max{0};
+    } jitter_t;
+
+    explicit ProducerThread(
+            QNetworkInterface iface,
+            QAbstractSocket::NetworkLayerProtocol transport,
+            OTP::cid_t CID,
+            QString name,
+            std::chrono::milliseconds transformRate,
+            QObject *parent = nullptr);
+    ~ProducerThread();
+
+    // Locked access to the producer, for reads only, held until the returned object is destroyed
+    class Reader
+    {
+    public:
+        explicit Reader(const ProducerThread *owner) : lock(owner->producerLock), producer(owner->otpProducer.get()) {}
+        OTP::Producer *operator->() const { return producer; }
+        OTP::Producer &operator*() const { return *producer; }
+
+    private:
+        std::unique_lock<std::recursive_mutex> lock;
+        OTP::Producer *producer;
+    };
+    Reader read() const { return Reader(this); }
+
+    // Runs on the worker thread and waits for it, for anything but value edits
+    void call(const edit_t &command);
+
+    // Value edits, applied on the next pacing tick without the GUI thread waiting.
+    // The queue has a single writer: only one thread may ever enqueue, the first one to,
+    // and never the worker thread itself, which would wait on itself if the queue were full
+    void enqueue(edit_t edit);
+
+    void setNetworkInterface(QNetworkInterface value);
+    void setNetworkTransport(QAbstractSocket::NetworkLayerProtocol value);
+    void setLocalName(QString value);
+    void setLocalCID(OTP::cid_t value);
+    void setTransformMsgRate(std::chrono::milliseconds value);
+    void addLocalSystem(OTP::system_t system);
+    void removeLocalSystem(OTP::system_t system);
+    void addLocalGroup(OTP::system_t system, OTP::group_t group);
+    void removeLocalGroup(OTP::system_t system, OTP::group_t group);
+    void addLocalPoint(OTP::system_t system, OTP::group_t group, OTP::point_t point, OTP::priority_t priority);
+    void removeLocalPoint(OTP::address_t address);
+    void moveLocalPoint(OTP::address_t oldAddress, OTP::address_t newAddress);
+    void setLocalPointName(OTP::address_t address, QString name);
+
+    // Pacing tick jitter over the last JitterWindow
+    jitter_t getJitter() const;
+
+signals:
+    void newLocalCID(const OTP::cid_t CID);
+    void newPoint(OTP::cid_t cid, OTP::system_t system, OTP::group_t group, OTP::point_t point);
+    void removedPoint(OTP::cid_t cid, OTP::system_t system, OTP::group_t group, OTP::point_t point);
+    void updatedScale(OTP::address_t address, OTP::axis_t axis);
+    void updatedReferenceFrame(OTP::address_t address);
+    void updatedLocalPointPriority(OTP::address_t address);
+    void updatedLocalPointName(OTP::address_t address);
+
+    void editsApplied();
+    void jitterMeasured();
+
+private:
+    void stop();
+
+    // Worker thread
+    void connectProducer();
+    void lockWorker();
+    void unlockWorker();
+    void tick();
+    void applyEdits();
+    template <typename Signal, typename... Args>
+    void relay(Signal signal, Args... args);
+    void flushRelays();
+
+    QThread thread;
+    QObject *context; // Lives on the worker thread
+    std::shared_ptr<class OTP::Producer> otpProducer;
+    mutable std::recursive_mutex producerLock;
+
+    SpscQueue<edit_t, QueueCapacity> edits;
+    std::atomic<bool> editsPending = false;
+    std::atomic<QThread*> editor{nullptr}; // The one thread enqueueing
+
+    // Worker thread only
+    bool workerLocked = false;
+    std::vector<std::function<void()>> pendingRelays;
+    QTimer *pacingTimer = nullptr;
+    std::chrono::milliseconds pacingInterval;
+    QElapsedTimer pacingClock;
+    qint64 lastTick = -1;
+    qint64 windowStart = 0;
+    qint64 jitterSum = 0;
+    qint64 jitterMax = 0;
+    qint64 jitterTicks = 0;
+
+    Histogram &tickInterval;
+    std::atomic<qint64> jitterMean{0};
+    std::atomic<qint64> jitterPeak{0};
+};
+
+#endif // PRODUCERTHREAD_H
@@ -0,0 +1,291 @@
+/*
+    OTPView
+    A QT Frontend for E1.59  (Entertainment  Technology  Object  Transform  Protocol  (OTP))
+    Copyright (C) 2026  Marcus Birkin
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "producertransaction.h"
+#include <QDateTime>
+#include <algorithm>
+#include <optional>
+
+using namespace OTP;
+using namespace OTP::MODULES::STANDARD;
+
+ProducerTransaction::ProducerTransaction(std::shared_ptr<ProducerThread> otpProducer) :
+    otpProducer(otpProducer)
+{}
+
+ProducerTransaction::addressKey_t ProducerTransaction::toKey(address_t address)
+{
+    return {static_cast<quint32>(address.system),
+            static_cast<quint32>(address.group),
+            static_cast<quint32>(address.point)};
+}
+
+address_t ProducerTransaction::fromKey(const addressKey_t &key)
+{
+    return address_t(
+                system_t(std::get<0>(key)),
+                group_t(std::get<1>(key)),
+                point_t(std::get<2>(key)));
+}
+
+void ProducerTransaction::setValue(address_t address, axis_t axis, moduleValue_t moduleValue, qint64 value)
+{
+    if (!address.isValid()) return;
+    values[{toKey(address), moduleValue, axis}] = {false, value};
+}
+
+void ProducerTransaction::offsetValue(address_t address, axis_t axis, moduleValue_t moduleValue, qint64 delta)
+{
+    if (!address.isValid()) return;
+    // Offsetting a pending absolute value keeps it absolute
+    const auto [change, inserted] = values.try_emplace({toKey(address), moduleValue, axis}, valueChange_t{true, 0});
+    Q_UNUSED(inserted)
+    change->second.value += delta;
+}
+
+void ProducerTransaction::setReferenceFrame(address_t address, address_t referenceFrame)
+{
+    if (!address.isValid()) return;
+    referenceFrames[toKey(address)] = referenceFrame;
+}
+
+void ProducerTransaction::setPriority(address_t address, priority_t priority)
+{
+    if (!address.isValid()) return;
+    priorities[toKey(address)] = priority;
+}
+
+void ProducerTransaction::setName(address_t address, const QString &name)
+{
+    if (!address.isValid()) return;
+    names[toKey(address)] = name;
+}
+
+int ProducerTransaction::count() const
+{
+    return static_cast<int>(values.size() + referenceFrames.size() + priorities.size() + names.size());
+}
+
+void ProducerTransaction::clear()
+{
+    values.clear();
+    referenceFrames.clear();
+    priorities.clear();
+    names.clear();
+}
+
+int ProducerTransaction::commit()
+{
+    if (isEmpty()) return 0;
+
+    // Details can't wait for the pacing tick, so their values go with them rather than a tick later
+    if (!referenceFrames.empty() || !priorities.empty() || !names.empty())
+    {
+        int committed = 0;
+        otpProducer->call([this, &committed](Producer &producer) { committed = apply(producer); });
+        return committed;
+    }
+
+    const auto timestamp = static_cast<OTP::timestamp_t>(QDateTime::currentDateTime().toMSecsSinceEpoch());
+    const auto committed = count();
+    otpProducer->enqueue([values = std::move(values), timestamp](Producer &producer) {
+        applyValues(producer, values, timestamp);
+    });
+
+    clear();
+    return committed;
+}
+
+int ProducerTransaction::apply(Producer &producer)
+{
+    if (isEmpty()) return 0;
+
+    const auto timestamp = static_cast<OTP::timestamp_t>(QDateTime::currentDateTime().toMSecsSinceEpoch());
+    const auto committed = count();
+    applyDetails(producer, timestamp);
+    applyValues(producer, values, timestamp);
+
+    clear();
+    return committed;
+}
+
+void ProducerTransaction::applyValues(Producer &producer, const values_t &values, OTP::timestamp_t timestamp)
+{
+    // Points removed since the commit are skipped, rather than setting values nobody sends
+    std::optional<addressKey_t> lastKey;
+    bool exists = false;
+    for (const auto &[key, change] : values)
+    {
+        const auto address = fromKey(std::get<0>(key));
+        if (lastKey != std::get<0>(key))
+        {
+            lastKey = std::get<0>(key);
+            exists = producer.getLocalPoints(address.system, address.group).contains(address.point);
+        }
+        if (!exists) continue;
+
+        applyValue(producer, address, axis_t(std::get<2>(key)),
+                   static_cast<moduleValue_t>(std::get<1>(key)), change, timestamp);
+    }
+}
+
+void ProducerTransaction::applyDetails(Producer &producer, OTP::timestamp_t timestamp) const
+{
+    for (const auto &[key, value] : referenceFrames)
+    {
+        const auto address = fromKey(key);
+        auto referenceFrame = producer.getLocalReferenceFrame(address);
+        // Referencing itself disables the reference frame
+        const auto newTimestamp = (value == address || !value.isValid()) ? 0 : timestamp;
+        if (referenceFrame.value == value && referenceFrame.timestamp == newTimestamp)
+            continue;
+        referenceFrame.value = value;
+        referenceFrame.timestamp = newTimestamp;
+        producer.setLocalReferenceFrame(address, referenceFrame);
+    }
+
+    for (const auto &[key, value] : priorities)
+    {
+        const auto address = fromKey(key);
+        if (producer.getLocalPointPriority(address) == value)
+            continue;
+        producer.setLocalPointPriority(address, value);
+    }
+
+    for (const auto &[key, value] : names)
+    {
+        const auto address = fromKey(key);
+        if (producer.getLocalPointName(address) == value)
+            continue;
+        producer.setLocalPointName(address, value);
+    }
+}
+
+qint64 ProducerTransaction::getValue(
+        const std::shared_ptr<ProducerThread> &otpProducer,
+        address_t address, axis_t axis, moduleValue_t moduleValue)
+{
+    return getValue(*otpProducer->read(), address, axis, moduleValue);
+}
+
+qint64 ProducerTransaction::getValue(
+        Producer &producer,
+        address_t address, axis_t axis, moduleValue_t moduleValue)
+{
+    switch (moduleValue) {
+        case VALUES::POSITION:
+            return producer.getLocalPosition(address, axis).value;
+        case VALUES::POSITION_VELOCITY:
+            return producer.getLocalPositionVelocity(address, axis).value;
+        case VALUES::POSITION_ACCELERATION:
+            return producer.getLocalPositionAcceleration(address, axis).value;
+        case VALUES::ROTATION:
+            return producer.getLocalRotation(address, axis).value;
+        case VALUES::ROTATION_VELOCITY:
+            return producer.getLocalRotationVelocity(address, axis).value;
+        case VALUES::ROTATION_ACCELERATION:
+            return producer.getLocalRotationAcceleration(address, axis).value;
+        case VALUES::SCALE:
+            return producer.getLocalScale(address, axis).value;
+        case VALUES::REFERENCE_FRAME:
+            Q_ASSERT(moduleValue != VALUES::REFERENCE_FRAME); // Not an axis value
+            break;
+    }
+    return 0;
+}
+
+bool ProducerTransaction::applyValue(
+        Producer &producer,
+        address_t address, axis_t axis, moduleValue_t moduleValue,
+        const valueChange_t &change, OTP::timestamp_t timestamp)
+{
+    const auto oldValue = getValue(producer, address, axis, moduleValue);
+    auto newValue = change.relative ? oldValue + change.value : change.value;
+
+    const auto range = VALUES::RANGES::getRange(moduleValue);
+    const auto min = static_cast<qint64>(range.getMin());
+    const auto max = static_cast<qint64>(range.getMax());
+    if (moduleValue == VALUES::ROTATION)
+    {
+        // Rotation wraps around, rather than stopping at the limits
+        const auto span = max - min + 1;
+        newValue = min + (((newValue - min) % span) + span) % span;
+    } else {
+        newValue = std::clamp(newValue, min, max);
+    }
+
+    if (newValue == oldValue)
+        return false;
+
+    switch (moduleValue) {
+        case VALUES::POSITION:
+        {
+            auto position = producer.getLocalPosition(address, axis);
+            position.timestamp = timestamp;
+            position.value = static_cast<decltype(position.value)>(newValue);
+            producer.setLocalPosition(address, axis, position); break;
+        }
+        case VALUES::POSITION_VELOCITY:
+        {
+            auto positionVel = producer.getLocalPositionVelocity(address, axis);
+            positionVel.timestamp = timestamp;
+            positionVel.value = static_cast<decltype(positionVel.value)>(newValue);
+            producer.setLocalPositionVelocity(address, axis, positionVel); break;
+        }
+        case VALUES::POSITION_ACCELERATION:
+        {
+            auto positionAccel = producer.getLocalPositionAcceleration(address, axis);
+            positionAccel.timestamp = timestamp;
+            positionAccel.value = static_cast<decltype(positionAccel.value)>(newValue);
+            producer.setLocalPositionAcceleration(address, axis, positionAccel); break;
+        }
+        case VALUES::ROTATION:
+        {
+            auto rotation = producer.getLocalRotation(address, axis);
+            rotation.timestamp = timestamp;
+            rotation.value = static_cast<decltype(rotation.value)>(newValue);
+            producer.setLocalRotation(address, axis, rotation); break;
+        }
+        case VALUES::ROTATION_VELOCITY:
+        {
+            auto rotationVel = producer.getLocalRotationVelocity(address, axis);
+            rotationVel.timestamp = timestamp;
+            rotationVel.value = static_cast<decltype(rotationVel.value)>(newValue);
+            producer.setLocalRotationVelocity(address, axis, rotationVel); break;
+        }
+        case VALUES::ROTATION_ACCELERATION:
+        {
+            auto rotationAccel = producer.getLocalRotationAcceleration(address, axis);
+            rotationAccel.timestamp = timestamp;
+            rotationAccel.value = static_cast<decltype(rotationAccel.value)>(newValue);
+            producer.setLocalRotationAcceleration(address, axis, rotationAccel); break;
+        }
+        case VALUES::SCALE:
+        {
+            auto scale = producer.getLocalScale(address, axis);
+            scale.timestamp = timestamp;
+            scale.value = static_cast<decltype(scale.value)>(newValue);
+            producer.setLocalScale(address, axis, scale); break;
+        }
+        case VALUES::REFERENCE_FRAME:
+            Q_ASSERT(moduleValue != VALUES::REFERENCE_FRAME); // Not an axis value
+            return false;
+    }
+
+    return true;
+}
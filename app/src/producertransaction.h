@@ -0,0 +1,100 @@
+/*
+    OTPView
+    A QT Frontend for E1.59  (Entertainment  Technology  Object  Transform  Protocol  (OTP))
+    Copyright (C) 2026  Marcus Birkin
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#ifndef PRODUCERTRANSACTION_H
+#define PRODUCERTRANSACTION_H
+
+#include <QString>
+#include <map>
+#include <memory>
+#include <tuple>
+#include "OTPLib.hpp"
+#include "producerthread.h"
+
+/*
+ * Collects point updates for a producer and applies them in one pass
+ *
+ * Repeated updates to the same address, module and axis are merged,
+ * offsets are resolved against the producer's value when applied
+ * and unchanged values are skipped. Every value in a commit shares one timestamp.
+ *
+ * A commit of values only is queued to the producer thread and applied on its next pacing tick,
+ * one with names, priorities or reference frames is applied whole, values included, before commit() returns.
+ * Either way the producer never transmits part of a commit.
+ * The producer's own signals are left alone, ProducerThread batches what reaches the windows
+ */
+class ProducerTransaction
+{
+public:
+    typedef OTP::MODULES::STANDARD::VALUES::moduleValue_t moduleValue_t;
+
+    explicit ProducerTransaction(std::shared_ptr<ProducerThread> otpProducer);
+
+    void setValue(OTP::address_t address, OTP::axis_t axis, moduleValue_t moduleValue, qint64 value);
+    void offsetValue(OTP::address_t address, OTP::axis_t axis, moduleValue_t moduleValue, qint64 delta);
+    void setReferenceFrame(OTP::address_t address, OTP::address_t referenceFrame);
+    void setPriority(OTP::address_t address, OTP::priority_t priority);
+    void setName(OTP::address_t address, const QString &name);
+
+    bool isEmpty() const { return !count(); }
+    int count() const;
+    void clear();
+
+    // Number of changes committed, values still to be applied included
+    int commit();
+
+    // Applies everything at once, on the producer thread, from within ProducerThread::call()
+    int apply(OTP::Producer &producer);
+
+    static qint64 getValue(
+            const std::shared_ptr<ProducerThread> &otpProducer,
+            OTP::address_t address, OTP::axis_t axis, moduleValue_t moduleValue);
+    static qint64 getValue(
+            OTP::Producer &producer,
+            OTP::address_t address, OTP::axis_t axis, moduleValue_t moduleValue);
+
+private:
+    typedef std::tuple<quint32, quint32, quint32> addressKey_t;
+    static addressKey_t toKey(OTP::address_t address);
+    static OTP::address_t fromKey(const addressKey_t &key);
+
+    typedef std::tuple<addressKey_t, int, int> valueKey_t; // Address, Module, Axis
+    typedef struct valueChange_t
+    {
+        bool relative = false;
+        qint64 value = 0;
+    } valueChange_t;
+
+    typedef std::map<valueKey_t, valueChange_t> values_t;
+
+    // Producer thread
+    static void applyValues(OTP::Producer &producer, const values_t &values, OTP::timestamp_t timestamp);
+    static bool applyValue(OTP::Producer &producer,
+                           OTP::address_t address, OTP::axis_t axis, moduleValue_t moduleValue,
+                           const valueChange_t &change, OTP::timestamp_t timestamp);
+    void applyDetails(OTP::Producer &producer, OTP::timestamp_t timestamp) const;
+
+    std::shared_ptr<ProducerThread> otpProducer;
+
+    values_t values;
+    std::map<addressKey_t, OTP::address_t> referenceFrames;
+    std::map<addressKey_t, OTP::priority_t> priorities;
+    std::map<addressKey_t, QString> names;
+};
+
+#endif // PRODUCERTRANSACTION_H
@@ -20,7 +20,12 @@
 #include "ui_producerwindow.h"
 #include "settings.h"
 #include "groupselectiondialog.h"
+#include "producerscene.h"
+#include "scenecrossfade.h"
+#include <QFileDialog>
+#include <QInputDialog>
 #include <QMdiSubWindow>
+#include <QMessageBox>
 #include <QSettings>
 
 using namespace OTP;
@@ -35,13 +40,18 @@ ProducerWindow::ProducerWindow(const QString &componentSettingsGroup, QMainWindo
     updateWindowTitle();
 
     // OTP Producer Object
-    otpProducer.reset(new class Producer(
+    otpProducer.reset(new ProducerThread(
                           Settings::getInstance().getNetworkInterface(),
                           Settings::getInstance().getNetworkTransport(),
                           Settings::getInstance().getComponentSettings(componentSettingsGroup).CID,
                           Settings::getInstance().getComponentSettings(componentSettingsGroup).Name,
-                          Settings::getInstance().getTransformMessageRate(),
-                          this));
+                          Settings::getInstance().getTransformMessageRate()));
+
+    // Pacing jitter, of the tick applying edits rather than OTPLib's own transmit timer
+    lblJitter = new QLabel(this);
+    ui->statusbar->addPermanentWidget(lblJitter);
+    connect(otpProducer.get(), &ProducerThread::jitterMeasured, this, &ProducerWindow::updateJitter);
+    updateJitter();
 
     // OTP Producer Interface
     connect(&Settings::getInstance(), &Settings::newNetworkInterface,
@@ -66,7 +76,7 @@ ProducerWindow::ProducerWindow(const QString &componentSettingsGroup, QMainWindo
                 saveComponentDetails();
                 updateWindowTitle();
             });
-    ui->leProducerName->setText(otpProducer->getLocalName());
+    ui->leProducerName->setText(otpProducer->read()->getLocalName());
     ui->leProducerName->setMaxLength(PDU::NAME_LENGTH);
 
     // OTP Producer CID
@@ -74,17 +84,18 @@ ProducerWindow::ProducerWindow(const QString &componentSettingsGroup, QMainWindo
             this, [this]() {
                 otpProducer->setLocalCID(cid_t::createUuid());
             });
-    connect(otpProducer.get(), &Producer::newLocalCID, this,
+    connect(otpProducer.get(), &ProducerThread::newLocalCID, this,
             [this](const cid_t CID) {
                 ui->lblProducerCID->setText(CID.toString());
                 saveComponentDetails();
             });
-    ui->lblProducerCID->setText(otpProducer->getLocalCID().toString());
+    ui->lblProducerCID->setText(otpProducer->read()->getLocalCID().toString());
 
     // OTP Producer System
     otpProducer->addLocalSystem(static_cast<system_t>(ui->sbSystem->value()));
     connect(ui->sbSystem, qOverload<OTP::system_t, OTP::system_t>(&SystemSpinBox::valueChanged),
             this, [this](OTP::system_t oldValue, OTP::system_t newValue) {
+                stopCrossfade();
                 otpProducer->addLocalSystem(newValue);
                 for (const auto &subWindow : ui->mdiArea->subWindowList())
                     static_cast<GroupWindow*>(subWindow->widget())->setSystem(newValue);
@@ -123,20 +134,21 @@ void ProducerWindow::updateStatusBar()
     QString message = QObject::tr("Not connected");
     if (otpProducer)
     {
+        const auto producer = otpProducer->read();
         message = QObject::tr("Selected interface: %1").arg(
-                    otpProducer->getNetworkInterface().humanReadableName());
+                    producer->getNetworkInterface().humanReadableName());
 
-        if ((otpProducer->getNetworkTransport() == QAbstractSocket::IPv4Protocol) ||
-                (otpProducer->getNetworkTransport() == QAbstractSocket::AnyIPProtocol))
+        if ((producer->getNetworkTransport() == QAbstractSocket::IPv4Protocol) ||
+                (producer->getNetworkTransport() == QAbstractSocket::AnyIPProtocol))
         {
-            auto status = otpProducer->getNetworkinterfaceState(QAbstractSocket::IPv4Protocol);
+            auto status = producer->getNetworkinterfaceState(QAbstractSocket::IPv4Protocol);
             message.append(QString(" OTP-4 (%1)").arg(status == QAbstractSocket::BoundState ? tr("OK") : tr("Error")));
         }
 
-        if ((otpProducer->getNetworkTransport() == QAbstractSocket::IPv6Protocol) ||
-                (otpProducer->getNetworkTransport() == QAbstractSocket::AnyIPProtocol))
+        if ((producer->getNetworkTransport() == QAbstractSocket::IPv6Protocol) ||
+                (producer->getNetworkTransport() == QAbstractSocket::AnyIPProtocol))
         {
-            auto status = otpProducer->getNetworkinterfaceState(QAbstractSocket::IPv6Protocol);
+            auto status = producer->getNetworkinterfaceState(QAbstractSocket::IPv6Protocol);
             message.append(QString(" OTP-6 (%1)").arg(status == QAbstractSocket::BoundState ? tr("OK") : tr("Error")));
         }
     }
@@ -144,6 +156,14 @@ void ProducerWindow::updateStatusBar()
     ui->statusbar->showMessage(message);
 }
 
+void ProducerWindow::updateJitter()
+{
+    const auto jitter = otpProducer->getJitter();
+    lblJitter->setText(tr("Pacing jitter: %1 ms avg, %2 ms max").arg(
+                           QString::number(jitter.mean.count() / 1000.0, 'f', 2),
+                           QString::number(jitter.max.count() / 1000.0, 'f', 2)));
+}
+
 void ProducerWindow::updateWindowTitle()
 {
 this->setWindowTitle(
@@ -155,20 +175,127 @@ this->setWindowTitle(
 
 void ProducerWindow::saveComponentDetails()
 {
-    Settings::componentDetails_t details(otpProducer->getLocalName(), otpProducer->getLocalCID());
+    const auto producer = otpProducer->read();
+    Settings::componentDetails_t details(producer->getLocalName(), producer->getLocalCID());
     Settings::getInstance().setComponentSettings(componentSettingsGroup, details);
 }
 
 void ProducerWindow::on_actionNew_Group_triggered()
 {
     auto system = static_cast<system_t>(ui->sbSystem->value());
-    auto dialog = new GroupSelectionDialog(otpProducer->getLocalGroups(system), this);
+    auto dialog = new GroupSelectionDialog(otpProducer->read()->getLocalGroups(system), this);
     if (dialog->exec() == QDialog::Rejected)
         return;
 
-    auto group = dialog->getGroup();
+    openGroupWindow(dialog->getGroup());
+}
+
+GroupWindow *ProducerWindow::openGroupWindow(OTP::group_t group)
+{
+    auto system = static_cast<system_t>(ui->sbSystem->value());
     auto mdiWindow = new GroupWindow(otpProducer, system, group, this);
     mdiWindow->setAttribute(Qt::WA_DeleteOnClose);
     ui->mdiArea->addSubWindow(mdiWindow);
     mdiWindow->show();
+    return mdiWindow;
+}
+
+void ProducerWindow::on_actionSave_Scene_triggered()
+{
+    auto fileName = QFileDialog::getSaveFileName(
+                this, tr("Save Scene"), QString(),
+                tr("Scene (*.otpscene);;JSON Scene (*.json)"));
+    if (fileName.isEmpty())
+        return;
+
+    auto scene = ProducerScene::capture(otpProducer, static_cast<system_t>(ui->sbSystem->value()));
+    QString errorString;
+    if (!scene.save(fileName, &errorString))
+        QMessageBox::warning(this, tr("Save Scene"),
+                             tr("Unable to save %1\n%2").arg(fileName, errorString));
+}
+
+bool ProducerWindow::loadScene(ProducerScene &scene, const QString &title)
+{
+    auto fileName = QFileDialog::getOpenFileName(
+                this, title, QString(),
+                tr("Scene (*.otpscene *.json);;All files (*)"));
+    if (fileName.isEmpty())
+        return false;
+
+    QString errorString;
+    if (!scene.load(fileName, &errorString))
+    {
+        QMessageBox::warning(this, title,
+                             tr("Unable to load %1\n%2").arg(fileName, errorString));
+        return false;
+    }
+    return true;
+}
+
+void ProducerWindow::on_actionRecall_Scene_triggered()
+{
+    ProducerScene scene;
+    if (!loadScene(scene, tr("Recall Scene")))
+        return;
+
+    stopCrossfade();
+    recallScene(scene);
+}
+
+void ProducerWindow::on_actionCrossfade_Scene_triggered()
+{
+    ProducerScene scene;
+    if (!loadScene(scene, tr("Crossfade to Scene")))
+        return;
+
+    bool ok;
+    auto seconds = QInputDialog::getDouble(
+                this, tr("Crossfade to Scene"), tr("Duration (seconds)"),
+                5.0, 0.0, 3600.0, 1, &ok);
+    if (!ok)
+        return;
+
+    stopCrossfade();
+    auto system = static_cast<system_t>(ui->sbSystem->value());
+    crossfade = new SceneCrossfade(
+                otpProducer, system,
+                ProducerScene::capture(otpProducer, system), scene,
+                std::chrono::milliseconds(qRound64(seconds * 1000)),
+                Settings::getInstance().getTransformMessageRate(),
+                this);
+    connect(crossfade, &SceneCrossfade::finished, this, [this, scene]() {
+        // Anything not faded, such as names or added points, arrives with the final scene
+        stopCrossfade();
+        recallScene(scene);
+    });
+    crossfade->start();
+}
+
+void ProducerWindow::stopCrossfade()
+{
+    if (!crossfade) return;
+    crossfade->stop();
+    crossfade->deleteLater();
+    crossfade = nullptr;
+}
+
+void ProducerWindow::recallScene(const ProducerScene &scene)
+{
+    // Groups only exist while they have a window
+    const auto groups = scene.getGroups();
+    QList<group_t> openGroups;
+    for (const auto &subWindow : ui->mdiArea->subWindowList())
+    {
+        const auto group = static_cast<GroupWindow*>(subWindow->widget())->getGroup();
+        if (groups.contains(group))
+            openGroups << group;
+        else
+            subWindow->close();
+    }
+    for (const auto &group : groups)
+        if (!openGroups.contains(group))
+            openGroupWindow(group);
+
+    scene.recall(otpProducer, static_cast<system_t>(ui->sbSystem->value()));
 }
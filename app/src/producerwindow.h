@@ -19,10 +19,12 @@
 #ifndef PRODUCERWINDOW_H
 #define PRODUCERWINDOW_H
 
+#include <QLabel>
 #include <QMainWindow>
 #include <map>
 #include "OTPLib.hpp"
 #include "groupwindow.h"
+#include "producerthread.h"
 
 namespace Ui {
 class ProducerWindow;
@@ -40,16 +42,28 @@ private slots:
     void showEvent(QShowEvent *event);
     void closeEvent(QCloseEvent *event);
     void on_actionNew_Group_triggered();
+    void on_actionSave_Scene_triggered();
+    void on_actionRecall_Scene_triggered();
+    void on_actionCrossfade_Scene_triggered();
 
 private:
     Ui::ProducerWindow *ui;
     void updateStatusBar();
+    void updateJitter();
+    QLabel *lblJitter;
     void updateWindowTitle();
 
+    GroupWindow *openGroupWindow(OTP::group_t group);
+    void recallScene(const class ProducerScene &scene);
+    bool loadScene(class ProducerScene &scene, const QString &title);
+
+    class SceneCrossfade *crossfade = nullptr;
+    void stopCrossfade();
+
     QString componentSettingsGroup;
     void saveComponentDetails();
 
-    std::shared_ptr<class OTP::Producer> otpProducer;
+    std::shared_ptr<ProducerThread> otpProducer;
 };
 
 #endif // PRODUCERWINDOW_H
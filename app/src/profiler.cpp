@@ -0,0 +1,180 @@
+/*
+    OTPView
+    A QT Frontend for E1.59  (Entertainment  Technology  Object  Transform  Protocol  (OTP))
+    Copyright (C) 2026  Marcus Birkin
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "profiler.h"
+#include <QApplication>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <algorithm>
+
+std::atomic<bool> Profiler::enabled = false;
+
+Profiler::Profiler()
+{
+    probeTimer.setTimerType(Qt::PreciseTimer);
+    probeTimer.setInterval(ProbeInterval);
+    connect(&probeTimer, &QTimer::timeout, this, &Profiler::probe);
+
+    summaryTimer.setInterval(std::chrono::seconds(1));
+    connect(&summaryTimer, &QTimer::timeout, this, &Profiler::summarise);
+}
+
+Profiler &Profiler::getInstance()
+{
+    static Profiler instance;
+    return instance;
+}
+
+void Profiler::setEnabled(bool value)
+{
+    if (value == isEnabled()) return;
+    enabled = value;
+
+    if (value)
+    {
+        trace.clear();
+        trace.reserve(TraceCapacity);
+        traceNext = 0;
+        summaries.clear();
+        sections.clear();
+        probes = 0;
+        latencySum = 0;
+        latencyMax = 0;
+        lastProbe = -1;
+        probeTimer.start();
+        summaryTimer.start();
+    } else {
+        probeTimer.stop();
+        summaryTimer.stop();
+    }
+}
+
+void Profiler::record(const char *name, qint64 start, qint64 end)
+{
+    const auto duration = end - start;
+    append({name, 'X', start, duration});
+
+    auto &section = sections[name];
+    const auto durationMs = static_cast<double>(duration) / 1e6;
+    ++section.count;
+    section.totalMs += durationMs;
+    section.maxMs = std::max(section.maxMs, durationMs);
+}
+
+void Profiler::append(const event_t &event)
+{
+    // Rolling, the oldest events are overwritten once full
+    if (trace.size() < static_cast<size_t>(TraceCapacity))
+        trace.push_back(event);
+    else
+        trace[traceNext] = event;
+    traceNext = (traceNext + 1) % TraceCapacity;
+}
+
+void Profiler::probe()
+{
+    const auto now = Metrics::now();
+    if (lastProbe >= 0)
+    {
+        // How much later than asked the event loop got round to the timer
+        const auto interval = std::chrono::nanoseconds(ProbeInterval).count();
+        const auto latency = std::max<qint64>(0, (now - lastProbe) - interval);
+        append({"Event loop latency", 'C', now, latency});
+        ++probes;
+        latencySum += latency;
+        latencyMax = std::max(latencyMax, latency);
+    }
+    lastProbe = now;
+}
+
+void Profiler::summarise()
+{
+    summary_t summary;
+    summary.time = QDateTime::currentDateTime();
+    summary.probes = probes;
+    summary.eventLoopLatencyMeanMs = probes ? static_cast<double>(latencySum) / probes / 1e6 : 0;
+    summary.eventLoopLatencyMaxMs = static_cast<double>(latencyMax) / 1e6;
+    for (auto it = sections.cbegin(); it != sections.cend(); ++it)
+    {
+        // The same name may be a different literal in another translation unit
+        auto &section = summary.sections[QString::fromUtf8(it.key())];
+        section.count += it->count;
+        section.totalMs += it->totalMs;
+        section.maxMs = std::max(section.maxMs, it->maxMs);
+    }
+
+    summaries.append(summary);
+    while (summaries.count() > SummaryHistory)
+        summaries.removeFirst();
+
+    probes = 0;
+    latencySum = 0;
+    latencyMax = 0;
+    sections.clear();
+
+    emit summarised();
+}
+
+bool Profiler::exportTrace(const QString &fileName, QString *errorString) const
+{
+    QJsonArray events;
+    events.append(QJsonObject{
+        {"name", "process_name"}, {"ph", "M"}, {"pid", 1}, {"tid", 1},
+        {"args", QJsonObject{{"name", QApplication::applicationName()}}}});
+    events.append(QJsonObject{
+        {"name", "thread_name"}, {"ph", "M"}, {"pid", 1}, {"tid", 1},
+        {"args", QJsonObject{{"name", "GUI"}}}});
+
+    // Oldest first, timestamps and durations in microseconds
+    const auto wrapped = (trace.size() == static_cast<size_t>(TraceCapacity));
+    for (size_t i = 0; i < trace.size(); ++i)
+    {
+        const auto &event = trace[wrapped ? (traceNext + i) % trace.size() : i];
+        QJsonObject json{
+            {"name", QString::fromUtf8(event.name)},
+            {"ph", QString(QChar(event.phase))},
+            {"ts", static_cast<double>(event.start) / 1000},
+            {"pid", 1},
+            {"tid", 1}};
+        if (event.phase == 'X')
+            json.insert("dur", static_cast<double>(event.value) / 1000);
+        else
+            json.insert("args", QJsonObject{{"ms", static_cast<double>(event.value) / 1e6}});
+        events.append(json);
+    }
+
+    QJsonObject root;
+    root.insert("traceEvents", events);
+    root.insert("displayTimeUnit", "ms");
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        if (errorString) *errorString = file.errorString();
+        return false;
+    }
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    if (!file.flush())
+    {
+        if (errorString) *errorString = file.errorString();
+        return false;
+    }
+    return true;
+}
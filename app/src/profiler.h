@@ -0,0 +1,139 @@
+/*
+    OTPView
+    A QT Frontend for E1.59  (Entertainment  Technology  Object  Transform  Protocol  (OTP))
+    Copyright (C) 2026  Marcus Birkin
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <QDateTime>
+#include <QHash>
+#include <QList>
+#include <QMap>
+#include <QObject>
+#include <QTimer>
+#include <atomic>
+#include <chrono>
+#include <vector>
+#include "metrics.h"
+
+/*
+ * Opt in GUI thread profiler
+ *
+ * While enabled, a precise probe timer measures how late the event loop is to service it,
+ * and every ProfileScope records how long its section took. Both go into a rolling trace,
+ * exportable as Chrome trace event JSON (chrome://tracing, Perfetto), and into per second summaries.
+ * Disabled, a ProfileScope costs a single relaxed atomic load.
+ *
+ * GUI thread only. Enabled from the diagnostics dialog, or at start up with OTPVIEW_PROFILE set
+ */
+class Profiler final : public QObject
+{
+    Q_OBJECT
+public:
+    static constexpr int TraceCapacity = 100000;
+    static constexpr int SummaryHistory = 60;
+    static constexpr std::chrono::milliseconds ProbeInterval{10};
+
+    typedef struct section_s
+    {
+        int count = 0;
+        double totalMs = 0;
+        double maxMs = 0;
+    } section_t;
+
+    typedef struct summary_s
+    {
+        QDateTime time;
+        int probes = 0;
+        double eventLoopLatencyMeanMs = 0;
+        double eventLoopLatencyMaxMs = 0;
+        QMap<QString, section_t> sections;
+    } summary_t;
+
+    static Profiler &getInstance();
+    static bool isEnabled() { return enabled.load(std::memory_order_relaxed); }
+    void setEnabled(bool value);
+
+    void record(const char *name, qint64 start, qint64 end);
+
+    QList<summary_t> getSummaries() const { return summaries; } // Oldest first
+    bool exportTrace(const QString &fileName, QString *errorString = nullptr) const;
+
+signals:
+    void summarised();
+
+private:
+    Profiler();
+    ~Profiler() = default;
+
+    void probe();
+    void summarise();
+
+    typedef struct event_s
+    {
+        const char *name;
+        char phase; // 'X' section, 'C' event loop latency
+        qint64 start;
+        qint64 value; // Duration or latency, nanoseconds
+    } event_t;
+    void append(const event_t &event);
+
+    static std::atomic<bool> enabled;
+
+    QTimer probeTimer;
+    QTimer summaryTimer;
+    qint64 lastProbe = -1;
+
+    std::vector<event_t> trace;
+    size_t traceNext = 0;
+
+    // Current second
+    int probes = 0;
+    qint64 latencySum = 0;
+    qint64 latencyMax = 0;
+    QHash<const char*, section_t> sections;
+
+    QList<summary_t> summaries;
+};
+
+/*
+ * Times the enclosing scope, when the profiler is enabled
+ *
+ * The name must outlive the profiler's trace, in practice a string literal
+ */
+class ProfileScope
+{
+public:
+    explicit ProfileScope(const char *name)
+    {
+        if (!Profiler::isEnabled()) return;
+        this->name = name;
+        start = Metrics::now();
+    }
+    ~ProfileScope()
+    {
+        if (name) Profiler::getInstance().record(name, start, Metrics::now());
+    }
+    ProfileScope(const ProfileScope &) = delete;
+    ProfileScope &operator=(const ProfileScope &) = delete;
+
+private:
+    const char *name = nullptr;
+    qint64 start = 0;
+};
+
+#endif // PROFILER_H
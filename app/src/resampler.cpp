@@ -0,0 +1,106 @@
+/*
+    OTPView
+    A QT Frontend for E1.59  (Entertainment  Technology  Object  Transform  Protocol  (OTP))
+    Copyright (C) 2026  Marcus Birkin
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "resampler.h"
+#include <algorithm>
+#include <cmath>
+
+Resampler::Resampler(mode_t mode, const std::vector<double> &wrapSpans, qint64 extrapolationLimit) :
+    mode(mode),
+    wrapSpans(wrapSpans),
+    extrapolationLimit(extrapolationLimit),
+    previous(wrapSpans.size()),
+    latest(wrapSpans.size())
+{}
+
+int Resampler::addPoint()
+{
+    if (!freeSlots.empty())
+    {
+        const auto slot = freeSlots.back();
+        freeSlots.pop_back();
+        return slot;
+    }
+
+    for (auto *channels : {&previous, &latest})
+        for (auto &values : *channels)
+            values.push_back(0);
+    previousTime.push_back(0);
+    latestTime.push_back(0);
+    sampleCount.push_back(0);
+    return getSlotCount() - 1;
+}
+
+void Resampler::removePoint(int slot)
+{
+    sampleCount[slot] = 0;
+    freeSlots.push_back(slot);
+}
+
+void Resampler::beginSample(int slot, qint64 time)
+{
+    for (size_t channel = 0; channel < latest.size(); ++channel)
+        previous[channel][slot] = latest[channel][slot];
+    previousTime[slot] = latestTime[slot];
+    latestTime[slot] = time;
+    sampleCount[slot] = std::min(sampleCount[slot] + 1, 2);
+}
+
+void Resampler::sample(qint64 time, std::vector<std::vector<double>> &out)
+{
+    const auto count = latestTime.size();
+    out.resize(latest.size());
+    for (auto &values : out)
+        values.resize(count);
+
+    // Every mode is latest + (latest - previous) * factor, worked out once per slot
+    factors.resize(count);
+    for (size_t slot = 0; slot < count; ++slot)
+    {
+        const auto interval = latestTime[slot] - previousTime[slot];
+        if (sampleCount[slot] < 2 || interval <= 0 || mode == Hold)
+        {
+            factors[slot] = 0;
+            continue;
+        }
+
+        const auto since = static_cast<double>(time - latestTime[slot]);
+        if (mode == Linear)
+            factors[slot] = std::clamp(since / static_cast<double>(interval), 0.0, 1.0) - 1.0;
+        else
+            factors[slot] = std::clamp(since, 0.0, static_cast<double>(extrapolationLimit)) / static_cast<double>(interval);
+    }
+
+    // Plain loops over contiguous arrays, left for the compiler to vectorise
+    const auto *factor = factors.data();
+    for (size_t channel = 0; channel < latest.size(); ++channel)
+    {
+        const auto *from = previous[channel].data();
+        const auto *to = latest[channel].data();
+        auto *values = out[channel].data();
+        const auto span = wrapSpans[channel];
+        if (span > 0)
+        {
+            for (size_t slot = 0; slot < count; ++slot)
+                values[slot] = to[slot] + std::remainder(to[slot] - from[slot], span) * factor[slot];
+        } else {
+            for (size_t slot = 0; slot < count; ++slot)
+                values[slot] = to[slot] + (to[slot] - from[slot]) * factor[slot];
+        }
+    }
+}
@@ -0,0 +1,80 @@
+/*
+    OTPView
+    A QT Frontend for E1.59  (Entertainment  Technology  Object  Transform  Protocol  (OTP))
+    Copyright (C) 2026  Marcus Birkin
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#ifndef RESAMPLER_H
+#define RESAMPLER_H
+
+#include <QtGlobal>
+#include <vector>
+
+/*
+ * Converts point streams arriving at one rate into values at any other time
+ *
+ * Every point keeps its latest and previous sample, held as one contiguous array
+ * per channel across all points, so sampling tens of thousands of points is
+ * a handful of plain loops. Points are addressed by slot, freed slots are reused.
+ *
+ * Hold gives the latest sample. Linear interpolates between the previous and latest sample,
+ * running one input interval behind to do so. Extrapolate continues from the latest sample
+ * at the rate between the two, for no longer than the extrapolation limit.
+ * Channels with a wrap span (rotations) change the short way around.
+ * Times are in nanoseconds, as Metrics::now()
+ */
+class Resampler
+{
+public:
+    typedef enum mode_e
+    {
+        Hold,
+        Linear,
+        Extrapolate
+    } mode_t;
+
+    // A wrap span per channel, 0 for none
+    Resampler(mode_t mode, const std::vector<double> &wrapSpans, qint64 extrapolationLimit);
+
+    mode_t getMode() const { return mode; }
+    int getChannelCount() const { return static_cast<int>(latest.size()); }
+    int getSlotCount() const { return static_cast<int>(latestTime.size()); }
+
+    int addPoint();
+    void removePoint(int slot);
+    bool isActive(int slot) const { return sampleCount[slot] > 0; }
+
+    // Starts a new sample, the latest becomes the previous
+    void beginSample(int slot, qint64 time);
+    void setValue(int channel, int slot, double value) { latest[channel][slot] = value; }
+
+    // Every slot at time, one array per channel, values of inactive slots are meaningless
+    void sample(qint64 time, std::vector<std::vector<double>> &out);
+
+private:
+    mode_t mode;
+    std::vector<double> wrapSpans;
+    qint64 extrapolationLimit;
+
+    std::vector<std::vector<double>> previous; // Per channel
+    std::vector<std::vector<double>> latest; // Per channel
+    std::vector<qint64> previousTime;
+    std::vector<qint64> latestTime;
+    std::vector<int> sampleCount; // Up to 2, 0 when free
+    std::vector<int> freeSlots;
+    std::vector<double> factors;
+};
+
+#endif // RESAMPLER_H
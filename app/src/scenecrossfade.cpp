@@ -0,0 +1,345 @@
+/*
+    OTPView
+    A QT Frontend for E1.59  (Entertainment  Technology  Object  Transform  Protocol  (OTP))
+    Copyright (C) 2026  Marcus Birkin
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "scenecrossfade.h"
+#include "producertransaction.h"
+#include <QMutexLocker>
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+using namespace OTP;
+using namespace OTP::MODULES::STANDARD;
+
+namespace {
+    // Rotations are in millionths of a degree
+    constexpr double Pi = 3.14159265358979323846;
+    constexpr double RotationToRadians = Pi / 180.0 / 1000000.0;
+    constexpr double RadiansToRotation = 1.0 / RotationToRadians;
+    constexpr double HalfTurn = 180.0 * 1000000.0;
+    constexpr double FullTurn = 2 * HalfTurn;
+
+    // Signed difference between two rotations, within half a turn
+    double wrapRotation(double angle) { return std::remainder(angle, FullTurn); }
+
+    // Eases in and out of the fade
+    double smoothStep(double t) { return t * t * (3.0 - 2.0 * t); }
+}
+
+SceneCrossfade::SceneCrossfade(
+        std::shared_ptr<ProducerThread> otpProducer,
+        OTP::system_t system,
+        const ProducerScene &from,
+        const ProducerScene &to,
+        std::chrono::milliseconds duration,
+        std::chrono::milliseconds tickInterval,
+        QObject *parent) : QObject(parent),
+    otpProducer(otpProducer),
+    system(system),
+    duration(duration),
+    tickInterval(std::max(tickInterval, std::chrono::milliseconds(1)))
+{
+    // Pair up the points common to both scenes, both are sorted
+    std::vector<std::pair<const ProducerScene::scenePoint_t*, const ProducerScene::scenePoint_t*>> pairs;
+    {
+        auto fromIt = from.getPoints().cbegin();
+        auto toIt = to.getPoints().cbegin();
+        while (fromIt != from.getPoints().cend() && toIt != to.getPoints().cend())
+        {
+            const auto fromKey = std::make_pair(fromIt->group, fromIt->point);
+            const auto toKey = std::make_pair(toIt->group, toIt->point);
+            if (fromKey < toKey)
+                ++fromIt;
+            else if (toKey < fromKey)
+                ++toIt;
+            else
+                pairs.emplace_back(&*fromIt++, &*toIt++);
+        }
+    }
+
+    addresses.reserve(pairs.size());
+    for (const auto &[fromPoint, toPoint] : pairs)
+        addresses.emplace_back(system, fromPoint->group, fromPoint->point);
+
+    // Only keep the channels that actually change
+    bool rotationChanges = false;
+    for (size_t module = 0; module < ProducerScene::modules.size(); ++module)
+    {
+        const auto moduleValue = ProducerScene::modules[module];
+        for (auto axis = axis_t::first; axis < axis_t::count; ++axis)
+        {
+            const auto changes = std::any_of(pairs.cbegin(), pairs.cend(), [&](const auto &pair) {
+                return pair.first->values[module][axis] != pair.second->values[module][axis];
+            });
+            if (!changes) continue;
+
+            if (moduleValue == VALUES::ROTATION)
+            {
+                rotationChanges = true;
+                continue;
+            }
+
+            channel_t channel{moduleValue, axis, {}, {}};
+            channel.from.reserve(pairs.size());
+            channel.to.reserve(pairs.size());
+            for (const auto &[fromPoint, toPoint] : pairs)
+            {
+                channel.from.push_back(static_cast<double>(fromPoint->values[module][axis]));
+                channel.to.push_back(static_cast<double>(toPoint->values[module][axis]));
+            }
+            channels.push_back(std::move(channel));
+        }
+    }
+
+    if (rotationChanges)
+    {
+        const auto rotationModule = static_cast<size_t>(
+                    std::distance(ProducerScene::modules.cbegin(),
+                                  std::find(ProducerScene::modules.cbegin(), ProducerScene::modules.cend(), VALUES::ROTATION)));
+
+        // X, Y then Z applied about the fixed axes
+        const auto toQuaternion = [&](const ProducerScene::axisValues_t &values, auto &quaternion) {
+            const auto cx = std::cos(values[axis_t::X] * RotationToRadians / 2);
+            const auto sx = std::sin(values[axis_t::X] * RotationToRadians / 2);
+            const auto cy = std::cos(values[axis_t::Y] * RotationToRadians / 2);
+            const auto sy = std::sin(values[axis_t::Y] * RotationToRadians / 2);
+            const auto cz = std::cos(values[axis_t::Z] * RotationToRadians / 2);
+            const auto sz = std::sin(values[axis_t::Z] * RotationToRadians / 2);
+            quaternion.w.push_back(cx * cy * cz + sx * sy * sz);
+            quaternion.x.push_back(sx * cy * cz - cx * sy * sz);
+            quaternion.y.push_back(cx * sy * cz + sx * cy * sz);
+            quaternion.z.push_back(cx * cy * sz - sx * sy * cz);
+        };
+
+        for (auto *quaternion : {&rotationFrom, &rotationTo})
+            for (auto *component : {&quaternion->w, &quaternion->x, &quaternion->y, &quaternion->z})
+                component->reserve(pairs.size());
+        for (auto *angles : {&rotationFromAngles, &rotationToAngles})
+            for (auto *axis : {&angles->x, &angles->y, &angles->z})
+                axis->reserve(pairs.size());
+        rotationAngle.reserve(pairs.size());
+
+        for (const auto &[fromPoint, toPoint] : pairs)
+        {
+            const auto &fromValues = fromPoint->values[rotationModule];
+            const auto &toValues = toPoint->values[rotationModule];
+            rotationFromAngles.x.push_back(static_cast<double>(fromValues[axis_t::X]));
+            rotationFromAngles.y.push_back(static_cast<double>(fromValues[axis_t::Y]));
+            rotationFromAngles.z.push_back(static_cast<double>(fromValues[axis_t::Z]));
+            rotationToAngles.x.push_back(static_cast<double>(toValues[axis_t::X]));
+            rotationToAngles.y.push_back(static_cast<double>(toValues[axis_t::Y]));
+            rotationToAngles.z.push_back(static_cast<double>(toValues[axis_t::Z]));
+
+            toQuaternion(fromPoint->values[rotationModule], rotationFrom);
+            toQuaternion(toPoint->values[rotationModule], rotationTo);
+
+            // Take the shortest path
+            const auto i = rotationAngle.size();
+            auto dot = rotationFrom.w[i] * rotationTo.w[i] + rotationFrom.x[i] * rotationTo.x[i]
+                    + rotationFrom.y[i] * rotationTo.y[i] + rotationFrom.z[i] * rotationTo.z[i];
+            if (dot < 0)
+            {
+                rotationTo.w[i] = -rotationTo.w[i];
+                rotationTo.x[i] = -rotationTo.x[i];
+                rotationTo.y[i] = -rotationTo.y[i];
+                rotationTo.z[i] = -rotationTo.z[i];
+                dot = -dot;
+            }
+            rotationAngle.push_back(std::acos(std::min(dot, 1.0)));
+        }
+    }
+}
+
+SceneCrossfade::~SceneCrossfade()
+{
+    stop();
+}
+
+void SceneCrossfade::start()
+{
+    stop();
+    stopRequested = false;
+    thread = QThread::create([this]() { run(); });
+    thread->start();
+}
+
+void SceneCrossfade::stop()
+{
+    if (!thread) return;
+    stopRequested = true;
+    thread->wait();
+    delete thread;
+    thread = nullptr;
+}
+
+bool SceneCrossfade::isRunning() const
+{
+    return thread && thread->isRunning();
+}
+
+void SceneCrossfade::run()
+{
+    using clock = std::chrono::steady_clock;
+    const auto startTime = clock::now();
+    auto nextTick = startTime;
+    while (!stopRequested)
+    {
+        const auto elapsed = std::chrono::duration<double>(clock::now() - startTime);
+        const auto progress = duration.count()
+                ? std::min(1.0, elapsed / std::chrono::duration<double>(duration))
+                : 1.0;
+
+        auto frame = std::make_shared<frame_t>();
+        computeFrame(progress, *frame);
+        {
+            QMutexLocker locker(&latestFrameMutex);
+            latestFrame = frame;
+        }
+
+        // Frames the GUI thread hasn't caught up with are simply replaced
+        if (!applyPending.exchange(true))
+            QMetaObject::invokeMethod(this, [this]() { applyLatestFrame(); }, Qt::QueuedConnection);
+
+        if (progress >= 1.0)
+            break;
+
+        nextTick += tickInterval;
+        std::this_thread::sleep_until(nextTick);
+    }
+}
+
+void SceneCrossfade::computeFrame(double progress, frame_t &frame) const
+{
+    frame.progress = progress;
+    const auto t = smoothStep(progress);
+    const auto count = addresses.size();
+    frame.values.resize(channels.size() + (rotationAngle.empty() ? 0 : 3));
+
+    // Plain loops over contiguous arrays, left for the compiler to vectorise
+    for (size_t channel = 0; channel < channels.size(); ++channel)
+    {
+        const auto *from = channels[channel].from.data();
+        const auto *to = channels[channel].to.data();
+        auto &out = frame.values[channel];
+        out.resize(count);
+        auto *values = out.data();
+        for (size_t i = 0; i < count; ++i)
+            values[i] = from[i] + (to[i] - from[i]) * t;
+    }
+
+    if (rotationAngle.empty()) return;
+
+    auto &outX = frame.values[channels.size() + 0];
+    auto &outY = frame.values[channels.size() + 1];
+    auto &outZ = frame.values[channels.size() + 2];
+    outX.resize(count);
+    outY.resize(count);
+    outZ.resize(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        const auto fromX = rotationFromAngles.x[i];
+        const auto fromY = rotationFromAngles.y[i];
+        const auto fromZ = rotationFromAngles.z[i];
+        const auto toX = rotationToAngles.x[i];
+        const auto toY = rotationToAngles.y[i];
+        const auto toZ = rotationToAngles.z[i];
+
+        // Unchanged rotations, and the last frame, are sent exactly as stored
+        if (t >= 1.0 || (fromX == toX && fromY == toY && fromZ == toZ))
+        {
+            outX[i] = toX;
+            outY[i] = toY;
+            outZ[i] = toZ;
+            continue;
+        }
+
+        // Slerp, falling back to lerp for near identical rotations
+        const auto angle = rotationAngle[i];
+        double a = 1.0 - t;
+        double b = t;
+        if (angle > 1e-6)
+        {
+            const auto inverseSin = 1.0 / std::sin(angle);
+            a = std::sin((1.0 - t) * angle) * inverseSin;
+            b = std::sin(t * angle) * inverseSin;
+        }
+        auto w = a * rotationFrom.w[i] + b * rotationTo.w[i];
+        auto x = a * rotationFrom.x[i] + b * rotationTo.x[i];
+        auto y = a * rotationFrom.y[i] + b * rotationTo.y[i];
+        auto z = a * rotationFrom.z[i] + b * rotationTo.z[i];
+        const auto inverseNorm = 1.0 / std::sqrt(w * w + x * x + y * y + z * z);
+        w *= inverseNorm; x *= inverseNorm; y *= inverseNorm; z *= inverseNorm;
+
+        // Back to X, Y, Z, asin only covers Y within a quarter turn either way
+        const auto eulerX = std::atan2(2 * (w * x + y * z), 1 - 2 * (x * x + y * y)) * RadiansToRotation;
+        const auto eulerY = std::asin(std::clamp(2 * (w * y - z * x), -1.0, 1.0)) * RadiansToRotation;
+        const auto eulerZ = std::atan2(2 * (w * z + x * y), 1 - 2 * (y * y + z * z)) * RadiansToRotation;
+
+        // Of the two equivalent sets of angles, take the one nearest the per axis interpolation
+        const auto nearX = fromX + wrapRotation(toX - fromX) * t;
+        const auto nearY = fromY + wrapRotation(toY - fromY) * t;
+        const auto nearZ = fromZ + wrapRotation(toZ - fromZ) * t;
+        const auto distance = [&](double candidateX, double candidateY, double candidateZ) {
+            const auto dx = wrapRotation(candidateX - nearX);
+            const auto dy = wrapRotation(candidateY - nearY);
+            const auto dz = wrapRotation(candidateZ - nearZ);
+            return dx * dx + dy * dy + dz * dz;
+        };
+        const auto flipped = distance(eulerX + HalfTurn, HalfTurn - eulerY, eulerZ + HalfTurn)
+                < distance(eulerX, eulerY, eulerZ);
+
+        // Kept next to the interpolation, the transaction wraps these into range
+        outX[i] = nearX + wrapRotation((flipped ? eulerX + HalfTurn : eulerX) - nearX);
+        outY[i] = nearY + wrapRotation((flipped ? HalfTurn - eulerY : eulerY) - nearY);
+        outZ[i] = nearZ + wrapRotation((flipped ? eulerZ + HalfTurn : eulerZ) - nearZ);
+    }
+}
+
+void SceneCrossfade::applyLatestFrame()
+{
+    applyPending = false;
+    std::shared_ptr<const frame_t> frame;
+    {
+        QMutexLocker locker(&latestFrameMutex);
+        frame = latestFrame;
+    }
+    if (!frame) return;
+
+    ProducerTransaction transaction(otpProducer);
+    for (size_t channel = 0; channel < channels.size(); ++channel)
+    {
+        const auto &values = frame->values[channel];
+        for (size_t i = 0; i < addresses.size(); ++i)
+            transaction.setValue(addresses[i], channels[channel].axis, channels[channel].moduleValue,
+                                 std::llround(values[i]));
+    }
+    if (!rotationAngle.empty())
+    {
+        for (auto axis = axis_t::first; axis < axis_t::count; ++axis)
+        {
+            const auto &values = frame->values[channels.size() + axis];
+            for (size_t i = 0; i < addresses.size(); ++i)
+                transaction.setValue(addresses[i], axis, VALUES::ROTATION, std::llround(values[i]));
+        }
+    }
+    transaction.commit();
+
+    emit progress(frame->progress);
+    if (frame->progress >= 1.0)
+        emit finished();
+}
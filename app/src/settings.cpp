@@ -17,6 +17,7 @@
     along with this program.  If not, see <https://www.gnu.org/licenses/>.
 */
 #include "settings.h"
+#include <QMutexLocker>
 #include <QSettings>
 
 
@@ -26,16 +27,31 @@ static const QString S_GENERAL_SYSTEMREQUESTINTERVAL= QStringLiteral("SYSTEMREQU
 static const QString S_GENERAL_SOURCERESOLUTION = QStringLiteral("RESOLUTION");
 static const QString S_GENERAL_TRANSFORM_RATE = QStringLiteral("TRANSFORMRATE");
 static const QString S_GENERAL_REMOVE_EXPIRED_COMPONENTS = QStringLiteral("REMOVEEXPIREDCOMPONENTS");
+static const QString S_GENERAL_PUBLISH_SHARED_MEMORY = QStringLiteral("PUBLISHSHAREDMEMORY");
+static const QString S_GENERAL_SNAPSHOT_SERVER_PORT = QStringLiteral("SNAPSHOTSERVERPORT");
+static const QString S_GENERAL_DEAD_RECKONING = QStringLiteral("DEADRECKONING");
+static const QString S_GENERAL_DERIVE_MOTION = QStringLiteral("DERIVEMOTION");
 
 static const QString S_NETWORK = QStringLiteral("NETWORK");
 static const QString S_NETWORK_HARDWAREADDRESS = QStringLiteral("HARDWAREADDRESS");
 static const QString S_NETWORK_NAME = QStringLiteral("NAME");
 static const QString S_NETWORK_TRANSPORT = QStringLiteral("TRANSPORT");
 
+static const QString S_MOTIONFILTER = QStringLiteral("MOTIONFILTER");
+static const QString S_MOTIONFILTER_MODE = QStringLiteral("MODE");
+static const QString S_MOTIONFILTER_MINCUTOFF = QStringLiteral("MINCUTOFF");
+static const QString S_MOTIONFILTER_BETA = QStringLiteral("BETA");
+static const QString S_MOTIONFILTER_DERIVATIVECUTOFF = QStringLiteral("DERIVATIVECUTOFF");
+static const QString S_MOTIONFILTER_MEASUREMENTNOISE = QStringLiteral("MEASUREMENTNOISE");
+static const QString S_MOTIONFILTER_PROCESSNOISE = QStringLiteral("PROCESSNOISE");
+
 static const QString S_COMPONENT_NAME = QStringLiteral("NAME");
 static const QString S_COMPONENT_CID = QStringLiteral("CID");
 
-Settings::Settings() : QObject() {};
+Settings::Settings() : QObject()
+{
+    sync();
+};
 
 Settings& Settings::getInstance()
 {
@@ -43,6 +59,62 @@ Settings& Settings::getInstance()
     return instance;
 }
 
+void Settings::sync()
+{
+    QSettings settings;
+    settings.sync();
+
+    settings.beginGroup(S_NETWORK);
+    {
+        QMutexLocker locker(&cacheMutex);
+        networkInterfaceName = settings.value(S_NETWORK_NAME).toString();
+        componentSettings.clear(); // Reloaded on demand
+    }
+    networkTransport = settings.value(S_NETWORK_TRANSPORT, QAbstractSocket::AnyIPProtocol).toInt();
+    settings.endGroup();
+
+    settings.beginGroup(S_GENERAL);
+    systemRequestInterval = settings.value(
+                S_GENERAL_SYSTEMREQUESTINTERVAL,
+                static_cast<qlonglong>(std::chrono::seconds(10).count())).toLongLong();
+    transformMessageRate = settings.value(
+                S_GENERAL_TRANSFORM_RATE,
+                static_cast<qlonglong>(OTP::OTP_TRANSFORM_TIMING_MAX.count())).toLongLong();
+    removeExpiredComponents = settings.value(S_GENERAL_REMOVE_EXPIRED_COMPONENTS, true).toBool();
+    publishSharedMemory = settings.value(S_GENERAL_PUBLISH_SHARED_MEMORY, false).toBool();
+    snapshotServerPort = static_cast<quint16>(settings.value(S_GENERAL_SNAPSHOT_SERVER_PORT, 0).toUInt());
+    deadReckoning = settings.value(S_GENERAL_DEAD_RECKONING, false).toBool();
+    deriveMotion = settings.value(S_GENERAL_DERIVE_MOTION, false).toBool();
+    settings.endGroup();
+
+    // One child group per filtered group, as <system>_<group>
+    QMap<QPair<quint32, quint32>, groupFilter_t> filters;
+    settings.beginGroup(S_MOTIONFILTER);
+    for (const auto &key : settings.childGroups())
+    {
+        const auto address = key.split('_');
+        if (address.count() != 2) continue;
+        groupFilter_t filter;
+        filter.system = static_cast<OTP::system_t>(address.at(0).toUInt());
+        filter.group = static_cast<OTP::group_t>(address.at(1).toUInt());
+        settings.beginGroup(key);
+        filter.mode = static_cast<MotionFilter::mode_t>(settings.value(S_MOTIONFILTER_MODE, filter.mode).toInt());
+        auto &parameters = filter.parameters;
+        parameters.minCutoff = settings.value(S_MOTIONFILTER_MINCUTOFF, parameters.minCutoff).toDouble();
+        parameters.beta = settings.value(S_MOTIONFILTER_BETA, parameters.beta).toDouble();
+        parameters.derivativeCutoff = settings.value(S_MOTIONFILTER_DERIVATIVECUTOFF, parameters.derivativeCutoff).toDouble();
+        parameters.measurementNoise = settings.value(S_MOTIONFILTER_MEASUREMENTNOISE, parameters.measurementNoise).toDouble();
+        parameters.processNoise = settings.value(S_MOTIONFILTER_PROCESSNOISE, parameters.processNoise).toDouble();
+        settings.endGroup();
+        filters.insert({static_cast<quint32>(filter.system), static_cast<quint32>(filter.group)}, filter);
+    }
+    settings.endGroup();
+    {
+        QMutexLocker locker(&cacheMutex);
+        groupFilters = filters;
+    }
+}
+
 void Settings::setNetworkInterface(QNetworkInterface interface)
 {
     QSettings settings;
@@ -50,14 +122,19 @@ void Settings::setNetworkInterface(QNetworkInterface interface)
     settings.setValue(S_NETWORK_HARDWAREADDRESS, interface.hardwareAddress());
     settings.setValue(S_NETWORK_NAME, interface.name());
     settings.sync();
+    {
+        QMutexLocker locker(&cacheMutex);
+        networkInterfaceName = interface.name();
+    }
 
     emit newNetworkInterface(interface);
 }
 QNetworkInterface Settings::getNetworkInterface()
 {
-    QSettings settings;
-    settings.beginGroup(S_NETWORK);
-    return QNetworkInterface::interfaceFromName(settings.value(S_NETWORK_NAME).toString());
+    QMutexLocker locker(&cacheMutex);
+    const auto name = networkInterfaceName;
+    locker.unlock();
+    return QNetworkInterface::interfaceFromName(name);
 }
 
 void Settings::setNetworkTransport(QAbstractSocket::NetworkLayerProtocol transport)
@@ -66,14 +143,13 @@ void Settings::setNetworkTransport(QAbstractSocket::NetworkLayerProtocol transpo
     settings.beginGroup(S_NETWORK);
     settings.setValue(S_NETWORK_TRANSPORT, static_cast<int>(transport));
     settings.sync();
+    networkTransport = static_cast<int>(transport);
 
     emit newNetworkTransport(transport);
 }
 QAbstractSocket::NetworkLayerProtocol Settings::getNetworkTransport()
 {
-    QSettings settings;
-    settings.beginGroup(S_NETWORK);
-    return static_cast<QAbstractSocket::NetworkLayerProtocol>(settings.value(S_NETWORK_TRANSPORT, QAbstractSocket::AnyIPProtocol).toInt());
+    return static_cast<QAbstractSocket::NetworkLayerProtocol>(networkTransport.load());
 }
 
 void Settings::setComponentSettings(QString settingsGroup, componentDetails_t details)
@@ -83,14 +159,23 @@ void Settings::setComponentSettings(QString settingsGroup, componentDetails_t de
     settings.setValue(S_COMPONENT_NAME, details.Name);
     settings.setValue(S_COMPONENT_CID, details.CID.toByteArray());
     settings.sync();
+
+    QMutexLocker locker(&cacheMutex);
+    componentSettings.insert(settingsGroup, details);
 }
 Settings::componentDetails_t Settings::getComponentSettings(QString settingsGroup)
 {
+    QMutexLocker locker(&cacheMutex);
+    const auto cached = componentSettings.constFind(settingsGroup);
+    if (cached != componentSettings.constEnd())
+        return cached.value();
+
     componentDetails_t details;
     QSettings settings;
     settings.beginGroup(settingsGroup);
     details.Name = settings.value(S_COMPONENT_NAME, details.Name).toString();
     details.CID = OTP::cid_t(settings.value(S_COMPONENT_CID, details.CID.toByteArray()).toByteArray());
+    componentSettings.insert(settingsGroup, details);
     return details;
 }
 
@@ -100,15 +185,13 @@ void Settings::setSystemRequestInterval(std::chrono::seconds interval)
     settings.beginGroup(S_GENERAL);
     settings.setValue(S_GENERAL_SYSTEMREQUESTINTERVAL, static_cast<qlonglong>(interval.count()));
     settings.sync();
+    systemRequestInterval = interval.count();
 
     emit newSystemRequestInterval(interval);
 }
 std::chrono::seconds Settings::getSystemRequestInterval()
 {
-    QSettings settings;
-    settings.beginGroup(S_GENERAL);
-    return std::chrono::seconds(
-            settings.value(S_GENERAL_SYSTEMREQUESTINTERVAL, static_cast<qlonglong>(std::chrono::seconds(10).count())).toLongLong());
+    return std::chrono::seconds(systemRequestInterval.load());
 }
 
 void Settings::setTransformMessageRate(std::chrono::milliseconds interval)
@@ -117,16 +200,14 @@ void Settings::setTransformMessageRate(std::chrono::milliseconds interval)
     settings.beginGroup(S_GENERAL);
     settings.setValue(S_GENERAL_TRANSFORM_RATE, static_cast<qlonglong>(interval.count()));
     settings.sync();
+    transformMessageRate = interval.count();
 
     emit newTransformMessageRate(interval);
 }
 
 std::chrono::milliseconds Settings::getTransformMessageRate()
 {
-    QSettings settings;
-    settings.beginGroup(S_GENERAL);
-    return std::chrono::milliseconds(
-                settings.value(S_GENERAL_TRANSFORM_RATE, static_cast<qlonglong>(OTP::OTP_TRANSFORM_TIMING_MAX.count())).toLongLong());
+    return std::chrono::milliseconds(transformMessageRate.load());
 }
 
 void Settings::setRemoveExpiredComponents(bool value)
@@ -135,11 +216,126 @@ void Settings::setRemoveExpiredComponents(bool value)
     settings.beginGroup(S_GENERAL);
     settings.setValue(S_GENERAL_REMOVE_EXPIRED_COMPONENTS, value);
     settings.sync();
+    removeExpiredComponents = value;
 }
 
 bool Settings::getRemoveExpiredComponents()
+{
+    return removeExpiredComponents.load();
+}
+
+void Settings::setPublishSharedMemory(bool value)
+{
+    QSettings settings;
+    settings.beginGroup(S_GENERAL);
+    settings.setValue(S_GENERAL_PUBLISH_SHARED_MEMORY, value);
+    settings.sync();
+    if (publishSharedMemory.exchange(value) == value) return;
+
+    emit newPublishSharedMemory(value);
+}
+
+bool Settings::getPublishSharedMemory()
+{
+    return publishSharedMemory.load();
+}
+
+void Settings::setSnapshotServerPort(quint16 port)
+{
+    QSettings settings;
+    settings.beginGroup(S_GENERAL);
+    settings.setValue(S_GENERAL_SNAPSHOT_SERVER_PORT, port);
+    settings.sync();
+    if (snapshotServerPort.exchange(port) == port) return;
+
+    emit newSnapshotServerPort(port);
+}
+
+quint16 Settings::getSnapshotServerPort()
+{
+    return snapshotServerPort.load();
+}
+
+void Settings::setDeadReckoning(bool value)
+{
+    QSettings settings;
+    settings.beginGroup(S_GENERAL);
+    settings.setValue(S_GENERAL_DEAD_RECKONING, value);
+    settings.sync();
+    if (deadReckoning.exchange(value) == value) return;
+
+    emit newDeadReckoning(value);
+}
+
+bool Settings::getDeadReckoning()
+{
+    return deadReckoning.load();
+}
+
+void Settings::setDeriveMotion(bool value)
 {
     QSettings settings;
     settings.beginGroup(S_GENERAL);
-    return settings.value(S_GENERAL_REMOVE_EXPIRED_COMPONENTS, true).toBool();
+    settings.setValue(S_GENERAL_DERIVE_MOTION, value);
+    settings.sync();
+    if (deriveMotion.exchange(value) == value) return;
+
+    emit newDeriveMotion(value);
+}
+
+bool Settings::getDeriveMotion()
+{
+    return deriveMotion.load();
+}
+
+void Settings::setGroupFilter(const groupFilter_t &filter)
+{
+    QSettings settings;
+    settings.beginGroup(S_MOTIONFILTER);
+    settings.beginGroup(QString("%1_%2").arg(filter.system).arg(filter.group));
+    settings.setValue(S_MOTIONFILTER_MODE, static_cast<int>(filter.mode));
+    settings.setValue(S_MOTIONFILTER_MINCUTOFF, filter.parameters.minCutoff);
+    settings.setValue(S_MOTIONFILTER_BETA, filter.parameters.beta);
+    settings.setValue(S_MOTIONFILTER_DERIVATIVECUTOFF, filter.parameters.derivativeCutoff);
+    settings.setValue(S_MOTIONFILTER_MEASUREMENTNOISE, filter.parameters.measurementNoise);
+    settings.setValue(S_MOTIONFILTER_PROCESSNOISE, filter.parameters.processNoise);
+    settings.endGroup();
+    settings.endGroup();
+    settings.sync();
+    {
+        QMutexLocker locker(&cacheMutex);
+        groupFilters.insert({static_cast<quint32>(filter.system), static_cast<quint32>(filter.group)}, filter);
+    }
+
+    emit newGroupFilter(filter.system, filter.group);
+}
+
+void Settings::clearGroupFilter(OTP::system_t system, OTP::group_t group)
+{
+    QSettings settings;
+    settings.beginGroup(S_MOTIONFILTER);
+    settings.remove(QString("%1_%2").arg(system).arg(group));
+    settings.endGroup();
+    settings.sync();
+    {
+        QMutexLocker locker(&cacheMutex);
+        if (!groupFilters.remove({static_cast<quint32>(system), static_cast<quint32>(group)})) return;
+    }
+
+    emit newGroupFilter(system, group);
+}
+
+bool Settings::getGroupFilter(OTP::system_t system, OTP::group_t group, groupFilter_t &filter)
+{
+    QMutexLocker locker(&cacheMutex);
+    const auto cached = groupFilters.constFind({static_cast<quint32>(system), static_cast<quint32>(group)});
+    if (cached == groupFilters.constEnd()) return false;
+    filter = cached.value();
+    return true;
+}
+
+QList<Settings::groupFilter_t> Settings::getGroupFilters()
+{
+    QMutexLocker locker(&cacheMutex);
+    return groupFilters.values();
 }
@@ -20,8 +20,13 @@
 #define SETTINGS_H
 
 #include <QApplication>
+#include <QHash>
+#include <QMap>
+#include <QMutex>
 #include <QNetworkInterface>
+#include <atomic>
 #include "OTPLib.hpp"
+#include "motionfilter.h"
 
 class Settings final : public QObject
 {
@@ -30,6 +35,9 @@ class Settings final : public QObject
 public:
     static Settings& getInstance();
 
+    // Reload every setting from the backing store
+    void sync();
+
     void setNetworkInterface(QNetworkInterface interface);
     QNetworkInterface getNetworkInterface();
 
@@ -61,16 +69,60 @@ public:
     void setRemoveExpiredComponents(bool value);
     bool getRemoveExpiredComponents();
 
+    void setPublishSharedMemory(bool value);
+    bool getPublishSharedMemory();
+
+    void setSnapshotServerPort(quint16 port);
+    quint16 getSnapshotServerPort();
+
+    void setDeadReckoning(bool value);
+    bool getDeadReckoning();
+
+    void setDeriveMotion(bool value);
+    bool getDeriveMotion();
+
+    typedef struct groupFilter_s
+    {
+        OTP::system_t system;
+        OTP::group_t group;
+        MotionFilter::mode_t mode = MotionFilter::OneEuro;
+        MotionFilter::parameters_t parameters;
+    } groupFilter_t;
+    void setGroupFilter(const groupFilter_t &filter);
+    void clearGroupFilter(OTP::system_t system, OTP::group_t group);
+    bool getGroupFilter(OTP::system_t system, OTP::group_t group, groupFilter_t &filter);
+    QList<groupFilter_t> getGroupFilters();
+
 signals:
     void newNetworkInterface(QNetworkInterface);
     void newNetworkTransport(QAbstractSocket::NetworkLayerProtocol);
     void newSystemRequestInterval(std::chrono::seconds);
     void newTransformMessageRate(std::chrono::milliseconds);
+    void newPublishSharedMemory(bool);
+    void newSnapshotServerPort(quint16);
+    void newDeadReckoning(bool);
+    void newDeriveMotion(bool);
+    void newGroupFilter(OTP::system_t, OTP::group_t); // Set or cleared
 
 private:
     Settings();
     ~Settings() = default;
 
+    // Settings are read once and then served from memory,
+    // setters write through to the backing store
+    mutable QMutex cacheMutex;
+    QString networkInterfaceName;
+    QHash<QString, componentDetails_t> componentSettings;
+    std::atomic<int> networkTransport;
+    std::atomic<qint64> systemRequestInterval;
+    std::atomic<qint64> transformMessageRate;
+    std::atomic<bool> removeExpiredComponents;
+    std::atomic<bool> publishSharedMemory;
+    std::atomic<quint16> snapshotServerPort;
+    std::atomic<bool> deadReckoning;
+    std::atomic<bool> deriveMotion;
+    QMap<QPair<quint32, quint32>, groupFilter_t> groupFilters;
+
 
     Settings(const Settings&) = delete;
     Settings& operator=(const Settings&) = delete;
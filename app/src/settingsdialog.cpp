@@ -49,6 +49,27 @@ SettingsDialog::SettingsDialog(QWidget *parent) :
     ui->cbRemoveExpiredComponents->setCheckState(
                 Settings::getInstance().getRemoveExpiredComponents()
                 ? Qt::CheckState::Checked : Qt::CheckState::Unchecked);
+
+    // Shared memory publishing
+    ui->cbPublishSharedMemory->setCheckState(
+                Settings::getInstance().getPublishSharedMemory()
+                ? Qt::CheckState::Checked : Qt::CheckState::Unchecked);
+#ifndef Q_OS_UNIX
+    ui->cbPublishSharedMemory->setVisible(false);
+#endif
+
+    // Dead reckoning
+    ui->cbDeadReckoning->setCheckState(
+                Settings::getInstance().getDeadReckoning()
+                ? Qt::CheckState::Checked : Qt::CheckState::Unchecked);
+
+    // Derived motion
+    ui->cbDeriveMotion->setCheckState(
+                Settings::getInstance().getDeriveMotion()
+                ? Qt::CheckState::Checked : Qt::CheckState::Unchecked);
+
+    // Snapshot server
+    ui->sbSnapshotServerPort->setValue(Settings::getInstance().getSnapshotServerPort());
 }
 
 SettingsDialog::~SettingsDialog()
@@ -74,6 +95,18 @@ void SettingsDialog::on_buttonBox_accepted()
     instance.setRemoveExpiredComponents(
                 ui->cbRemoveExpiredComponents->checkState() == Qt::CheckState::Checked);
 
+    instance.setPublishSharedMemory(
+                ui->cbPublishSharedMemory->checkState() == Qt::CheckState::Checked);
+
+    instance.setDeadReckoning(
+                ui->cbDeadReckoning->checkState() == Qt::CheckState::Checked);
+
+    instance.setDeriveMotion(
+                ui->cbDeriveMotion->checkState() == Qt::CheckState::Checked);
+
+    instance.setSnapshotServerPort(
+                static_cast<quint16>(ui->sbSnapshotServerPort->value()));
+
     this->close();
 }
 
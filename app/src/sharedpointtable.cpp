@@ -0,0 +1,252 @@
+/*
+    OTPView
+    A QT Frontend for E1.59  (Entertainment  Technology  Object  Transform  Protocol  (OTP))
+    Copyright (C) 2026  Marcus Birkin
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "sharedpointtable.h"
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QUuid>
+#include <QtDebug>
+#include <algorithm>
+#include <cstring>
+#ifdef Q_OS_UNIX
+#include <cerrno>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace OTP;
+
+namespace {
+    // Big endian, as on the wire, without the allocation of QUuid::toRfc4122()
+    void storeCID(quint8 (&target)[16], const QUuid &cid)
+    {
+        for (int byte = 0; byte < 4; ++byte)
+            target[byte] = static_cast<quint8>(cid.data1 >> (24 - byte * 8));
+        target[4] = static_cast<quint8>(cid.data2 >> 8);
+        target[5] = static_cast<quint8>(cid.data2);
+        target[6] = static_cast<quint8>(cid.data3 >> 8);
+        target[7] = static_cast<quint8>(cid.data3);
+        std::copy(std::begin(cid.data4), std::end(cid.data4), target + 8);
+    }
+
+    template <typename T>
+    void storeValue(SharedPointTable::value_t &target, const T &source)
+    {
+        target.value = static_cast<qint64>(source.value);
+        target.timestamp = static_cast<quint64>(source.timestamp);
+        storeCID(target.sourceCID, source.sourceCID);
+        target.priority = static_cast<quint8>(source.priority);
+    }
+}
+
+SharedPointTable::SharedPointTable(const QString &name, quint32 slotCount) :
+    segmentName(name)
+{
+#ifdef Q_OS_UNIX
+    if (!slotCount || (slotCount & (slotCount - 1)))
+    {
+        error = QObject::tr("Slot count must be a power of two");
+        return;
+    }
+
+    // Never shared with another writer, another instance may be publishing under the same name
+    const auto path = segmentName.toLocal8Bit();
+    int fd = shm_open(path.constData(), O_RDWR | O_CREAT | O_EXCL, 0644);
+    if (fd < 0 && errno == EEXIST)
+    {
+        const auto writer = writerOf(path);
+        if (writer && (kill(static_cast<pid_t>(writer), 0) == 0 || errno == EPERM))
+        {
+            error = QObject::tr("Shared memory %1 is in use by process %2").arg(segmentName).arg(writer);
+            return;
+        }
+
+        // Left behind by a writer that has exited, replaced rather than reused as it may have another layout
+        shm_unlink(path.constData());
+        fd = shm_open(path.constData(), O_RDWR | O_CREAT | O_EXCL, 0644);
+    }
+    if (fd < 0)
+    {
+        error = QObject::tr("Unable to create shared memory %1: %2").arg(segmentName, strerror(errno));
+        return;
+    }
+
+    size = sizeof(header_t) + sizeof(record_t) * slotCount;
+    void *mapping = MAP_FAILED;
+    if (ftruncate(fd, static_cast<off_t>(size)) == 0)
+        mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED)
+    {
+        error = QObject::tr("Unable to map shared memory %1: %2").arg(segmentName, strerror(errno));
+        close(fd);
+        shm_unlink(path.constData());
+        return;
+    }
+    close(fd); // The mapping keeps the segment
+
+    // Freshly truncated, so already zero, only the header needs filling in.
+    // The magic goes last, readers that find it can trust the rest
+    header = static_cast<header_t*>(mapping);
+    records = reinterpret_cast<record_t*>(static_cast<char*>(mapping) + sizeof(header_t));
+    header->version = Version;
+    header->headerSize = sizeof(header_t);
+    header->recordSize = sizeof(record_t);
+    header->slotCount = slotCount;
+    header->writerPid = static_cast<quint32>(QCoreApplication::applicationPid());
+    header->created = QDateTime::currentMSecsSinceEpoch();
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(header->magic, Magic, sizeof(Magic));
+#else
+    Q_UNUSED(slotCount)
+    error = QObject::tr("Shared memory publishing is not supported on this platform");
+#endif
+}
+
+SharedPointTable::~SharedPointTable()
+{
+#ifdef Q_OS_UNIX
+    if (!header) return;
+    munmap(header, size);
+
+    // Only while it's still ours, a later writer may have replaced it
+    const auto path = segmentName.toLocal8Bit();
+    if (writerOf(path) == static_cast<quint32>(QCoreApplication::applicationPid()))
+        shm_unlink(path.constData());
+#endif
+}
+
+quint32 SharedPointTable::writerOf(const QByteArray &path)
+{
+    quint32 ret = 0;
+#ifdef Q_OS_UNIX
+    const int fd = shm_open(path.constData(), O_RDONLY, 0);
+    if (fd < 0) return ret;
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(header_t)))
+    {
+        close(fd);
+        return ret;
+    }
+    const auto mapping = mmap(nullptr, sizeof(header_t), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) return ret;
+
+    // The magic is written last, without it the rest isn't there yet
+    const auto existing = static_cast<const header_t*>(mapping);
+    if (std::memcmp(existing->magic, Magic, sizeof(Magic)) == 0)
+    {
+        std::atomic_thread_fence(std::memory_order_acquire);
+        ret = existing->writerPid;
+    }
+    munmap(mapping, sizeof(header_t));
+#else
+    Q_UNUSED(path)
+#endif
+    return ret;
+}
+
+void SharedPointTable::update(Consumer &consumer, address_t address)
+{
+    auto record = find(address, true);
+    if (!record) return;
+
+    const auto name = QString(consumer.getPointName(address)).toUtf8();
+    const auto frame = consumer.getReferenceFrame(address).value;
+
+    const auto sequence = record->sequence.load(std::memory_order_relaxed);
+    record->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    record->flags = Used;
+    if (consumer.isPointExpired(address.system, address.group, address.point))
+        record->flags |= Expired;
+    record->system = static_cast<quint32>(address.system);
+    record->group = static_cast<quint32>(address.group);
+    record->point = static_cast<quint32>(address.point);
+    record->referenceSystem = static_cast<quint32>(frame.system);
+    record->referenceGroup = static_cast<quint32>(frame.group);
+    record->referencePoint = static_cast<quint32>(frame.point);
+    record->lastSeen = consumer.getPointLastSeen(address).toMSecsSinceEpoch();
+    ++record->updates;
+    std::memset(record->name, 0, NameSize);
+    std::memcpy(record->name, name.constData(), std::min<std::size_t>(static_cast<std::size_t>(name.size()), NameSize));
+
+    for (auto axis = OTP::axis_t::first; axis < OTP::axis_t::count; ++axis)
+    {
+        auto &values = record->axes[axis];
+        const auto position = consumer.getPosition(address, axis);
+        storeValue(values.position, position);
+        values.positionScale = position.scale == MODULES::STANDARD::PositionModule_t::scale_e::mm;
+        storeValue(values.positionVelocity, consumer.getPositionVelocity(address, axis));
+        storeValue(values.positionAcceleration, consumer.getPositionAcceleration(address, axis));
+        storeValue(values.rotation, consumer.getRotation(address, axis));
+        storeValue(values.rotationVelocity, consumer.getRotationVelocity(address, axis));
+        storeValue(values.rotationAcceleration, consumer.getRotationAcceleration(address, axis));
+        storeValue(values.scale, consumer.getScale(address, axis));
+    }
+
+    record->sequence.store(sequence + 2, std::memory_order_release);
+}
+
+void SharedPointTable::remove(address_t address)
+{
+    auto record = find(address, false);
+    if (!record) return;
+
+    // Values stay, only flagged, a reader part way through a copy still gets a whole record
+    const auto sequence = record->sequence.load(std::memory_order_relaxed);
+    record->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    record->flags |= Removed;
+    record->sequence.store(sequence + 2, std::memory_order_release);
+}
+
+SharedPointTable::record_t *SharedPointTable::find(address_t address, bool claim)
+{
+    if (!header) return nullptr;
+
+    const auto system = static_cast<quint32>(address.system);
+    const auto group = static_cast<quint32>(address.group);
+    const auto point = static_cast<quint32>(address.point);
+    const auto slotCount = header->slotCount;
+
+    // Only this thread writes, so its own reads need no seqlock
+    auto index = slotIndex(system, group, point, slotCount);
+    for (quint32 probe = 0; probe < slotCount; ++probe, index = (index + 1) & (slotCount - 1))
+    {
+        auto &record = records[index];
+        if (!(record.flags & Used))
+        {
+            if (!claim) return nullptr;
+            header->usedCount.fetch_add(1, std::memory_order_relaxed);
+            return &record; // Claimed by the caller's write
+        }
+        if (record.system == system && record.group == group && record.point == point)
+            return &record;
+    }
+
+    if (claim && !fullReported)
+    {
+        qWarning() << "Shared memory" << segmentName << "is full, further points are not published";
+        fullReported = true;
+    }
+    return nullptr;
+}
@@ -0,0 +1,166 @@
+/*
+    OTPView
+    A QT Frontend for E1.59  (Entertainment  Technology  Object  Transform  Protocol  (OTP))
+    Copyright (C) 2026  Marcus Birkin
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#ifndef SHAREDPOINTTABLE_H
+#define SHAREDPOINTTABLE_H
+
+#include <QString>
+#include <atomic>
+#include <cstddef>
+#include "OTPLib.hpp"
+
+/*
+ * Winning point values, published to other processes on this host through POSIX shared memory
+ *
+ * The segment is a header followed by slotCount fixed size records, found by address:
+ * start at slotIndex() and probe linearly until the record for that address, or an unused one.
+ * Records are never moved or freed, a removed point keeps its record, flagged, so probing stays
+ * intact and the point gets the same record back if it returns.
+ *
+ * Every record has its own seqlock, its sequence is odd while it is being written.
+ * Readers copy the record, and retry if the sequence was odd or changed meanwhile:
+ *
+ *     do {
+ *         before = record.sequence.load(std::memory_order_acquire);
+ *         copy = record;
+ *         std::atomic_thread_fence(std::memory_order_acquire);
+ *         after = record.sequence.load(std::memory_order_relaxed);
+ *     } while ((before & 1) || before != after);
+ *
+ * There is a single writer, the consumer thread, and readers never write,
+ * so neither waits on the other. The layout only uses fixed width types,
+ * readers need nothing but the structures below.
+ *
+ * Values are as OTP sends them, position in micrometers (millimeters when positionScale is set),
+ * rotation in millionths of a degree, velocities per second, accelerations per second squared
+ * and scale in millionths. Timestamps are exactly as the source sent them.
+ * Only available where POSIX shared memory is, elsewhere isOpen() is always false
+ */
+class SharedPointTable final
+{
+public:
+    static constexpr char Magic[8] = {'O', 'T', 'P', 'V', 'I', 'E', 'W', '\0'};
+    static constexpr quint32 Version = 1;
+    static constexpr quint32 DefaultSlotCount = 16384;
+    static constexpr const char *DefaultName = "/otpview-points";
+    static constexpr std::size_t NameSize = 32;
+
+    enum flags_e : quint32
+    {
+        Used = 1 << 0,
+        Expired = 1 << 1,
+        Removed = 1 << 2
+    };
+
+    typedef struct value_s
+    {
+        qint64 value;
+        quint64 timestamp;
+        quint8 sourceCID[16];
+        quint8 priority;
+        quint8 reserved[7];
+    } value_t;
+
+    typedef struct axis_s
+    {
+        value_t position;
+        value_t positionVelocity;
+        value_t positionAcceleration;
+        value_t rotation;
+        value_t rotationVelocity;
+        value_t rotationAcceleration;
+        value_t scale;
+        quint8 positionScale; // Set for millimeters
+        quint8 reserved[7];
+    } axis_t;
+
+    typedef struct alignas(64) record_s
+    {
+        std::atomic<quint32> sequence;
+        quint32 flags;
+        quint32 system;
+        quint32 group;
+        quint32 point;
+        quint32 referenceSystem;
+        quint32 referenceGroup;
+        quint32 referencePoint;
+        qint64 lastSeen; // Milliseconds since the epoch
+        quint64 updates;
+        char name[NameSize]; // UTF-8, null padded, unterminated when full
+        axis_t axes[OTP::axis_t::count];
+    } record_t;
+
+    typedef struct alignas(64) header_s
+    {
+        char magic[sizeof(Magic)];
+        quint32 version;
+        quint32 headerSize;
+        quint32 recordSize;
+        quint32 slotCount; // Power of two
+        std::atomic<quint32> usedCount;
+        quint32 writerPid;
+        qint64 created; // Milliseconds since the epoch
+    } header_t;
+
+    static_assert(std::atomic<quint32>::is_always_lock_free, "Sequences must be lock free to be shared");
+    static_assert(sizeof(std::atomic<quint32>) == sizeof(quint32), "Sequences must be plain words");
+    static_assert(sizeof(value_t) == 40 && sizeof(axis_t) == 288, "Layout is shared with other processes");
+    static_assert(sizeof(record_t) == 960 && sizeof(header_t) == 64, "Layout is shared with other processes");
+
+    // Where probing for an address starts, slotCount must be a power of two
+    static quint32 slotIndex(quint32 system, quint32 group, quint32 point, quint32 slotCount)
+    {
+        // splitmix64 finaliser
+        quint64 key = (quint64(system) << 48) ^ (quint64(group) << 32) ^ point;
+        key = (key ^ (key >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        key = (key ^ (key >> 27)) * 0x94d049bb133111ebULL;
+        key ^= key >> 31;
+        return static_cast<quint32>(key) & (slotCount - 1);
+    }
+
+    // Creates the named segment, unless another running process is writing it.
+    // One left behind by a writer that has since exited is replaced
+    explicit SharedPointTable(const QString &name = DefaultName, quint32 slotCount = DefaultSlotCount);
+    ~SharedPointTable(); // Unlinks the segment if still ours, readers keep what they have mapped
+
+    bool isOpen() const { return header != nullptr; }
+    QString errorString() const { return error; }
+    QString name() const { return segmentName; }
+
+    // Writer thread only
+    void update(OTP::Consumer &consumer, OTP::address_t address);
+    void remove(OTP::address_t address);
+
+private:
+    record_t *find(OTP::address_t address, bool claim);
+
+    // Process writing the segment now under the name, 0 when there is none or it can't be read
+    static quint32 writerOf(const QByteArray &path);
+
+    QString segmentName;
+    QString error;
+    std::size_t size = 0;
+    header_t *header = nullptr;
+    record_t *records = nullptr;
+    bool fullReported = false;
+
+    SharedPointTable(const SharedPointTable&) = delete;
+    SharedPointTable& operator=(const SharedPointTable&) = delete;
+};
+
+#endif // SHAREDPOINTTABLE_H
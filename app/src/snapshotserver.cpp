@@ -0,0 +1,516 @@
+/*
+    OTPView
+    A QT Frontend for E1.59  (Entertainment  Technology  Object  Transform  Protocol  (OTP))
+    Copyright (C) 2026  Marcus Birkin
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "snapshotserver.h"
+#include <QCryptographicHash>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTimer>
+#include <QUrl>
+#include <QtEndian>
+#include <algorithm>
+#include <charconv>
+
+using namespace OTP;
+
+namespace {
+    // RFC 6455
+    const QByteArray WebSocketGuid = QByteArrayLiteral("258EAFA5-E914-47DA-95CA-C5AB0DC85B11");
+    const QByteArray WebSocketVersion = QByteArrayLiteral("13");
+
+    // Browsers always send an Origin, only pages served from this host may read the points,
+    // anything else could be any site open in a browser here. Other clients send none
+    bool isAllowedOrigin(const QByteArray &origin)
+    {
+        if (origin.isEmpty()) return true;
+        const QUrl url(QString::fromLatin1(origin));
+        if (url.scheme() != QLatin1String("http") && url.scheme() != QLatin1String("https")) return false;
+        const auto host = url.host();
+        return host == QLatin1String("localhost") || QHostAddress(host).isLoopback();
+    }
+    enum opcode_e : quint8
+    {
+        Continuation = 0x0,
+        Text = 0x1,
+        Binary = 0x2,
+        Close = 0x8,
+        Ping = 0x9,
+        Pong = 0xA
+    };
+    enum closeCode_e : quint16
+    {
+        ProtocolError = 1002,
+        TooBig = 1009
+    };
+
+    template <typename T>
+    void appendNumber(QByteArray &buffer, T value)
+    {
+        char text[24];
+        const auto result = std::to_chars(std::begin(text), std::end(text), value);
+        buffer.append(text, static_cast<int>(result.ptr - text));
+    }
+
+    // Anything outside printable ASCII is escaped, so nothing needs converting first
+    void appendString(QByteArray &buffer, const QString &value)
+    {
+        static const char hex[] = "0123456789abcdef";
+        buffer.append('"');
+        for (const auto &character : value)
+        {
+            const auto code = character.unicode();
+            if (code == '"' || code == '\\')
+            {
+                buffer.append('\\').append(static_cast<char>(code));
+            } else if (code >= 0x20 && code < 0x7f) {
+                buffer.append(static_cast<char>(code));
+            } else {
+                const char escaped[] = {'\\', 'u',
+                                        hex[(code >> 12) & 0xf], hex[(code >> 8) & 0xf],
+                                        hex[(code >> 4) & 0xf], hex[code & 0xf]};
+                buffer.append(escaped, sizeof(escaped));
+            }
+        }
+        buffer.append('"');
+    }
+
+    template <typename Value>
+    void appendAxes(QByteArray &buffer, const char *name, const ConsumerSnapshot::pointValues_t &values, Value value)
+    {
+        buffer.append(",\"").append(name).append("\":[");
+        for (auto axis = axis_t::first; axis < axis_t::count; ++axis)
+        {
+            if (axis != axis_t::first) buffer.append(',');
+            appendNumber(buffer, static_cast<qint64>(value(values.axes[axis])));
+        }
+        buffer.append(']');
+    }
+
+    void appendPoint(QByteArray &buffer, group_t group, point_t point, const ConsumerSnapshot::pointValues_t &values)
+    {
+        typedef ConsumerSnapshot::axisValues_t axisValues_t;
+        buffer.append("{\"group\":");
+        appendNumber(buffer, static_cast<quint32>(group));
+        buffer.append(",\"point\":");
+        appendNumber(buffer, static_cast<quint32>(point));
+        buffer.append(",\"name\":");
+        appendString(buffer, values.name);
+        buffer.append(values.expired ? ",\"expired\":true" : ",\"expired\":false");
+        buffer.append(",\"lastSeen\":");
+        appendNumber(buffer, values.lastSeen.isValid() ? values.lastSeen.toMSecsSinceEpoch() : 0);
+
+        appendAxes(buffer, "position", values, [](const axisValues_t &axis) {
+            const auto position = static_cast<qint64>(axis.position.value);
+            return axis.position.scale == MODULES::STANDARD::PositionModule_t::scale_e::mm ? position * 1000 : position;
+        });
+        appendAxes(buffer, "positionVelocity", values,
+                   [](const axisValues_t &axis) { return axis.positionVelocity.value; });
+        appendAxes(buffer, "positionAcceleration", values,
+                   [](const axisValues_t &axis) { return axis.positionAcceleration.value; });
+        appendAxes(buffer, "rotation", values,
+                   [](const axisValues_t &axis) { return axis.rotation.value; });
+        appendAxes(buffer, "rotationVelocity", values,
+                   [](const axisValues_t &axis) { return axis.rotationVelocity.value; });
+        appendAxes(buffer, "rotationAcceleration", values,
+                   [](const axisValues_t &axis) { return axis.rotationAcceleration.value; });
+        appendAxes(buffer, "scale", values,
+                   [](const axisValues_t &axis) { return axis.scale.value; });
+        buffer.append('}');
+    }
+}
+
+SnapshotServer::SnapshotServer(QObject *parent) : QObject(parent),
+    context(new QObject)
+{
+    thread.setObjectName(QStringLiteral("Snapshot Server"));
+    context->moveToThread(&thread);
+    thread.start();
+
+    QMetaObject::invokeMethod(context, [this]() {
+        server = new QTcpServer(context);
+        connect(server, &QTcpServer::newConnection, context, [this]() { newConnection(); });
+    }, Qt::BlockingQueuedConnection);
+}
+
+SnapshotServer::~SnapshotServer()
+{
+    QMetaObject::invokeMethod(context, [this]() {
+        clientMap.clear();
+        delete server; // Along with its sockets
+        server = nullptr;
+    }, Qt::BlockingQueuedConnection);
+
+    thread.quit();
+    thread.wait();
+    delete context;
+}
+
+bool SnapshotServer::listen(quint16 port, const QHostAddress &address)
+{
+    bool ret = true;
+    QMetaObject::invokeMethod(context, [&]() {
+        for (const auto &client : qAsConst(clientMap))
+            client->socket->abort();
+        server->close();
+        error.clear();
+        if (port)
+        {
+            ret = server->listen(address, port);
+            if (!ret) error = server->errorString();
+        }
+    }, Qt::BlockingQueuedConnection);
+    return ret;
+}
+
+QString SnapshotServer::errorString() const
+{
+    QString ret;
+    QMetaObject::invokeMethod(context, [&]() { ret = error; }, Qt::BlockingQueuedConnection);
+    return ret;
+}
+
+void SnapshotServer::publish(std::shared_ptr<const ConsumerSnapshot> snapshot)
+{
+    // Only kept, each client takes it when its own timer next fires
+    QMetaObject::invokeMethod(context, [this, snapshot]() { latest = snapshot; }, Qt::QueuedConnection);
+}
+
+void SnapshotServer::newConnection()
+{
+    while (server->hasPendingConnections())
+    {
+        auto client = std::make_shared<client_t>();
+        const auto socket = server->nextPendingConnection();
+        socket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+        client->socket = socket;
+        client->buffer.reserve(InitialBufferSize);
+        client->timer = new QTimer(socket);
+        connect(client->timer, &QTimer::timeout, context, [this, client = client.get()]() { send(*client); });
+        connect(socket, &QTcpSocket::readyRead, context, [this, client = client.get()]() {
+            if (client->upgraded)
+                readFrames(*client);
+            else
+                readRequest(*client);
+        });
+        // Queued, the client may still be in use when its socket closes
+        connect(socket, &QTcpSocket::disconnected, context,
+                [this, socket]() { disconnected(socket); }, Qt::QueuedConnection);
+        clientMap.insert(socket, client);
+    }
+    clientsChanged();
+}
+
+void SnapshotServer::disconnected(QTcpSocket *socket)
+{
+    const auto client = clientMap.take(socket);
+    if (!client) return;
+    client->timer->stop();
+    client->timer->disconnect(context);
+    socket->disconnect(context);
+    socket->deleteLater();
+    clientsChanged();
+}
+
+void SnapshotServer::readRequest(client_t &client)
+{
+    client.received += client.socket->readAll();
+    const auto end = client.received.indexOf("\r\n\r\n");
+    if (end < 0)
+    {
+        if (client.received.size() > MaxRequestSize) client.socket->abort();
+        return;
+    }
+
+    const auto lines = client.received.left(end).split('\n');
+    QHash<QByteArray, QByteArray> headers;
+    for (const auto &line : lines.mid(1))
+    {
+        const auto colon = line.indexOf(':');
+        if (colon > 0) headers.insert(line.left(colon).trimmed().toLower(), line.mid(colon + 1).trimmed());
+    }
+    const auto key = headers.value("sec-websocket-key");
+    if (!lines.first().startsWith("GET ")
+            || !headers.value("upgrade").toLower().contains("websocket")
+            || key.isEmpty())
+    {
+        client.socket->write("HTTP/1.1 426 Upgrade Required\r\n"
+                             "Upgrade: websocket\r\n"
+                             "Connection: close\r\n"
+                             "Content-Length: 0\r\n\r\n");
+        client.socket->disconnectFromHost();
+        return;
+    }
+    if (headers.value("sec-websocket-version") != WebSocketVersion)
+    {
+        client.socket->write("HTTP/1.1 426 Upgrade Required\r\n"
+                             "Sec-WebSocket-Version: " + WebSocketVersion + "\r\n"
+                             "Connection: close\r\n"
+                             "Content-Length: 0\r\n\r\n");
+        client.socket->disconnectFromHost();
+        return;
+    }
+    if (!isAllowedOrigin(headers.value("origin")))
+    {
+        client.socket->write("HTTP/1.1 403 Forbidden\r\n"
+                             "Connection: close\r\n"
+                             "Content-Length: 0\r\n\r\n");
+        client.socket->disconnectFromHost();
+        return;
+    }
+
+    const auto accept = QCryptographicHash::hash(key + WebSocketGuid, QCryptographicHash::Sha1).toBase64();
+    client.socket->write("HTTP/1.1 101 Switching Protocols\r\n"
+                         "Upgrade: websocket\r\n"
+                         "Connection: Upgrade\r\n"
+                         "Sec-WebSocket-Accept: " + accept + "\r\n\r\n");
+    client.upgraded = true;
+    client.received.remove(0, end + 4);
+    readFrames(client);
+}
+
+void SnapshotServer::readFrames(client_t &client)
+{
+    client.received += client.socket->readAll();
+    while (client.received.size() >= 2)
+    {
+        const auto data = reinterpret_cast<const uchar*>(client.received.constData());
+        const bool finalFrame = data[0] & 0x80;
+        const quint8 opcode = data[0] & 0x0f;
+        const bool masked = data[1] & 0x80;
+        quint64 length = data[1] & 0x7f;
+        int offset = 2;
+        if (length == 126)
+        {
+            if (client.received.size() < 4) return;
+            length = qFromBigEndian<quint16>(data + 2);
+            offset = 4;
+        } else if (length == 127) {
+            if (client.received.size() < 10) return;
+            length = qFromBigEndian<quint64>(data + 2);
+            offset = 10;
+        }
+
+        // Clients must mask what they send
+        if (!masked) return close(client, ProtocolError);
+        if (length > static_cast<quint64>(MaxRequestSize)) return close(client, TooBig);
+        if (client.received.size() < offset + 4 + static_cast<int>(length)) return;
+
+        const auto mask = data + offset;
+        offset += 4;
+        auto payload = client.received.mid(offset, static_cast<int>(length));
+        for (int index = 0; index < payload.size(); ++index)
+            payload[index] = static_cast<char>(payload.at(index) ^ mask[index % 4]);
+        client.received.remove(0, offset + static_cast<int>(length));
+
+        switch (opcode)
+        {
+            case Continuation:
+            case Text:
+                if (opcode == Text) client.message.clear();
+                client.message += payload;
+                if (client.message.size() > MaxRequestSize) return close(client, TooBig);
+                if (finalFrame)
+                {
+                    command(client, client.message);
+                    client.message.clear();
+                }
+                break;
+
+            case Binary: break;
+
+            case Close:
+                writeFrame(client, Close, payload.left(2));
+                client.socket->disconnectFromHost();
+                return;
+
+            case Ping:
+                writeFrame(client, Pong, payload);
+                break;
+
+            case Pong: break;
+
+            default: return close(client, ProtocolError);
+        }
+    }
+}
+
+void SnapshotServer::command(client_t &client, const QByteArray &message)
+{
+    QJsonParseError parseError;
+    const auto request = QJsonDocument::fromJson(message, &parseError).object();
+    if (parseError.error != QJsonParseError::NoError)
+        return writeError(client, parseError.errorString());
+
+    const auto system = request.value("system").toInt();
+    if (system < static_cast<int>(RANGES::System.getMin()) || system > static_cast<int>(RANGES::System.getMax()))
+        return writeError(client, tr("Invalid system %1").arg(system));
+    const auto rate = std::clamp(request.value("rate").toInt(DefaultRate), 1, MaxRate);
+
+    // Starts over with a snapshot
+    client.system = system;
+    client.sent.reset();
+    client.timer->start(1000 / rate);
+    send(client);
+}
+
+void SnapshotServer::send(client_t &client)
+{
+    if (!client.system || !latest || client.sent == latest) return;
+    if (client.socket->state() != QAbstractSocket::ConnectedState) return;
+
+    // Still draining the last message, everything since goes in the next delta instead
+    if (client.socket->bytesToWrite() > MaxBacklog) return;
+
+    client.buffer.resize(0); // Keeps the reserved capacity
+    if (client.sent)
+    {
+        if (!writeDelta(client, *latest))
+        {
+            client.sent = latest;
+            return;
+        }
+    } else {
+        writeSnapshot(client, *latest);
+    }
+    writeFrame(client, Text, client.buffer);
+    client.sent = latest;
+}
+
+void SnapshotServer::writeSnapshot(client_t &client, const ConsumerSnapshot &snapshot)
+{
+    auto &buffer = client.buffer;
+    buffer.append("{\"type\":\"snapshot\",\"system\":");
+    appendNumber(buffer, client.system);
+    buffer.append(",\"frame\":");
+    appendNumber(buffer, snapshot.frame);
+    buffer.append(",\"points\":[");
+
+    bool first = true;
+    const auto system = snapshot.systems.constFind(system_t(client.system));
+    if (system != snapshot.systems.constEnd())
+        for (auto group = system->cbegin(); group != system->cend(); ++group)
+            for (auto point = group->points.cbegin(); point != group->points.cend(); ++point)
+            {
+                if (!first) buffer.append(',');
+                first = false;
+                appendPoint(buffer, group.key(), point.key(), *point.value());
+            }
+    buffer.append("]}");
+}
+
+bool SnapshotServer::writeDelta(client_t &client, const ConsumerSnapshot &snapshot)
+{
+    static const ConsumerSnapshot::systemValues_t empty;
+    const auto systemValues = [&](const ConsumerSnapshot &from) -> const ConsumerSnapshot::systemValues_t & {
+        const auto system = from.systems.constFind(system_t(client.system));
+        return system == from.systems.constEnd() ? empty : system.value();
+    };
+    const auto &current = systemValues(snapshot);
+    const auto &previous = systemValues(*client.sent);
+
+    auto &buffer = client.buffer;
+    buffer.append("{\"type\":\"delta\",\"system\":");
+    appendNumber(buffer, client.system);
+    buffer.append(",\"frame\":");
+    appendNumber(buffer, snapshot.frame);
+    buffer.append(",\"points\":[");
+
+    // Unchanged points are shared between snapshots, so comparing pointers is enough
+    bool first = true;
+    for (auto group = current.cbegin(); group != current.cend(); ++group)
+    {
+        const auto previousGroup = previous.constFind(group.key());
+        for (auto point = group->points.cbegin(); point != group->points.cend(); ++point)
+        {
+            if (previousGroup != previous.constEnd() && previousGroup->points.value(point.key()) == point.value())
+                continue;
+            if (!first) buffer.append(',');
+            first = false;
+            appendPoint(buffer, group.key(), point.key(), *point.value());
+        }
+    }
+    bool changed = !first;
+
+    buffer.append("],\"removed\":[");
+    first = true;
+    for (auto group = previous.cbegin(); group != previous.cend(); ++group)
+    {
+        const auto currentGroup = current.constFind(group.key());
+        for (auto point = group->points.cbegin(); point != group->points.cend(); ++point)
+        {
+            if (currentGroup != current.constEnd() && currentGroup->points.contains(point.key()))
+                continue;
+            buffer.append(first ? "[" : ",[");
+            first = false;
+            appendNumber(buffer, static_cast<quint32>(group.key()));
+            buffer.append(',');
+            appendNumber(buffer, static_cast<quint32>(point.key()));
+            buffer.append(']');
+        }
+    }
+    buffer.append("]}");
+
+    return changed || !first;
+}
+
+void SnapshotServer::writeError(client_t &client, const QString &message)
+{
+    client.buffer.resize(0);
+    client.buffer.append("{\"type\":\"error\",\"message\":");
+    appendString(client.buffer, message);
+    client.buffer.append('}');
+    writeFrame(client, Text, client.buffer);
+}
+
+void SnapshotServer::writeFrame(client_t &client, quint8 opcode, const QByteArray &payload)
+{
+    // Unfragmented and, from a server, unmasked
+    uchar header[10];
+    int headerSize = 2;
+    header[0] = 0x80 | opcode;
+    if (payload.size() < 126)
+    {
+        header[1] = static_cast<uchar>(payload.size());
+    } else if (payload.size() <= 0xffff) {
+        header[1] = 126;
+        qToBigEndian<quint16>(static_cast<quint16>(payload.size()), header + 2);
+        headerSize = 4;
+    } else {
+        header[1] = 127;
+        qToBigEndian<quint64>(static_cast<quint64>(payload.size()), header + 2);
+        headerSize = 10;
+    }
+    client.socket->write(reinterpret_cast<const char*>(header), headerSize);
+    client.socket->write(payload);
+}
+
+void SnapshotServer::close(client_t &client, quint16 code)
+{
+    uchar payload[2];
+    qToBigEndian<quint16>(code, payload);
+    writeFrame(client, Close, QByteArray(reinterpret_cast<const char*>(payload), sizeof(payload)));
+    client.socket->disconnectFromHost();
+}
+
+void SnapshotServer::clientsChanged()
+{
+    const auto count = clientMap.size();
+    QMetaObject::invokeMethod(this, [this, count]() { emit clientCountChanged(count); }, Qt::QueuedConnection);
+}
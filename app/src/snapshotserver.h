@@ -0,0 +1,117 @@
+/*
+    OTPView
+    A QT Frontend for E1.59  (Entertainment  Technology  Object  Transform  Protocol  (OTP))
+    Copyright (C) 2026  Marcus Birkin
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#ifndef SNAPSHOTSERVER_H
+#define SNAPSHOTSERVER_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QHostAddress>
+#include <QObject>
+#include <QThread>
+#include <memory>
+#include "consumersnapshot.h"
+
+class QTcpServer;
+class QTcpSocket;
+class QTimer;
+
+/*
+ * Local WebSocket server, streaming published consumer snapshots as JSON
+ *
+ * Clients connect to ws://127.0.0.1:<port>/ with WebSocket version 13, browsers only from pages
+ * served from this host (their Origin must be http(s) on localhost or a loopback address),
+ * and subscribe to a system,
+ *     {"system": 1, "rate": 30}
+ * rate being messages per second, up to MaxRate. The server replies with every point of that system,
+ *     {"type": "snapshot", "system": 1, "frame": 1234, "points": [...]}
+ * then, no more often than the requested rate, only the points changed since the last message sent,
+ *     {"type": "delta", "system": 1, "frame": 1240, "points": [...], "removed": [[group, point], ...]}
+ * Subscribing again starts over with a snapshot. Each point is
+ *     {"group": 1, "point": 1, "name": "", "expired": false, "lastSeen": 1700000000000,
+ *      "position": [x, y, z], "positionVelocity": [...], "positionAcceleration": [...],
+ *      "rotation": [...], "rotationVelocity": [...], "rotationAcceleration": [...], "scale": [...]}
+ * positions in micrometers, everything else as OTP sends it, lastSeen in milliseconds since the epoch.
+ *
+ * The server has its own thread and only reads published snapshots, so clients never hold up
+ * the consumer, or the GUI. Changes are found by comparing each point's shared pointer with the one
+ * last sent to that client. A client whose socket hasn't drained skips its turn, and gets
+ * everything it missed in its next delta. Messages are written straight into a buffer kept
+ * by each client, rather than built through QJsonDocument
+ */
+class SnapshotServer : public QObject
+{
+    Q_OBJECT
+public:
+    static constexpr int DefaultRate = 30;
+    static constexpr int MaxRate = 250;
+    static constexpr qint64 MaxBacklog = 1 << 20; // Bytes unsent before a client skips its turn
+    static constexpr int MaxRequestSize = 16 << 10;
+    static constexpr int InitialBufferSize = 64 << 10;
+
+    explicit SnapshotServer(QObject *parent = nullptr);
+    ~SnapshotServer();
+
+    // Port 0 stops listening, and disconnects every client
+    bool listen(quint16 port, const QHostAddress &address = QHostAddress::LocalHost);
+    QString errorString() const;
+
+    // The latest snapshot, from the GUI thread
+    void publish(std::shared_ptr<const ConsumerSnapshot> snapshot);
+
+signals:
+    void clientCountChanged(int count);
+
+private:
+    typedef struct client_s
+    {
+        QTcpSocket *socket = nullptr;
+        QTimer *timer = nullptr;
+        bool upgraded = false;
+        QByteArray received; // Request, then partial frames
+        QByteArray message; // Fragmented message so far
+        int system = 0; // Not yet subscribed
+        std::shared_ptr<const ConsumerSnapshot> sent;
+        QByteArray buffer;
+    } client_t;
+
+    // Worker thread
+    void newConnection();
+    void disconnected(QTcpSocket *socket);
+    void readRequest(client_t &client);
+    void readFrames(client_t &client);
+    void command(client_t &client, const QByteArray &message);
+    void send(client_t &client);
+    void writeSnapshot(client_t &client, const ConsumerSnapshot &snapshot);
+    bool writeDelta(client_t &client, const ConsumerSnapshot &snapshot);
+    void writeError(client_t &client, const QString &message);
+    void writeFrame(client_t &client, quint8 opcode, const QByteArray &payload);
+    void close(client_t &client, quint16 code);
+    void clientsChanged();
+
+    QThread thread;
+    QObject *context; // Lives on the worker thread
+    QTcpServer *server = nullptr;
+    QString error;
+
+    // Worker thread only
+    std::shared_ptr<const ConsumerSnapshot> latest;
+    QHash<QTcpSocket*, std::shared_ptr<client_t>> clientMap;
+};
+
+#endif // SNAPSHOTSERVER_H
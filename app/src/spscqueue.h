@@ -0,0 +1,70 @@
+/*
+    OTPView
+    A QT Frontend for E1.59  (Entertainment  Technology  Object  Transform  Protocol  (OTP))
+    Copyright (C) 2026  Marcus Birkin
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#ifndef SPSCQUEUE_H
+#define SPSCQUEUE_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+/*
+ * Lock free, bounded FIFO from one writer thread to one reader thread
+ *
+ * A ring of Capacity slots, the writer only moves the tail and the reader only moves the head,
+ * so neither side ever waits on the other. Once full, push() fails rather than overwriting
+ */
+template <typename T, std::size_t Capacity>
+class SpscQueue
+{
+    static_assert(Capacity && !(Capacity & (Capacity - 1)), "Capacity must be a power of two");
+
+public:
+    // Writer thread only, false if full
+    bool push(T value)
+    {
+        const auto tail = this->tail.load(std::memory_order_relaxed);
+        if (tail - head.load(std::memory_order_acquire) == Capacity)
+            return false;
+        slots[tail & indexMask] = std::move(value);
+        this->tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Reader thread only, false if empty
+    bool pop(T &value)
+    {
+        const auto head = this->head.load(std::memory_order_relaxed);
+        if (head == tail.load(std::memory_order_acquire))
+            return false;
+        value = std::move(slots[head & indexMask]);
+        slots[head & indexMask] = T(); // Anything held is released by the reader
+        this->head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    static constexpr std::size_t indexMask = Capacity - 1;
+
+    std::array<T, Capacity> slots{};
+    alignas(64) std::atomic<std::size_t> head{0}; // Reader
+    alignas(64) std::atomic<std::size_t> tail{0}; // Writer
+};
+
+#endif // SPSCQUEUE_H
@@ -0,0 +1,117 @@
+/*
+    OTPView
+    A QT Frontend for E1.59  (Entertainment  Technology  Object  Transform  Protocol  (OTP))
+    Copyright (C) 2026  Marcus Birkin
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "systemrequestscheduler.h"
+#include <QRandomGenerator>
+#include <algorithm>
+
+using namespace OTP;
+using namespace std::chrono_literals;
+
+namespace {
+    constexpr qint64 RateWindow = 60000; // Milliseconds
+}
+
+SystemRequestScheduler::SystemRequestScheduler(
+        std::shared_ptr<ConsumerThread> otpConsumer,
+        std::chrono::seconds nominalInterval,
+        QObject *parent) : QObject(parent),
+    otpConsumer(otpConsumer),
+    nominalInterval(nominalInterval),
+    interval(nominalInterval)
+{
+    uptime.start();
+
+    timer.setSingleShot(true);
+    connect(&timer, &QTimer::timeout, this, &SystemRequestScheduler::request);
+
+    // Churn is reported on the consumer's thread, and counted on ours
+    const auto onChurn = [this]() {
+        QMetaObject::invokeMethod(this, &SystemRequestScheduler::churn, Qt::QueuedConnection);
+    };
+    const auto consumer = otpConsumer->consumer();
+    connect(consumer.get(), &Consumer::newComponent, this, onChurn, Qt::DirectConnection);
+    connect(consumer.get(), &Consumer::removedComponent, this, onChurn, Qt::DirectConnection);
+    connect(consumer.get(), &Consumer::newSystem, this, onChurn, Qt::DirectConnection);
+    connect(consumer.get(), &Consumer::removedSystem, this, onChurn, Qt::DirectConnection);
+}
+
+void SystemRequestScheduler::setNominalInterval(std::chrono::seconds value)
+{
+    nominalInterval = value;
+    interval = std::clamp(interval, minimumInterval(), maximumInterval());
+    schedule(interval);
+    emit statisticsChanged();
+}
+
+double SystemRequestScheduler::getRequestsPerMinute() const
+{
+    // Requests over the last minute, so the rate follows the current interval
+    const auto since = uptime.elapsed() - RateWindow;
+    return static_cast<double>(std::count_if(requestTimes.cbegin(), requestTimes.cend(),
+                                             [since](qint64 time) { return time > since; }));
+}
+
+void SystemRequestScheduler::request()
+{
+    otpConsumer->updateOTPMap();
+    ++requestCount;
+
+    const auto now = uptime.elapsed();
+    requestTimes.push_back(now);
+    while (requestTimes.front() <= now - RateWindow)
+        requestTimes.pop_front();
+
+    // Back off while nothing changes
+    if (!churnSinceRequest)
+        interval = std::min(maximumInterval(), std::chrono::milliseconds(interval * 3 / 2));
+    churnSinceRequest = false;
+
+    schedule(interval);
+    emit statisticsChanged();
+}
+
+void SystemRequestScheduler::churn()
+{
+    ++churnCount;
+    churnSinceRequest = true;
+    if (interval != minimumInterval())
+    {
+        interval = minimumInterval();
+        // Only ever bring the next request forward
+        if (!timer.isActive() || std::chrono::milliseconds(timer.remainingTime()) > interval)
+            schedule(interval);
+    }
+    emit statisticsChanged();
+}
+
+void SystemRequestScheduler::schedule(std::chrono::milliseconds delay)
+{
+    const auto jitter = QRandomGenerator::global()->bounded(0.2) - 0.1;
+    timer.start(std::max(1ms, std::chrono::milliseconds(qRound64(delay.count() * (1.0 + jitter)))));
+}
+
+std::chrono::milliseconds SystemRequestScheduler::minimumInterval() const
+{
+    return std::max<std::chrono::milliseconds>(1s, nominalInterval / 4);
+}
+
+std::chrono::milliseconds SystemRequestScheduler::maximumInterval() const
+{
+    return std::max(minimumInterval(), nominalInterval * 4);
+}
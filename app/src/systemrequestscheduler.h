@@ -0,0 +1,79 @@
+/*
+    OTPView
+    A QT Frontend for E1.59  (Entertainment  Technology  Object  Transform  Protocol  (OTP))
+    Copyright (C) 2026  Marcus Birkin
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#ifndef SYSTEMREQUESTSCHEDULER_H
+#define SYSTEMREQUESTSCHEDULER_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QTimer>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include "OTPLib.hpp"
+#include "consumerthread.h"
+
+/*
+ * Schedules the consumer's system requests (UpdateOTPMap)
+ *
+ * While the components and their systems are stable the interval backs off
+ * towards four times the configured interval, any churn drops it to a quarter
+ * (no less than a second) and brings the next request forward.
+ * Every interval is jittered by ±10% so consumers don't synchronise their requests
+ */
+class SystemRequestScheduler : public QObject
+{
+    Q_OBJECT
+public:
+    explicit SystemRequestScheduler(
+            std::shared_ptr<ConsumerThread> otpConsumer,
+            std::chrono::seconds nominalInterval,
+            QObject *parent = nullptr);
+
+    void setNominalInterval(std::chrono::seconds value);
+    std::chrono::milliseconds getInterval() const { return interval; }
+
+    quint64 getRequestCount() const { return requestCount; }
+    quint64 getChurnCount() const { return churnCount; }
+    double getRequestsPerMinute() const;
+
+public slots:
+    void request();
+
+signals:
+    void statisticsChanged();
+
+private:
+    void churn();
+    void schedule(std::chrono::milliseconds delay);
+    std::chrono::milliseconds minimumInterval() const;
+    std::chrono::milliseconds maximumInterval() const;
+
+    std::shared_ptr<ConsumerThread> otpConsumer;
+    std::chrono::milliseconds nominalInterval;
+    std::chrono::milliseconds interval;
+    QTimer timer;
+    bool churnSinceRequest = false;
+
+    QElapsedTimer uptime;
+    std::deque<qint64> requestTimes; // Uptime of each request within the last minute
+    quint64 requestCount = 0;
+    quint64 churnCount = 0;
+};
+
+#endif // SYSTEMREQUESTSCHEDULER_H
@@ -18,15 +18,17 @@
 */
 #include "systemwindow.h"
 #include "ui_systemwindow.h"
+#include "motionfilterdialog.h"
 #include "models/systemmodel.h"
 #include "widgets/linechart.h"
 #include <QSettings>
 #include <QHeaderView>
+#include <QMenu>
 
 using namespace OTP;
 
 SystemWindow::SystemWindow(
-        std::shared_ptr<class OTP::Consumer> otpConsumer,
+        std::shared_ptr<ConsumerThread> otpConsumer,
         OTP::system_t system,
         QWidget *parent) :
     QWidget(parent),
@@ -67,6 +69,22 @@ SystemWindow::SystemWindow(
         }
     });
 
+    //-Motion filter of a group, from its context menu
+    tvOverview->setContextMenuPolicy(Qt::CustomContextMenu);
+    connect(tvOverview, &QTreeView::customContextMenuRequested, this, [this, tvOverview](const QPoint &pos) {
+        const auto index = tvOverview->indexAt(pos);
+        if (!index.isValid()) return;
+        const auto item = SystemItem::indexToItem(index);
+        if (item->getType() != SystemItem::SystemGroupItem) return;
+
+        QMenu menu(this);
+        menu.addAction(tr("Motion Filter..."), this, [this, group = item->getGroup()]() {
+            MotionFilterDialog dialog(this->system, group, this);
+            dialog.exec();
+        });
+        menu.exec(tvOverview->viewport()->mapToGlobal(pos));
+    });
+
     // Tabs
     ui->tabWidget->setTabsClosable(true);
     ui->tabWidget->setMovable(true);
@@ -88,14 +106,15 @@ SystemWindow::~SystemWindow()
 
 void SystemWindow::showEvent(QShowEvent *event) {
     QSettings settings(QApplication::organizationName(), QApplication::applicationName());
-    parentWidget()->restoreGeometry(settings.value(QString("SystemWindow_%1/geometry").arg(system)).toByteArray());
+    // The MDI sub window's, unless a window of its own
+    (isWindow() ? this : parentWidget())->restoreGeometry(settings.value(QString("SystemWindow_%1/geometry").arg(system)).toByteArray());
     QWidget::showEvent(event);
 }
 
 void SystemWindow::closeEvent(QCloseEvent *event)
 {
     QSettings settings(QApplication::organizationName(), QApplication::applicationName());
-    settings.setValue(QString("SystemWindow_%1/geometry").arg(system), parentWidget()->saveGeometry());
+    settings.setValue(QString("SystemWindow_%1/geometry").arg(system), (isWindow() ? this : parentWidget())->saveGeometry());
     QWidget::closeEvent(event);
 }
 
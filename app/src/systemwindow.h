@@ -22,6 +22,7 @@
 #include <QWidget>
 #include <QTreeWidgetItem>
 #include "OTPLib.hpp"
+#include "consumerthread.h"
 
 namespace Ui {
 class SystemWindow;
@@ -33,7 +34,7 @@ class SystemWindow : public QWidget
 
 public:
     explicit SystemWindow(
-            std::shared_ptr<class OTP::Consumer> otpConsumer,
+            std::shared_ptr<ConsumerThread> otpConsumer,
             OTP::system_t system,
             QWidget *parent = nullptr);
     ~SystemWindow();
@@ -48,7 +49,7 @@ private slots:
 private:
     Ui::SystemWindow *ui;
 
-    std::shared_ptr<class OTP::Consumer> otpConsumer;
+    std::shared_ptr<ConsumerThread> otpConsumer;
     OTP::system_t system;
 };
 
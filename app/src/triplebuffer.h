@@ -0,0 +1,65 @@
+/*
+    OTPView
+    A QT Frontend for E1.59  (Entertainment  Technology  Object  Transform  Protocol  (OTP))
+    Copyright (C) 2026  Marcus Birkin
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#ifndef TRIPLEBUFFER_H
+#define TRIPLEBUFFER_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <utility>
+
+/*
+ * Lock free hand over of the latest value from one writer thread to one reader thread
+ *
+ * The writer fills its back buffer and swaps it with the middle one,
+ * the reader swaps the middle buffer with its front one whenever the middle holds something newer.
+ * With only two buffers the writer would have to wait for the reader to let go of the front buffer,
+ * the third is what lets both sides swap without ever waiting on each other.
+ * Values the reader never got to are simply overwritten
+ */
+template <typename T>
+class TripleBuffer
+{
+public:
+    // Writer thread only
+    void write(T value)
+    {
+        buffers[back] = std::move(value);
+        back = middle.exchange(back | freshBit, std::memory_order_acq_rel) & indexMask;
+    }
+
+    // Reader thread only, the newest value written or the previous one if nothing new
+    const T &read()
+    {
+        if (middle.load(std::memory_order_relaxed) & freshBit)
+            front = middle.exchange(front, std::memory_order_acq_rel) & indexMask;
+        return buffers[front];
+    }
+
+private:
+    static constexpr std::uint8_t indexMask = 0x03;
+    static constexpr std::uint8_t freshBit = 0x04;
+
+    std::array<T, 3> buffers{};
+    std::uint8_t front = 0; // Reader
+    std::atomic<std::uint8_t> middle{1};
+    std::uint8_t back = 2; // Writer
+};
+
+#endif // TRIPLEBUFFER_H
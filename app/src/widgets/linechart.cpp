@@ -17,6 +17,7 @@
     along with this program.  If not, see <https://www.gnu.org/licenses/>.
 */
 #include "linechart.h"
+#include "profiler.h"
 #include "settings.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
@@ -30,7 +31,7 @@ using namespace MODULES::STANDARD::VALUES;
 
 #define displayRange 60 // Number of seconds to show
 
-LineChart::LineChart(std::shared_ptr<class OTP::Consumer> otpConsumer,
+LineChart::LineChart(std::shared_ptr<ConsumerThread> otpConsumer,
                      OTP::address_t address,
                      QWidget *parent) :
     chartView(new QChartView(new QChart(), parent)),
@@ -96,12 +97,7 @@ LineChart::LineChart(std::shared_ptr<class OTP::Consumer> otpConsumer,
     updateTimer->start(1000);
     addPoint();
 
-    connect(otpConsumer.get(), &OTP::Consumer::updatedPosition, this, &LineChart::updatedPosition);
-    connect(otpConsumer.get(), &OTP::Consumer::updatedPositionVelocity, this, &LineChart::updatedPositionVelocity);
-    connect(otpConsumer.get(), &OTP::Consumer::updatedPositionAcceleration, this, &LineChart::updatedPositionAcceleration);
-    connect(otpConsumer.get(), &OTP::Consumer::updatedRotation, this, &LineChart::updatedRotation);
-    connect(otpConsumer.get(), &OTP::Consumer::updatedRotationVelocity, this, &LineChart::updatedRotationVelocity);
-    connect(otpConsumer.get(), &OTP::Consumer::updatedRotationAcceleration, this, &LineChart::updatedRotationAcceleration);
+    connect(otpConsumer.get(), &ConsumerThread::snapshotPublished, this, &LineChart::snapshotPublished);
 }
 
 void LineChart::setupLineSeries(moduleValue_t type, QString label, QHBoxLayout& hl)
@@ -183,6 +179,7 @@ void LineChart::buttonToggled(int type, bool checked)
 
 void LineChart::redraw()
 {
+    const ProfileScope profile("LineChart::redraw");
     auto now = QDateTime::currentDateTime();
     if (!chartView->chart()->axes(Qt::Vertical).count()) return;
     auto axisY = static_cast<QValueAxis*>(chartView->chart()->axes(Qt::Vertical).front());
@@ -199,7 +196,7 @@ void LineChart::redraw()
     axisX->setRange(xMin, xMax);
 
     // Y Axis unit
-    axisY->setLabelFormat(QString("%g%1").arg(otpConsumer->getUnitString(type, true)));
+    axisY->setLabelFormat(QString("%g%1").arg(otpConsumer->snapshot()->getUnitString(type)));
     axisY->applyNiceNumbers();
 
     // Y Axis range and prune
@@ -238,115 +235,39 @@ void LineChart::redraw()
 
 void LineChart::addPoint()
 {
-    for (auto axis = axis_t::first; axis < axis_t::count; ++axis)
-    {
-        updatedPosition(cid_t(), address, axis);
-        updatedPositionVelocity(cid_t(), address, axis);
-        updatedPositionAcceleration(cid_t(), address, axis);
-        updatedRotation(cid_t(), address, axis);
-        updatedRotationVelocity(cid_t(), address, axis);
-        updatedRotationAcceleration(cid_t(), address, axis);
-    }
+    pointValues = otpConsumer->snapshot()->point(address);
+    if (pointValues)
+        appendValues(*pointValues);
 
     redraw();
 }
 
-void LineChart::updatedPosition(cid_t cid, address_t updatedAddress, axis_t updatedAxis)
-{
-    Q_UNUSED(cid)
-    if (updatedAddress != address) return;
-    auto series = lineSeries[updatedAxis][POSITION];
-    auto now = QDateTime::currentDateTime();
-    auto x = now.toMSecsSinceEpoch();
-
-    auto pos = this->otpConsumer->getPosition(
-                this->address,
-                updatedAxis);
-    qreal y = pos.value;
-    if (pos.scale == MODULES::STANDARD::PositionModule_t::scale_e::um) y = y / 1000; // to millimeters
-    if (pos.scale == MODULES::STANDARD::PositionModule_t::scale_e::mm) y = y / 1000; // to meters
-
-    series->append(x,y);
-}
-
-void LineChart::updatedPositionVelocity(cid_t cid, address_t updatedAddress, axis_t updatedAxis)
-{
-    Q_UNUSED(cid)
-    if (updatedAddress != address) return;
-    auto series = lineSeries[updatedAxis][POSITION_ACCELERATION];
-    auto now = QDateTime::currentDateTime();
-    auto x = now.toMSecsSinceEpoch();
-
-    auto pos = this->otpConsumer->getPositionAcceleration(
-                this->address,
-                updatedAxis);
-    qreal y = pos.value;
-    y = y / 1000; // to meters
-
-    series->append(x,y);
-}
-
-void LineChart::updatedPositionAcceleration(cid_t cid, address_t updatedAddress, axis_t updatedAxis)
-{
-    Q_UNUSED(cid)
-    if (updatedAddress != address) return;
-    auto series = lineSeries[updatedAxis][POSITION_VELOCITY];
-    auto now = QDateTime::currentDateTime();
-    auto x = now.toMSecsSinceEpoch();
-
-    auto pos = this->otpConsumer->getPositionVelocity(
-                this->address,
-                updatedAxis);
-    qreal y = pos.value;
-    y = y / 1000; // to meters
-
-    series->append(x,y);
-}
-
-void LineChart::updatedRotation(cid_t cid, address_t updatedAddress, axis_t updatedAxis)
-{
-    Q_UNUSED(cid)
-    if (updatedAddress != address) return;
-    auto series = lineSeries[updatedAxis][ROTATION];
-    auto now = QDateTime::currentDateTime();
-    auto x = now.toMSecsSinceEpoch();
-
-    auto pos = this->otpConsumer->getRotation(
-                this->address,
-                updatedAxis);
-    auto y = pos.value;
-
-    series->append(x,y);
-}
-
-void LineChart::updatedRotationVelocity(cid_t cid, address_t updatedAddress, axis_t updatedAxis)
+void LineChart::snapshotPublished()
 {
-    Q_UNUSED(cid)
-    if (updatedAddress != address) return;
-    auto series = lineSeries[updatedAxis][ROTATION_VELOCITY];
-    auto now = QDateTime::currentDateTime();
-    auto x = now.toMSecsSinceEpoch();
-
-    auto pos = this->otpConsumer->getRotationVelocity(
-                this->address,
-                updatedAxis);
-    auto y = pos.value;
-
-    series->append(x,y);
+    const ProfileScope profile("LineChart::snapshotPublished");
+    // Unchanged points share their values with the previous snapshot
+    const auto newValues = otpConsumer->snapshot()->point(address);
+    if (!newValues || newValues == pointValues) return;
+    pointValues = newValues;
+    appendValues(*pointValues);
 }
 
-void LineChart::updatedRotationAcceleration(cid_t cid, address_t updatedAddress, axis_t updatedAxis)
+void LineChart::appendValues(const ConsumerSnapshot::pointValues_t &point)
 {
-    Q_UNUSED(cid)
-    if (updatedAddress != address) return;
-    auto series = lineSeries[updatedAxis][ROTATION_ACCELERATION];
-    auto now = QDateTime::currentDateTime();
-    auto x = now.toMSecsSinceEpoch();
-
-    auto pos = this->otpConsumer->getRotationAcceleration(
-                this->address,
-                updatedAxis);
-    auto y = pos.value;
-
-    series->append(x,y);
+    const auto x = QDateTime::currentDateTime().toMSecsSinceEpoch();
+    for (auto axis = axis_t::first; axis < axis_t::count; ++axis)
+    {
+        const auto &values = point.axes[axis];
+
+        qreal position = values.position.value;
+        if (values.position.scale == MODULES::STANDARD::PositionModule_t::scale_e::um) position = position / 1000; // to millimeters
+        if (values.position.scale == MODULES::STANDARD::PositionModule_t::scale_e::mm) position = position / 1000; // to meters
+        lineSeries[axis][POSITION]->append(x, position);
+        lineSeries[axis][POSITION_VELOCITY]->append(x, static_cast<qreal>(values.positionVelocity.value) / 1000); // to meters
+        lineSeries[axis][POSITION_ACCELERATION]->append(x, static_cast<qreal>(values.positionAcceleration.value) / 1000); // to meters
+
+        lineSeries[axis][ROTATION]->append(x, values.rotation.value);
+        lineSeries[axis][ROTATION_VELOCITY]->append(x, values.rotationVelocity.value);
+        lineSeries[axis][ROTATION_ACCELERATION]->append(x, values.rotationAcceleration.value);
+    }
 }
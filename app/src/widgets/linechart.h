@@ -26,6 +26,7 @@
 #include <QtCharts/QChartView>
 #include <QtCharts/QLineSeries>
 #include "OTPLib.hpp"
+#include "consumerthread.h"
 
 #if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
 using namespace QtCharts;
@@ -36,7 +37,7 @@ class LineChart : public QWidget
     Q_OBJECT
 public:
     explicit LineChart(
-            std::shared_ptr<class OTP::Consumer> otpConsumer,
+            std::shared_ptr<ConsumerThread> otpConsumer,
             OTP::address_t address,
             QWidget *parent = nullptr);
 
@@ -50,15 +51,11 @@ private slots:
 
     void redraw();
     void addPoint();
-    void updatedPosition(OTP::cid_t, OTP::address_t, OTP::axis_t);
-    void updatedPositionVelocity(OTP::cid_t, OTP::address_t, OTP::axis_t);
-    void updatedPositionAcceleration(OTP::cid_t, OTP::address_t, OTP::axis_t);
-    void updatedRotation(OTP::cid_t, OTP::address_t, OTP::axis_t);
-    void updatedRotationVelocity(OTP::cid_t, OTP::address_t, OTP::axis_t);
-    void updatedRotationAcceleration(OTP::cid_t, OTP::address_t, OTP::axis_t);
+    void snapshotPublished();
 
 private:
     void setupLineSeries(OTP::MODULES::STANDARD::VALUES::moduleValue_t, QString, QHBoxLayout&);
+    void appendValues(const ConsumerSnapshot::pointValues_t &point);
 
     QChartView *chartView;
     QMap<OTP::MODULES::STANDARD::VALUES::moduleValue_t, QLineSeries*> lineSeries[OTP::axis_t::count];
@@ -66,8 +63,9 @@ private:
 
     QButtonGroup *buttonGroup;
 
-    std::shared_ptr<class OTP::Consumer> otpConsumer;
+    std::shared_ptr<ConsumerThread> otpConsumer;
     OTP::address_t address;
+    std::shared_ptr<const ConsumerSnapshot::pointValues_t> pointValues; // As last charted
 };
 
 #endif // LINECHART_H
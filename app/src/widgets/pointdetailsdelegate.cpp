@@ -0,0 +1,116 @@
+/*
+    OTPView
+    A QT Frontend for E1.59  (Entertainment  Technology  Object  Transform  Protocol  (OTP))
+    Copyright (C) 2026  Marcus Birkin
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "pointdetailsdelegate.h"
+#include "models/pointdetailsmodel.h"
+#include "widgets/spacialspinbox.h"
+#include "widgets/scalespinbox.h"
+#include <algorithm>
+#include <limits>
+
+using namespace OTP;
+
+PointDetailsDelegate::PointDetailsDelegate(
+        std::shared_ptr<ProducerThread> otpProducer,
+        QObject *parent) : QStyledItemDelegate(parent),
+    otpProducer(otpProducer)
+{}
+
+QWidget *PointDetailsDelegate::createEditor(QWidget *parent, const QStyleOptionViewItem &option,
+                                            const QModelIndex &index) const
+{
+    auto model = qobject_cast<const PointDetailsModel*>(index.model());
+    if (!model)
+        return QStyledItemDelegate::createEditor(parent, option, index);
+
+    const auto axis = model->getAxis(index);
+    const auto moduleValue = model->getModuleValue(index);
+    if (moduleValue == VALUES::SCALE)
+    {
+        auto editor = new ScaleSpinBox(otpProducer, axis, parent);
+        connect(editor, qOverload<ScaleSpinBox::value_t>(&ScaleSpinBox::valueChanged), this, [=]() {
+            emit const_cast<PointDetailsDelegate*>(this)->commitData(editor);
+
+            // Each offset is applied as it's committed, the next one starts from none
+            if (model->isRelative())
+            {
+                const QSignalBlocker blocker(editor);
+                editor->setValue(0);
+            }
+        });
+        return editor;
+    }
+
+    auto editor = new SpacialSpinBox(otpProducer, axis, moduleValue, parent);
+    connect(editor, &SpacialSpinBox::valueChanged, this, [=]() {
+        emit const_cast<PointDetailsDelegate*>(this)->commitData(editor);
+
+        // Each offset is applied as it's committed, the next one starts from none
+        if (model->isRelative())
+        {
+            const QSignalBlocker blocker(editor);
+            editor->setValue(0);
+        }
+    });
+    return editor;
+}
+
+void PointDetailsDelegate::setEditorData(QWidget *editor, const QModelIndex &index) const
+{
+    auto model = qobject_cast<const PointDetailsModel*>(index.model());
+    if (!model)
+        return QStyledItemDelegate::setEditorData(editor, index);
+
+    if (auto scaleEditor = qobject_cast<ScaleSpinBox*>(editor))
+    {
+        scaleEditor->setAddress(model->getAddress());
+        if (model->isRelative())
+        {
+            const QSignalBlocker blocker(scaleEditor);
+            scaleEditor->setValue(0);
+        }
+    }
+    else if (auto spacialEditor = qobject_cast<SpacialSpinBox*>(editor))
+    {
+        spacialEditor->setAddress(model->getAddress());
+        if (model->isRelative())
+        {
+            // Offsets may move in either direction, up to the full range of the module
+            const auto range = VALUES::RANGES::getRange(model->getModuleValue(index));
+            const auto span = std::min(
+                        static_cast<qint64>(range.getMax()) - static_cast<qint64>(range.getMin()),
+                        static_cast<qint64>(std::numeric_limits<SpacialSpinBox::value_t>::max()));
+            const QSignalBlocker blocker(spacialEditor);
+            spacialEditor->setRange(
+                        static_cast<SpacialSpinBox::value_t>(-span),
+                        static_cast<SpacialSpinBox::value_t>(span));
+            spacialEditor->setValue(0);
+        }
+    }
+}
+
+void PointDetailsDelegate::setModelData(QWidget *editor, QAbstractItemModel *model,
+                                        const QModelIndex &index) const
+{
+    if (auto scaleEditor = qobject_cast<ScaleSpinBox*>(editor))
+        model->setData(index, static_cast<qint64>(scaleEditor->value()), Qt::EditRole);
+    else if (auto spacialEditor = qobject_cast<SpacialSpinBox*>(editor))
+        model->setData(index, static_cast<qint64>(spacialEditor->value()), Qt::EditRole);
+    else
+        QStyledItemDelegate::setModelData(editor, model, index);
+}
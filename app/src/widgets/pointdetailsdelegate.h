@@ -0,0 +1,47 @@
+/*
+    OTPView
+    A QT Frontend for E1.59  (Entertainment  Technology  Object  Transform  Protocol  (OTP))
+    Copyright (C) 2026  Marcus Birkin
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#ifndef POINTDETAILSDELEGATE_H
+#define POINTDETAILSDELEGATE_H
+
+#include <QStyledItemDelegate>
+#include "OTPLib.hpp"
+#include "producerthread.h"
+
+/*
+ * Creates a SpacialSpinBox or ScaleSpinBox for the cell being edited in a PointDetailsModel view
+ */
+class PointDetailsDelegate : public QStyledItemDelegate
+{
+    Q_OBJECT
+public:
+    explicit PointDetailsDelegate(
+            std::shared_ptr<ProducerThread> otpProducer,
+            QObject *parent = nullptr);
+
+    QWidget *createEditor(QWidget *parent, const QStyleOptionViewItem &option,
+                          const QModelIndex &index) const override;
+    void setEditorData(QWidget *editor, const QModelIndex &index) const override;
+    void setModelData(QWidget *editor, QAbstractItemModel *model,
+                      const QModelIndex &index) const override;
+
+private:
+    std::shared_ptr<ProducerThread> otpProducer;
+};
+
+#endif // POINTDETAILSDELEGATE_H
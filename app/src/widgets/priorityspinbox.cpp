@@ -17,11 +17,12 @@
     along with this program.  If not, see <https://www.gnu.org/licenses/>.
 */
 #include "priorityspinbox.h"
+#include "producertransaction.h"
 
 using namespace OTP;
 
 PrioritySpinBox::PrioritySpinBox(
-        std::shared_ptr<class OTP::Producer> otpProducer,
+        std::shared_ptr<ProducerThread> otpProducer,
         QWidget* parent) : QAbstractSpinBox(parent),
     otpProducer(otpProducer)
 {
@@ -32,9 +33,9 @@ PrioritySpinBox::PrioritySpinBox(
     connect(this->lineEdit(), SIGNAL(editingFinished()), this, SLOT(processInput()));
     connect(this->lineEdit(), SIGNAL(returnPressed()), this, SLOT(processInput()));
 
-    connect(otpProducer.get(), &Producer::updatedLocalPointPriority, this, [=](address_t address) {
+    connect(otpProducer.get(), &ProducerThread::updatedLocalPointPriority, this, [=](address_t address) {
         if (this->address.isValid() && this->address == address) {
-            m_value = otpProducer.get()->getLocalPointPriority(address);
+            m_value = otpProducer->read()->getLocalPointPriority(address);
             lineEdit()->setText(textFromValue(m_value));
         }
     });
@@ -61,14 +62,17 @@ void PrioritySpinBox::setValue(value_t val)
         emit valueChanged(m_value);
         emit valueChanged(oldValue, m_value);
 
-        otpProducer->setLocalPointPriority(address, m_value);
+        ProducerTransaction transaction(otpProducer);
+        transaction.setPriority(address, m_value);
+        transaction.commit();
     }
 }
 
 void PrioritySpinBox::setAddress(OTP::address_t value)
 {
     address = value;
-    setValue(otpProducer->getLocalPointPriority(address));
+    m_value = otpProducer->read()->getLocalPointPriority(address);
+    lineEdit()->setText(textFromValue(m_value));
 }
 
 void PrioritySpinBox::stepBy(int steps)
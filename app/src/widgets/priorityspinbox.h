@@ -23,6 +23,7 @@
 #include <QLineEdit>
 #include <QList>
 #include "OTPLib.hpp"
+#include "producerthread.h"
 
 class PrioritySpinBox : public QAbstractSpinBox
 {
@@ -31,7 +32,7 @@ public:
     typedef OTP::priority_t value_t;
 
     explicit PrioritySpinBox(
-            std::shared_ptr<class OTP::Producer> otpProducer,
+            std::shared_ptr<ProducerThread> otpProducer,
             QWidget* parent = nullptr);
 
     value_t value() const { return m_value; }
@@ -89,7 +90,7 @@ private slots:
     void processInput();
 
 private:
-    std::shared_ptr<class OTP::Producer> otpProducer;
+    std::shared_ptr<ProducerThread> otpProducer;
     OTP::address_t address;
     OTP::MODULES::STANDARD::VALUES::moduleValue_t moduleValue;
 
@@ -21,7 +21,7 @@
 using namespace OTP;
 
 ScaleSpinBox::ScaleSpinBox(
-        std::shared_ptr<class OTP::Producer> otpProducer,
+        std::shared_ptr<ProducerThread> otpProducer,
         axis_t axis,
         QWidget* parent) : QAbstractSpinBox(parent),
     otpProducer(otpProducer),
@@ -29,17 +29,17 @@ ScaleSpinBox::ScaleSpinBox(
 {
     setRange(VALUES::RANGES::getRange(VALUES::SCALE));
 
-    setValue(m_value);
+    lineEdit()->setText(textFromValue(m_value));
 
     connect(this->lineEdit(), SIGNAL(editingFinished()), this, SLOT(processInput()));
     connect(this->lineEdit(), SIGNAL(returnPressed()), this, SLOT(processInput()));
 
-    connect(otpProducer.get(), &Producer::updatedScale, this, [=](address_t address, axis_t axis) {
+    connect(otpProducer.get(), &ProducerThread::updatedScale, this, [=](address_t address, axis_t axis) {
         if (this->address.isValid() &&
                 std::tie(this->address, this->axis)
                 ==  std::tie(address, axis))
         {
-            m_value = otpProducer.get()->getLocalScale(address, axis).value;
+            m_value = otpProducer->read()->getLocalScale(address, axis).value;
             lineEdit()->setText(textFromValue(m_value));
         }
     });
@@ -62,22 +62,17 @@ void ScaleSpinBox::setValue(value_t val)
 
     lineEdit()->setText(textFromValue(val));
 
-
-    if (!address.isValid()) return;
-    emit valueChanged(m_value);
-    if (m_value != val)
+    if (oldValue != m_value) {
+        emit valueChanged(m_value);
         emit valueChanged(oldValue, m_value);
-
-    auto scale = otpProducer->getLocalScale(address, axis);
-    scale.timestamp = static_cast<OTP::timestamp_t>(QDateTime::currentDateTime().toMSecsSinceEpoch());
-    scale.value = m_value;
-    otpProducer->setLocalScale(address, axis, scale);
+    }
 }
 
 void ScaleSpinBox::setAddress(OTP::address_t value)
 {
     address = value;
-    setValue(otpProducer->getLocalScale(address, axis).value);
+    m_value = otpProducer->read()->getLocalScale(address, axis).value;
+    lineEdit()->setText(textFromValue(m_value));
 }
 
 void ScaleSpinBox::stepBy(int steps)
@@ -23,6 +23,7 @@
 #include <QLineEdit>
 #include <QList>
 #include "OTPLib.hpp"
+#include "producerthread.h"
 
 using namespace OTP::MODULES::STANDARD;
 class ScaleSpinBox : public QAbstractSpinBox
@@ -32,7 +33,7 @@ public:
     typedef ScaleModule_t::scale_t value_t;
 
     explicit ScaleSpinBox(
-            std::shared_ptr<class OTP::Producer> otpProducer,
+            std::shared_ptr<ProducerThread> otpProducer,
             OTP::axis_t axis,
             QWidget* parent = nullptr);
 
@@ -91,7 +92,7 @@ private slots:
     void processInput();
 
 private:
-    std::shared_ptr<class OTP::Producer> otpProducer;
+    std::shared_ptr<ProducerThread> otpProducer;
     OTP::address_t address;
     OTP::axis_t axis;
 
@@ -23,7 +23,7 @@
 using namespace OTP::MODULES::STANDARD;
 
 SpacialSpinBox::SpacialSpinBox(
-        std::shared_ptr<class OTP::Producer> otpProducer,
+        std::shared_ptr<ProducerThread> otpProducer,
         OTP::axis_t axis,
         VALUES::moduleValue_t moduleValue,
         QWidget *parent) : QAbstractSpinBox(parent),
@@ -33,7 +33,7 @@ SpacialSpinBox::SpacialSpinBox(
 {
     setRange(VALUES::RANGES::getRange(moduleValue));
 
-    setValue(m_value);
+    lineEdit()->setText(textFromValue(m_value));
 
     connect(this->lineEdit(), SIGNAL(editingFinished()), this, SLOT(processInput()));
     connect(this->lineEdit(), SIGNAL(returnPressed()), this, SLOT(processInput()));
@@ -51,61 +51,12 @@ void SpacialSpinBox::processInput()
 
 void SpacialSpinBox::setValue(value_t val)
 {
+    const auto changed = (m_value != val);
     m_value = val;
     lineEdit()->setText(textFromValue(val));
 
-    if (!address.isValid()) return;
-    emit valueChanged(m_value);
-    switch (moduleValue) {
-        case VALUES::POSITION:
-        {
-            auto position = otpProducer->getLocalPosition(address, axis);
-            position.timestamp = static_cast<OTP::timestamp_t>(QDateTime::currentDateTime().toMSecsSinceEpoch());
-            position.value = m_value;
-            otpProducer->setLocalPosition(address, axis, position); break;
-        }
-        case VALUES::POSITION_VELOCITY:
-        {
-            auto positionVel = otpProducer->getLocalPositionVelocity(address, axis);
-            positionVel.timestamp = static_cast<OTP::timestamp_t>(QDateTime::currentDateTime().toMSecsSinceEpoch());
-            positionVel.value = m_value;
-            otpProducer->setLocalPositionVelocity(address, axis, positionVel); break;
-        }
-        case VALUES::POSITION_ACCELERATION:
-        {
-            auto positionAccel = otpProducer->getLocalPositionAcceleration(address, axis);
-            positionAccel.timestamp = static_cast<OTP::timestamp_t>(QDateTime::currentDateTime().toMSecsSinceEpoch());
-            positionAccel.value = m_value;
-            otpProducer->setLocalPositionAcceleration(address, axis, positionAccel); break;
-        }
-        case VALUES::ROTATION:
-        {
-            auto rotation = otpProducer->getLocalRotation(address, axis);
-            rotation.timestamp = static_cast<OTP::timestamp_t>(QDateTime::currentDateTime().toMSecsSinceEpoch());
-            rotation.value = m_value;
-            otpProducer->setLocalRotation(address, axis, rotation); break;
-        }
-        case VALUES::ROTATION_VELOCITY:
-        {
-            auto rotationVel = otpProducer->getLocalRotationVelocity(address, axis);
-            rotationVel.timestamp = static_cast<OTP::timestamp_t>(QDateTime::currentDateTime().toMSecsSinceEpoch());
-            rotationVel.value = m_value;
-            otpProducer->setLocalRotationVelocity(address, axis, rotationVel); break;
-        }
-        case VALUES::ROTATION_ACCELERATION:
-        {
-            auto rotationAccel = otpProducer->getLocalRotationAcceleration(address, axis);
-            rotationAccel.timestamp = static_cast<OTP::timestamp_t>(QDateTime::currentDateTime().toMSecsSinceEpoch());
-            rotationAccel.value = m_value;
-            otpProducer->setLocalRotationAcceleration(address, axis, rotationAccel); break;
-        }
-        case VALUES::SCALE:
-            Q_ASSERT(moduleValue != VALUES::SCALE); // Invalid module for this class
-            break;
-        case VALUES::REFERENCE_FRAME:
-           Q_ASSERT(moduleValue != VALUES::REFERENCE_FRAME); // Invalid module for this class
-            break;
-    }
+    if (changed)
+        emit valueChanged(m_value);
 }
 
 void SpacialSpinBox::setAddress(OTP::address_t value)
@@ -113,17 +64,17 @@ void SpacialSpinBox::setAddress(OTP::address_t value)
     address = value;
     switch (moduleValue) {
         case VALUES::POSITION:
-            setValue(otpProducer->getLocalPosition(address, axis).value); break;
+            m_value = otpProducer->read()->getLocalPosition(address, axis).value; break;
         case VALUES::POSITION_VELOCITY:
-            setValue(otpProducer->getLocalPositionVelocity(address, axis).value); break;
+            m_value = otpProducer->read()->getLocalPositionVelocity(address, axis).value; break;
         case VALUES::POSITION_ACCELERATION:
-            setValue(otpProducer->getLocalPositionAcceleration(address, axis).value); break;
+            m_value = otpProducer->read()->getLocalPositionAcceleration(address, axis).value; break;
         case VALUES::ROTATION:
-            setValue(otpProducer->getLocalRotation(address, axis).value); break;
+            m_value = otpProducer->read()->getLocalRotation(address, axis).value; break;
         case VALUES::ROTATION_VELOCITY:
-            setValue(otpProducer->getLocalRotationVelocity(address, axis).value); break;
+            m_value = otpProducer->read()->getLocalRotationVelocity(address, axis).value; break;
         case VALUES::ROTATION_ACCELERATION:
-            setValue(otpProducer->getLocalRotationAcceleration(address, axis).value); break;
+            m_value = otpProducer->read()->getLocalRotationAcceleration(address, axis).value; break;
         case VALUES::SCALE:
             Q_ASSERT(moduleValue != VALUES::SCALE); // Invalid module for this class
             break;
@@ -131,6 +82,7 @@ void SpacialSpinBox::setAddress(OTP::address_t value)
            Q_ASSERT(moduleValue != VALUES::REFERENCE_FRAME);// Invalid module for this class
             break;
     }
+    lineEdit()->setText(textFromValue(m_value));
 }
 
 void SpacialSpinBox::stepBy(int steps)
@@ -176,17 +128,18 @@ SpacialSpinBox::value_t SpacialSpinBox::valueFromText(const QString &text, bool
 
 QString SpacialSpinBox::textFromValue(value_t val) const
 {
+    const auto producer = otpProducer->read();
     switch (moduleValue) {
         case VALUES::POSITION:
             return QString("%1 %2").arg(
                         QString::number(val),
-                        otpProducer->getUnitString(
-                            otpProducer->getLocalPosition(address, axis).scale,
+                        producer->getUnitString(
+                            producer->getLocalPosition(address, axis).scale,
                             moduleValue));
         default:
             return QString("%1 %2").arg(
                         QString::number(val),
-                        otpProducer->getUnitString(
+                        producer->getUnitString(
                             moduleValue));
     }
 }
@@ -21,6 +21,7 @@
 
 #include <QAbstractSpinBox>
 #include "OTPLib.hpp"
+#include "producerthread.h"
 
 class SpacialSpinBox : public QAbstractSpinBox
 {
@@ -29,7 +30,7 @@ public:
     typedef qint32 value_t;
 
     explicit SpacialSpinBox(
-            std::shared_ptr<class OTP::Producer> otpProducer,
+            std::shared_ptr<ProducerThread> otpProducer,
             OTP::axis_t axis,
             OTP::MODULES::STANDARD::VALUES::moduleValue_t moduleValue,
             QWidget* parent = nullptr);
@@ -77,7 +78,7 @@ private slots:
     void processInput();
 
 private:
-    std::shared_ptr<class OTP::Producer> otpProducer;
+    std::shared_ptr<ProducerThread> otpProducer;
     OTP::address_t address;
     OTP::axis_t axis;
     OTP::MODULES::STANDARD::VALUES::moduleValue_t moduleValue;